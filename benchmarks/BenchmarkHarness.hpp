@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace poker {
+namespace bench {
+
+/**
+ * Global allocation counters. The benchmark executable replaces operator
+ * new/delete and bumps these, so every benchmark can report allocations/op.
+ */
+inline std::atomic<uint64_t> allocationCount{0};
+inline std::atomic<uint64_t> allocatedBytes{0};
+
+// Keep the compiler from optimizing a computed value away
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Result of one benchmark
+struct Result {
+    std::string name;
+    uint64_t iterations = 0;
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0;
+    double bytesPerOp = 0.0;
+};
+
+// Runner options
+struct Options {
+    std::string filter;                 // Only run benchmarks containing this substring
+    std::chrono::milliseconds minTime{200}; // Minimum measured time per benchmark
+    uint64_t maxIterations = 1ULL << 30;
+};
+
+/**
+ * Runner times a callable with an adaptive iteration count: the batch size
+ * doubles until a batch runs for at least Options::minTime, and that batch is
+ * reported. The callable receives the iteration index.
+ */
+class Runner {
+public:
+    explicit Runner(Options options) : options_(std::move(options)) {}
+
+    template <typename Fn>
+    void run(const std::string& name, Fn&& op) {
+        if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) {
+            return;
+        }
+
+        // Warm-up (fills caches, first-touch allocations)
+        op(uint64_t(0));
+
+        uint64_t batch = 1;
+        Result result;
+        result.name = name;
+
+        for (;;) {
+            uint64_t allocsBefore = allocationCount.load(std::memory_order_relaxed);
+            uint64_t bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+
+            for (uint64_t i = 0; i < batch; ++i) {
+                op(i);
+            }
+
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            uint64_t allocs = allocationCount.load(std::memory_order_relaxed) - allocsBefore;
+            uint64_t bytes = allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+
+            if (elapsed >= options_.minTime || batch >= options_.maxIterations) {
+                double ns = static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                result.iterations = batch;
+                result.nsPerOp = ns / static_cast<double>(batch);
+                result.allocsPerOp = static_cast<double>(allocs) / static_cast<double>(batch);
+                result.bytesPerOp = static_cast<double>(bytes) / static_cast<double>(batch);
+                break;
+            }
+            batch *= 2;
+        }
+
+        std::cout << std::left << std::setw(48) << result.name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(1)
+                  << result.nsPerOp << " ns/op"
+                  << std::setw(10) << std::setprecision(2) << result.allocsPerOp << " allocs/op"
+                  << std::setw(12) << std::setprecision(0) << result.bytesPerOp << " B/op"
+                  << std::setw(12) << result.iterations << " iters" << std::endl;
+
+        results_.push_back(result);
+    }
+
+    const std::vector<Result>& getResults() const { return results_; }
+
+    // Write results as JSON so runs from different builds can be diffed
+    bool writeJson(const std::string& filename, uint64_t seed, const std::string& buildInfo) const {
+        std::ofstream out(filename);
+        if (!out.is_open()) {
+            return false;
+        }
+
+        out << "{\n";
+        out << "  \"seed\": " << seed << ",\n";
+        out << "  \"build\": \"" << buildInfo << "\",\n";
+        out << "  \"min_time_ms\": " << options_.minTime.count() << ",\n";
+        out << "  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const Result& r = results_[i];
+            out << "    {\"name\": \"" << r.name << "\""
+                << ", \"iterations\": " << r.iterations
+                << std::fixed << std::setprecision(3)
+                << ", \"ns_per_op\": " << r.nsPerOp
+                << ", \"allocs_per_op\": " << r.allocsPerOp
+                << ", \"bytes_per_op\": " << r.bytesPerOp << "}"
+                << (i + 1 < results_.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n";
+        out << "}\n";
+
+        return out.good();
+    }
+
+private:
+    Options options_;
+    std::vector<Result> results_;
+};
+
+} // namespace bench
+} // namespace poker
@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "cfr/CFRSolver.hpp"
+#include "game/GameState.hpp"
+#include "abstraction/HandAbstraction.hpp"
+#include "abstraction/BetAbstraction.hpp"
+#include "utils/Logger.hpp"
+
+/**
+ * Convergence-vs-wallclock benchmark. Trains with a fixed seed for each
+ * traversal mode and, at fixed training-time checkpoints, records the sampled
+ * exploitability of the average strategy, info-set count, resident memory and
+ * nodes/sec as one CSV row. Evaluation time is excluded from the clock.
+ *
+ * Usage: convergence_bench [--modes vanilla,monte_carlo,public_tree] (default: all three)
+ *                          [--checkpoints 1,2,5,10,30] [--br-samples N] [--seed N]
+ *                          [--hand-abs LEVEL] [--bet-abs LEVEL] [--csv FILE]
+ *
+ * Resident memory is process-wide, so run one mode per process when comparing
+ * memory between modes.
+ */
+
+using namespace poker;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Resident set size from /proc/self/statm (0 if unavailable)
+double residentMemoryMB() {
+    std::ifstream statm("/proc/self/statm");
+    long totalPages = 0;
+    long residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+        return 0.0;
+    }
+    return static_cast<double>(residentPages) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::istringstream iss(list);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+bool parseMode(const std::string& name, CFRSolver::TraversalMode& mode) {
+    for (auto candidate : {CFRSolver::TraversalMode::VANILLA, CFRSolver::TraversalMode::MONTE_CARLO,
+                           CFRSolver::TraversalMode::PUBLIC_TREE}) {
+        if (name == CFRSolver::traversalModeToString(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Level>
+bool parseLevel(const std::string& name, Level& level) {
+    if (name == "none") level = Level::NONE;
+    else if (name == "minimal") level = Level::MINIMAL;
+    else if (name == "standard") level = Level::STANDARD;
+    else if (name == "detailed") level = Level::DETAILED;
+    else return false;
+    return true;
+}
+
+struct BenchConfig {
+    std::vector<CFRSolver::TraversalMode> modes;
+    std::vector<double> checkpointSeconds{1, 2, 5, 10, 30};
+    int brSamples = 64;
+    uint64_t seed = 12345;
+    HandAbstraction::Level handLevel = HandAbstraction::Level::MINIMAL;
+    BetAbstraction::Level betLevel = BetAbstraction::Level::MINIMAL;
+    std::string csvFile = "convergence.csv";
+};
+
+// Train one mode up to the last checkpoint, writing a CSV row per checkpoint
+void runMode(const BenchConfig& config, CFRSolver::TraversalMode mode, std::ostream& csv) {
+    auto handAbstraction = HandAbstraction::create(config.handLevel);
+    auto betAbstraction = BetAbstraction::create(config.betLevel);
+    CFRSolver solver(std::make_unique<GameState>(), handAbstraction, betAbstraction);
+    solver.setSeed(config.seed);
+
+    const std::string modeName = CFRSolver::traversalModeToString(mode);
+    std::cout << "== " << modeName << " ==" << std::endl;
+
+    double trainedSeconds = 0.0;
+    int chunk = 1;
+
+    for (double checkpoint : config.checkpointSeconds) {
+        // Train until the training clock reaches the checkpoint. Chunks grow so
+        // that each one takes roughly a tenth of a second.
+        while (trainedSeconds < checkpoint) {
+            auto start = Clock::now();
+            solver.train(chunk, mode);
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            trainedSeconds += elapsed;
+
+            if (elapsed < 0.05) {
+                chunk *= 2;
+            } else if (elapsed > 0.2 && chunk > 1) {
+                chunk /= 2;
+            }
+        }
+
+        auto evalStart = Clock::now();
+        double exploitability = solver.estimateExploitability(config.brSamples, config.seed);
+        double evalSeconds = std::chrono::duration<double>(Clock::now() - evalStart).count();
+
+        CFRSolver::TrainingStats stats = solver.getTrainingStats(false);
+        double nodesPerSecond = trainedSeconds > 0.0 ? stats.nodesVisited / trainedSeconds : 0.0;
+        double rssMB = residentMemoryMB();
+
+        csv << modeName << ","
+            << std::fixed << std::setprecision(3) << trainedSeconds << ","
+            << stats.iterations << ","
+            << stats.nodesVisited << ","
+            << std::setprecision(0) << nodesPerSecond << ","
+            << stats.infoSetCount << ","
+            << solver.getStrategyTable().size() << ","
+            << std::setprecision(1) << rssMB << ","
+            << stats.tableBytes / (1024.0 * 1024.0) << ","
+            << std::setprecision(6) << exploitability << ","
+            << std::setprecision(3) << evalSeconds << std::endl;
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8) << trainedSeconds << "s"
+                  << std::setw(10) << stats.iterations << " iters"
+                  << std::setw(12) << std::setprecision(0) << nodesPerSecond << " nodes/s"
+                  << std::setw(10) << stats.infoSetCount << " info sets"
+                  << std::setw(9) << std::setprecision(1) << rssMB << " MB"
+                  << "   exploitability " << std::setprecision(5) << exploitability << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    const std::string usage = std::string("Usage: ") + argv[0] +
+        " [--modes vanilla,monte_carlo,public_tree] [--checkpoints 1,2,5,10,30] [--br-samples N]"
+        " [--seed N] [--hand-abs LEVEL] [--bet-abs LEVEL] [--csv FILE]";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--modes" && hasValue) {
+            for (const auto& name : splitList(argv[++i])) {
+                CFRSolver::TraversalMode mode;
+                if (!parseMode(name, mode)) {
+                    std::cerr << "Unknown traversal mode: " << name << std::endl;
+                    return 1;
+                }
+                config.modes.push_back(mode);
+            }
+        } else if (arg == "--checkpoints" && hasValue) {
+            config.checkpointSeconds.clear();
+            for (const auto& value : splitList(argv[++i])) {
+                config.checkpointSeconds.push_back(std::stod(value));
+            }
+        } else if (arg == "--br-samples" && hasValue) {
+            config.brSamples = std::stoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            config.seed = std::stoull(argv[++i]);
+        } else if (arg == "--hand-abs" && hasValue) {
+            if (!parseLevel(argv[++i], config.handLevel)) {
+                std::cerr << usage << std::endl;
+                return 1;
+            }
+        } else if (arg == "--bet-abs" && hasValue) {
+            if (!parseLevel(argv[++i], config.betLevel)) {
+                std::cerr << usage << std::endl;
+                return 1;
+            }
+        } else if (arg == "--csv" && hasValue) {
+            config.csvFile = argv[++i];
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+
+    if (config.modes.empty()) {
+        config.modes = {CFRSolver::TraversalMode::VANILLA, CFRSolver::TraversalMode::MONTE_CARLO,
+                        CFRSolver::TraversalMode::PUBLIC_TREE};
+    }
+    std::sort(config.checkpointSeconds.begin(), config.checkpointSeconds.end());
+
+    // Training logs every few iterations; keep the clock on the solver
+    Logger::getInstance().init(Logger::Level::WARNING);
+
+    std::ofstream csv(config.csvFile);
+    if (!csv.is_open()) {
+        std::cerr << "Failed to open " << config.csvFile << std::endl;
+        return 1;
+    }
+    csv << "mode,train_seconds,iterations,nodes_visited,nodes_per_sec,regret_info_sets,"
+           "strategy_info_sets,rss_mb,table_mb,exploitability,eval_seconds" << std::endl;
+
+    for (auto mode : config.modes) {
+        runMode(config, mode, csv);
+    }
+
+    std::cout << "Convergence curve written to " << config.csvFile << std::endl;
+    return 0;
+}
\ No newline at end of file
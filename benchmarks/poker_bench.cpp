@@ -0,0 +1,280 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "BenchmarkHarness.hpp"
+#include "game/GameState.hpp"
+#include "game/Deck.hpp"
+#include "abstraction/HandAbstraction.hpp"
+#include "abstraction/BetAbstraction.hpp"
+#include "cfr/CFRSolver.hpp"
+#include "cfr/RegretTable.hpp"
+#include "cfr/StrategyTable.hpp"
+#include "runtime/MappedStrategy.hpp"
+#include "runtime/StrategyQueryEngine.hpp"
+#include "utils/Logger.hpp"
+#include "utils/Random.hpp"
+
+/**
+ * Microbenchmarks for the solver's hot primitives. Every run reseeds the RNG
+ * with the same seed, so the states and hands being measured are identical
+ * across builds and only the code under test changes.
+ *
+ * Usage: poker_bench [--filter SUBSTR] [--min-time-ms N] [--json FILE] [--seed N]
+ */
+
+// Count every heap allocation made by the process
+void* operator new(std::size_t size) {
+    poker::bench::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    poker::bench::allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+using namespace poker;
+
+namespace {
+
+std::string buildInfo() {
+    std::string info;
+#if defined(__clang__)
+    info += "clang " __clang_version__;
+#elif defined(__GNUC__)
+    info += "gcc " __VERSION__;
+#endif
+#ifdef NDEBUG
+    info += ", release";
+#else
+    info += ", debug";
+#endif
+#if defined(POKER_LOG_COMPILED_LEVEL) && POKER_LOG_COMPILED_LEVEL > 0
+    info += ", debug logs stripped";
+#endif
+    return info;
+}
+
+// Fresh hand with hole cards dealt, preflop, first player to act
+GameState makePreflopState() {
+    GameState state;
+    state.reset();
+    state.dealHoleCards();
+    return state;
+}
+
+// Same hand advanced to the river with every player still in
+GameState makeRiverState() {
+    GameState state = makePreflopState();
+    state.startNextBettingRound();
+    state.startNextBettingRound();
+    state.startNextBettingRound();
+    return state;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bench::Options options;
+    std::string jsonFile;
+    uint64_t seed = 12345;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time-ms" && i + 1 < argc) {
+            options.minTime = std::chrono::milliseconds(std::stoll(argv[++i]));
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonFile = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--filter SUBSTR] [--min-time-ms N] [--json FILE] [--seed N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Benchmarks measure the code, not the logger
+    Logger::getInstance().init(Logger::Level::WARNING);
+    Random::getInstance().seed(seed);
+
+    std::cout << "poker_bench (" << buildInfo() << ", seed " << seed << ")" << std::endl;
+
+    bench::Runner runner(options);
+
+    auto handAbstraction = HandAbstraction::create(HandAbstraction::Level::STANDARD);
+    auto betAbstraction = BetAbstraction::create(BetAbstraction::Level::STANDARD);
+
+    const GameState preflop = makePreflopState();
+    const GameState river = makeRiverState();
+
+    // GameState
+    runner.run("GameState::clone", [&](uint64_t) {
+        auto copy = preflop.clone();
+        bench::doNotOptimize(copy);
+    });
+
+    {
+        const std::vector<Action> actions = preflop.getValidActions();
+        GameState scratch = preflop;
+        // Includes the copy-assignment that restores the state between ops
+        runner.run("GameState::applyAction (+copy-assign)", [&](uint64_t i) {
+            scratch = preflop;
+            scratch.applyAction(actions[i % actions.size()]);
+            bench::doNotOptimize(scratch);
+        });
+    }
+
+    runner.run("GameState::getValidActions", [&](uint64_t) {
+        auto actions = preflop.getValidActions();
+        bench::doNotOptimize(actions);
+    });
+
+    runner.run("GameState::getPayoffs (river showdown)", [&](uint64_t) {
+        auto payoffs = river.getPayoffs();
+        bench::doNotOptimize(payoffs);
+    });
+
+    // BetAbstraction
+    {
+        const std::vector<Action> validActions = preflop.getValidActions();
+        const PlayerState& player = preflop.getPlayerState(preflop.getCurrentPosition());
+        runner.run("BetAbstraction::getAbstractedActions", [&](uint64_t) {
+            auto actions = betAbstraction->getAbstractedActions(
+                validActions, preflop.getPot(), player.stack, preflop.getBettingRound());
+            bench::doNotOptimize(actions);
+        });
+    }
+
+    // HandAbstraction: warm repeats one cached hand, cold deals a new hand
+    // every op so the cache never hits (until the deal space repeats)
+    {
+        const GameState flop = [] {
+            GameState state = makePreflopState();
+            state.startNextBettingRound();
+            return state;
+        }();
+        const PlayerState& player = flop.getPlayerState(Position::SB);
+
+        runner.run("HandAbstraction::getBucket (warm, flop)", [&](uint64_t) {
+            int bucket = handAbstraction->getBucket(player.holeCards, flop.getCommunityCards());
+            bench::doNotOptimize(bucket);
+        });
+
+        Deck deck;
+        Xoshiro256 dealRng = Xoshiro256::forStream(seed, 0, 1);
+        runner.run("HandAbstraction::getBucket (cold, flop)", [&](uint64_t) {
+            deck.reset();
+            DealOutcome deal = deck.drawOutcome(dealRng);
+            int bucket = handAbstraction->getBucket(
+                Deck::toCardSet(deal.holeMask(Position::SB)), Deck::toCardSet(deal.boardMask(3)));
+            bench::doNotOptimize(bucket);
+        });
+    }
+
+    // RegretTable over a fixed working set of info sets
+    {
+        RegretTable regretTable;
+        const std::vector<Action> actions = preflop.getValidActions();
+        std::vector<std::string> infoSets;
+        for (int i = 0; i < 1024; ++i) {
+            infoSets.push_back("BTN|PREFLOP|" + std::to_string(i % 169) + "|r" + std::to_string(i));
+        }
+        std::vector<double> regrets(actions.size());
+
+        runner.run("RegretTable::addRegret", [&](uint64_t i) {
+            regretTable.addRegret(infoSets[i % infoSets.size()], actions[i % actions.size()], 1.0);
+        });
+
+        runner.run("RegretTable::getRegrets (array)", [&](uint64_t i) {
+            regretTable.getRegrets(infoSets[i % infoSets.size()], actions, regrets.data());
+            bench::doNotOptimize(regrets);
+        });
+
+        runner.run("RegretTable::getRegrets (map)", [&](uint64_t i) {
+            auto map = regretTable.getRegrets(infoSets[i % infoSets.size()]);
+            bench::doNotOptimize(map);
+        });
+    }
+
+    // CFRSolver info-set key construction
+    {
+        CFRSolver solver(std::make_unique<GameState>(preflop), handAbstraction, betAbstraction);
+        runner.run("CFRSolver::getAbstractedInfoSet", [&](uint64_t) {
+            std::string infoSet = solver.getAbstractedInfoSet(preflop, preflop.getCurrentPosition());
+            bench::doNotOptimize(infoSet);
+        });
+    }
+
+    // Play-time queries against a mapped strategy covering every dealt hand
+    {
+        const std::string strategyFile = "poker_bench_strategy.rts";
+        const std::vector<Action> actions = preflop.getValidActions();
+        const int numDecisions = 1024;
+
+        Deck deck;
+        Xoshiro256 dealRng = Xoshiro256::forStream(seed, 0, 2);
+        const std::string history = preflop.getActionHistory().toString();
+        std::vector<StrategyQueryEngine::Decision> decisions;
+        for (int i = 0; i < numDecisions; ++i) {
+            deck.reset();
+            DealOutcome deal = deck.drawOutcome(dealRng);
+            decisions.push_back({Position::BTN, deal.holeMask(Position::BTN), deal.boardMask(3 + i % 3),
+                                 &history, actions.data(), actions.size()});
+        }
+
+        // Export a strategy that contains every decision's info set
+        {
+            StrategyTable strategies;
+            for (const auto& decision : decisions) {
+                std::string key = StrategyQueryEngine::infoSetKey(*handAbstraction, decision);
+                for (size_t a = 0; a < actions.size(); ++a) {
+                    strategies.addToStrategySum(key, actions[a], 1.0 + a);
+                }
+            }
+            MappedStrategy::write(strategyFile, strategies, MappedStrategy::Encoding::Q8);
+        }
+
+        auto mapped = std::make_shared<MappedStrategy>();
+        if (mapped->open(strategyFile)) {
+            StrategyQueryEngine engine(mapped, handAbstraction);
+            std::vector<double> out(actions.size() * numDecisions);
+
+            runner.run("StrategyQueryEngine::query", [&](uint64_t i) {
+                bool found = engine.query(decisions[i % decisions.size()], out.data());
+                bench::doNotOptimize(found);
+            });
+
+            runner.run("StrategyQueryEngine::queryBatch (1024 decisions)", [&](uint64_t) {
+                size_t found = engine.queryBatch(decisions.data(), decisions.size(), out.data());
+                bench::doNotOptimize(found);
+            });
+        }
+        std::remove(strategyFile.c_str());
+    }
+
+    if (!jsonFile.empty()) {
+        if (!runner.writeJson(jsonFile, seed, buildInfo())) {
+            std::cerr << "Failed to write " << jsonFile << std::endl;
+            return 1;
+        }
+        std::cout << "Results written to " << jsonFile << std::endl;
+    }
+
+    return 0;
+}
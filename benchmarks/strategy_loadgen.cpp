@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "game/Deck.hpp"
+#include "runtime/StrategyProtocol.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/Xoshiro.hpp"
+
+/**
+ * Load generator for strategy_server. Each connection runs on its own thread
+ * and sends back-to-back batch requests of random deals; round-trip latency
+ * goes into a per-thread LatencyHistogram and the bins are merged at the end.
+ *
+ * Usage: strategy_loadgen [--socket PATH] [--connections N] [--requests N]
+ *                         [--batch N] [--seed N]
+ *
+ * Decisions are dealt uniformly over streets with an empty history, so the
+ * found rate shows how much of the random deal space the strategy covers.
+ */
+
+using namespace poker;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Bins = std::array<uint64_t, LatencyHistogram::NUM_BINS>;
+
+struct ConnectionResult {
+    Bins bins{};
+    uint64_t requests = 0;
+    uint64_t decisions = 0;
+    uint64_t found = 0;
+    bool failed = false;
+};
+
+int connectTo(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+void runConnection(const std::string& socketPath, int requests, int batch, uint64_t seed, int index,
+                   ConnectionResult& result) {
+    int fd = connectTo(socketPath);
+    if (fd < 0) {
+        result.failed = true;
+        return;
+    }
+
+    const std::string history;
+    const std::vector<Action> actions = {Action::fold(), Action::call(1.0), Action::raise(3.0)};
+    Xoshiro256 rng = Xoshiro256::forStream(seed, 0, static_cast<uint64_t>(index));
+    Deck deck;
+
+    std::vector<StrategyQueryEngine::Decision> decisions(static_cast<size_t>(batch));
+    std::vector<char> request;
+    std::vector<char> body;
+    StrategyProtocol::Response response;
+
+    for (int r = 0; r < requests; ++r) {
+        // Street 0-3 (board of 0, 3, 4 or 5 cards)
+        for (auto& decision : decisions) {
+            deck.reset();
+            DealOutcome deal = deck.drawOutcome(rng);
+            int street = static_cast<int>(rng() % 4);
+            Position position = static_cast<Position>(rng() % NUM_PLAYERS);
+            decision = {position, deal.holeMask(position), deal.boardMask(street == 0 ? 0 : street + 2),
+                        &history, actions.data(), actions.size()};
+        }
+        StrategyProtocol::encodeRequest(static_cast<uint32_t>(r), decisions.data(), decisions.size(), request);
+
+        auto start = Clock::now();
+        StrategyProtocol::FrameHeader header;
+        if (!StrategyProtocol::writeAll(fd, request.data(), request.size()) ||
+            !StrategyProtocol::readFrame(fd, StrategyProtocol::RESPONSE_MAGIC, header, body) ||
+            !StrategyProtocol::decodeResponse(header, body, response) ||
+            response.status != StrategyProtocol::Status::OK || response.requestId != static_cast<uint32_t>(r)) {
+            result.failed = true;
+            break;
+        }
+        uint64_t nanos = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+        ++result.bins[LatencyHistogram::binIndex(nanos)];
+        ++result.requests;
+        result.decisions += response.found.size();
+        result.found += static_cast<uint64_t>(std::count(response.found.begin(), response.found.end(), 1));
+    }
+    close(fd);
+}
+
+// Lower bound of the bin holding the given quantile, in microseconds
+double percentileUs(const Bins& bins, uint64_t total, double quantile) {
+    uint64_t target = static_cast<uint64_t>(quantile * static_cast<double>(total));
+    uint64_t seen = 0;
+    for (int i = 0; i < LatencyHistogram::NUM_BINS; ++i) {
+        seen += bins[i];
+        if (seen > target) {
+            return LatencyHistogram::binLowerBound(i) / 1000.0;
+        }
+    }
+    return 0.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string socketPath = "/tmp/poker_strategy.sock";
+    int numConnections = 4;
+    int requests = 10000;
+    int batch = 16;
+    uint64_t seed = 42;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--connections" && i + 1 < argc) {
+            numConnections = std::stoi(argv[++i]);
+        } else if (arg == "--requests" && i + 1 < argc) {
+            requests = std::stoi(argv[++i]);
+        } else if (arg == "--batch" && i + 1 < argc) {
+            batch = std::stoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--socket PATH] [--connections N] [--requests N]"
+                      << " [--batch N] [--seed N]" << std::endl;
+            return 1;
+        }
+    }
+    if (numConnections < 1 || requests < 1 || batch < 1 ||
+        batch > static_cast<int>(StrategyProtocol::MAX_DECISIONS)) {
+        std::cerr << "--connections and --requests must be positive, --batch 1-"
+                  << StrategyProtocol::MAX_DECISIONS << std::endl;
+        return 1;
+    }
+
+    std::vector<ConnectionResult> results(static_cast<size_t>(numConnections));
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    for (int c = 0; c < numConnections; ++c) {
+        threads.emplace_back(runConnection, std::cref(socketPath), requests, batch, seed, c, std::ref(results[c]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    Bins bins{};
+    ConnectionResult total;
+    int failedConnections = 0;
+    for (const auto& result : results) {
+        for (int i = 0; i < LatencyHistogram::NUM_BINS; ++i) {
+            bins[i] += result.bins[i];
+        }
+        total.requests += result.requests;
+        total.decisions += result.decisions;
+        total.found += result.found;
+        failedConnections += result.failed ? 1 : 0;
+    }
+    if (total.requests == 0) {
+        std::cerr << "No request completed; is strategy_server listening on " << socketPath << "?" << std::endl;
+        return 1;
+    }
+
+    double maxUs = 0.0;
+    for (int i = LatencyHistogram::NUM_BINS - 1; i >= 0; --i) {
+        if (bins[i] != 0) {
+            maxUs = LatencyHistogram::binLowerBound(i) / 1000.0;
+            break;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Connections: " << numConnections << " (" << failedConnections << " failed)"
+              << ", batch: " << batch << std::endl;
+    std::cout << "Requests: " << total.requests << " in " << seconds << " s ("
+              << total.requests / seconds << " req/s, " << total.decisions / seconds << " decisions/s)" << std::endl;
+    std::cout << "Latency us: p50 " << percentileUs(bins, total.requests, 0.50)
+              << ", p99 " << percentileUs(bins, total.requests, 0.99)
+              << ", p99.9 " << percentileUs(bins, total.requests, 0.999)
+              << ", max " << maxUs << std::endl;
+    std::cout << "Found: " << std::setprecision(2)
+              << 100.0 * static_cast<double>(total.found) / static_cast<double>(total.decisions) << "%" << std::endl;
+    return failedConnections == 0 ? 0 : 1;
+}
\ No newline at end of file
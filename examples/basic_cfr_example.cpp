@@ -2,13 +2,20 @@
 #include <memory>
 #include <string>
 #include <chrono>
+#include <algorithm>
 
 #include "game/GameState.hpp"
 #include "cfr/CFRSolver.hpp"
+#include "cfr/SubgameSolver.hpp"
 #include "abstraction/HandAbstraction.hpp"
 #include "abstraction/BetAbstraction.hpp"
 #include "utils/Logger.hpp"
 #include "utils/Random.hpp"  // Added missing include
+#include "utils/Metrics.hpp"
+#include "utils/Trace.hpp"
+#include "utils/Serialization.hpp"
+#include "runtime/MappedStrategy.hpp"
+#include "game/PreflopEquity.hpp"
 
 using namespace poker;
 
@@ -16,6 +23,9 @@ int main(int argc, char* argv[]) {
     // Initialize logger
     Logger::getInstance().init(Logger::Level::INFO, Logger::Destination::BOTH, "cfr_example.log");
     
+    // Keep disk I/O off the training thread
+    Logger::getInstance().startAsync();
+    
     LOG_INFO("Starting 3-player CFRM-based Poker Bot example");
     
     // Parse command line arguments
@@ -23,7 +33,21 @@ int main(int argc, char* argv[]) {
     std::string loadFile = "";
     std::string saveFile = "strategy.dat";
     bool useMonteCarloSampling = true;
+    bool publicTree = false;
     bool runTest = true;
+    uint64_t seed = 0;
+    bool hasSeed = false;
+    std::string metricsFile = "";
+    std::string traceFile = "";
+    bool detailedTiming = false;
+    size_t memoryBudgetMb = 0;
+    std::string checkpointFile = "";
+    int checkpointEvery = 1000;
+    std::string resumeFile = "";
+    std::string exportFile = "";
+    MappedStrategy::Encoding exportEncoding = MappedStrategy::Encoding::FLOAT32;
+    double resolveMs = 0.0;
+    std::string preflopEquityFile = "";
     
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -35,8 +59,38 @@ int main(int argc, char* argv[]) {
             saveFile = argv[++i];
         } else if (arg == "--monte-carlo") {
             useMonteCarloSampling = true;
+        } else if (arg == "--public-tree") {
+            publicTree = true;
         } else if (arg == "--no-test") {
             runTest = false;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+            hasSeed = true;
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            metricsFile = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (arg == "--detailed-timing") {
+            detailedTiming = true;
+        } else if (arg == "--memory-budget-mb" && i + 1 < argc) {
+            memoryBudgetMb = std::stoull(argv[++i]);
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpointFile = argv[++i];
+        } else if (arg == "--checkpoint-every" && i + 1 < argc) {
+            checkpointEvery = std::stoi(argv[++i]);
+        } else if (arg == "--resume" && i + 1 < argc) {
+            resumeFile = argv[++i];
+        } else if (arg == "--export-runtime" && i + 1 < argc) {
+            exportFile = argv[++i];
+        } else if (arg == "--export-encoding" && i + 1 < argc) {
+            if (!MappedStrategy::encodingFromString(argv[++i], exportEncoding)) {
+                std::cerr << "Unknown encoding: " << argv[i] << " (expected f32, q16 or q8)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--resolve-ms" && i + 1 < argc) {
+            resolveMs = std::stod(argv[++i]);
+        } else if (arg == "--preflop-equity" && i + 1 < argc) {
+            preflopEquityFile = argv[++i];
         } else if (arg == "--help") {
             std::cout << "Usage: " << argv[0] << " [options]\n"
                       << "Options:\n"
@@ -44,12 +98,38 @@ int main(int argc, char* argv[]) {
                       << "  --load FILE       Load strategy from file\n"
                       << "  --save FILE       Save strategy to file (default: strategy.dat)\n"
                       << "  --monte-carlo     Use Monte Carlo sampling for faster convergence\n"
+                      << "  --public-tree     Train every hole-card combo at once on one sampled\n"
+                      << "                    board per iteration (range-vs-range CFR)\n"
                       << "  --no-test         Skip test hand playthrough\n"
+                      << "  --seed N          Seed for reproducible training runs\n"
+                      << "  --metrics FILE    Write per-phase training metrics as JSON\n"
+                      << "  --detailed-timing Also time bucket lookups and terminal evaluation\n"
+                      << "  --trace FILE      Write a Chrome trace of training (chrome://tracing)\n"
+                      << "  --memory-budget-mb N  Keep regret/strategy tables under N MB by evicting\n"
+                      << "                    least-recently-used info sets\n"
+                      << "  --checkpoint FILE Write a checkpoint in the background during training\n"
+                      << "  --checkpoint-every N  Iterations between checkpoints (default: 1000)\n"
+                      << "  --resume FILE     Continue from a checkpoint; --iterations is then the\n"
+                      << "                    total to reach, not the number to add\n"
+                      << "  --export-runtime FILE  Write the average strategy as a memory-mappable file\n"
+                      << "  --export-encoding E    Probability storage for --export-runtime: f32\n"
+                      << "                    (default), q16 or q8\n"
+                      << "  --resolve-ms N    Re-solve the test hand's decision in real time with\n"
+                      << "                    finer bet sizes, within N milliseconds\n"
+                      << "  --preflop-equity FILE  Score preflop all-ins from a table written by\n"
+                      << "                    preflop_equity_builder\n"
                       << "  --help            Show this help message\n";
             return 0;
         }
     }
     
+    Metrics::getInstance().setDetailedTiming(detailedTiming);
+    
+    // Must be mapped before any training thread evaluates a terminal
+    if (!preflopEquityFile.empty() && !PreflopEquityTable::getInstance().load(preflopEquityFile)) {
+        return 1;
+    }
+    
     try {
         // Create abstraction objects
         auto handAbstraction = HandAbstraction::create(HandAbstraction::Level::DETAILED);
@@ -65,6 +145,29 @@ int main(int argc, char* argv[]) {
         // Create the CFR solver
         LOG_INFO("Initializing CFR solver...");
         CFRSolver solver(std::move(initialState), handAbstraction, betAbstraction);
+        if (hasSeed) {
+            solver.setSeed(seed);
+        }
+        if (memoryBudgetMb > 0) {
+            solver.setMemoryBudget(memoryBudgetMb * 1024 * 1024);
+        }
+        
+        // Resume training state if a checkpoint exists
+        if (!resumeFile.empty()) {
+            if (!Serialization::fileExists(resumeFile)) {
+                LOG_WARNING("No checkpoint at " + resumeFile + ", starting from scratch");
+            } else if (solver.loadCheckpoint(resumeFile)) {
+                int completed = solver.getTrainingStats(false).iterations;
+                LOG_INFO("Resumed at iteration " + std::to_string(completed));
+                iterations = std::max(0, iterations - completed);
+            } else {
+                LOG_ERROR("Failed to resume from " + resumeFile);
+                return 1;
+            }
+        }
+        if (!checkpointFile.empty()) {
+            solver.setCheckpointing(checkpointFile, checkpointEvery);
+        }
         
         // Load strategy if specified
         if (!loadFile.empty()) {
@@ -83,6 +186,10 @@ int main(int argc, char* argv[]) {
                 std::cout << "Iteration " << iteration 
                         << " complete. Info sets: " << stats.infoSetCount
                         << ", Avg time: " << stats.avgTimePerIteration << " ms"
+                        << ", p50/p99: " << stats.metrics.iterationP50Us / 1000.0
+                        << "/" << stats.metrics.iterationP99Us / 1000.0 << " ms"
+                        << ", Bucket misses: " << stats.metrics.get(Counter::BUCKET_MISSES)
+                        << ", Tables: " << stats.tableBytes / (1024.0 * 1024.0) << " MB"
                         << std::endl;
                 
                 if (iteration % 100 == 0) {
@@ -95,7 +202,23 @@ int main(int argc, char* argv[]) {
             LOG_INFO("Starting CFR training for " + std::to_string(iterations) + " iterations...");
             auto startTime = std::chrono::high_resolution_clock::now();
             
-            solver.train(iterations, useMonteCarloSampling);
+            if (!traceFile.empty()) {
+                Tracer::getInstance().setThreadName("trainer");
+                Tracer::getInstance().start();
+            }
+            
+            if (publicTree) {
+                solver.train(iterations, CFRSolver::TraversalMode::PUBLIC_TREE);
+            } else {
+                solver.train(iterations, useMonteCarloSampling);
+            }
+            
+            if (!traceFile.empty()) {
+                Tracer::getInstance().stop();
+                if (Tracer::getInstance().writeChromeTrace(traceFile)) {
+                    LOG_INFO("Trace written to " + traceFile);
+                }
+            }
             
             LOG_INFO("Extracting RFI ranges from trained strategy");
 solver.extractRFIRanges("data/strategies/btn_rfi_range.txt", "data/strategies/sb_rfi_range.txt");
@@ -114,6 +237,14 @@ solver.extractRFIRanges("data/strategies/btn_rfi_range.txt", "data/strategies/sb
             }
         }
         
+        // Export the read-only runtime strategy if requested
+        if (!exportFile.empty()) {
+            LOG_INFO("Exporting runtime strategy to " + exportFile);
+            if (!MappedStrategy::write(exportFile, solver.getStrategyTable(), exportEncoding)) {
+                LOG_ERROR("Failed to export runtime strategy");
+            }
+        }
+        
         // Run a test hand if requested
         if (runTest) {
             // Create a new game state for testing
@@ -144,6 +275,21 @@ solver.extractRFIRanges("data/strategies/btn_rfi_range.txt", "data/strategies/sb
             for (const auto& [action, prob] : strategy) {
                 std::cout << "  " << action.toString() << ": " << prob << std::endl;
             }
+            
+            // Refine the blueprint for this decision with a finer bet abstraction
+            if (resolveMs > 0.0) {
+                SubgameSolver::Options options;
+                options.timeBudgetMs = resolveMs;
+                SubgameSolver subgameSolver(solver.getStrategyTable(), handAbstraction, betAbstraction,
+                                            BetAbstraction::create(BetAbstraction::Level::DETAILED), options);
+                auto refined = subgameSolver.solve(*testState);
+                
+                std::cout << "Re-solved strategy (" << refined.iterations << " iterations, "
+                          << refined.nodes << " nodes, " << refined.elapsedMs << " ms):" << std::endl;
+                for (size_t a = 0; a < refined.actions.size(); ++a) {
+                    std::cout << "  " << refined.actions[a].toString() << ": " << refined.probabilities[a] << std::endl;
+                }
+            }
         }
         
         // Get final training stats
@@ -153,6 +299,11 @@ solver.extractRFIRanges("data/strategies/btn_rfi_range.txt", "data/strategies/sb
         LOG_INFO("  Info sets: " + std::to_string(stats.infoSetCount));
         LOG_INFO("  Exploitability: " + std::to_string(stats.exploitability));
         LOG_INFO("  Avg time per iteration: " + std::to_string(stats.avgTimePerIteration) + " ms");
+        LOG_INFO("Memory footprint:\n" + formatFootprints(stats.footprint));
+        
+        if (!metricsFile.empty() && Metrics::getInstance().writeJson(metricsFile)) {
+            LOG_INFO("Training metrics written to " + metricsFile);
+        }
         
     } catch (const std::exception& e) {
         LOG_ERROR("Exception: " + std::string(e.what()));
@@ -0,0 +1,345 @@
+// examples/game_size_estimator.cpp
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "cfr/CFRSolver.hpp"
+#include "cfr/RegretTable.hpp"
+#include "cfr/StrategyTable.hpp"
+#include "game/GameState.hpp"
+#include "abstraction/HandAbstraction.hpp"
+#include "abstraction/BetAbstraction.hpp"
+#include "utils/Logger.hpp"
+#include "utils/MemoryFootprint.hpp"
+
+/**
+ * Abstract game size estimator. Walks the abstracted betting tree of each bet
+ * abstraction once (the tree does not depend on the cards), then multiplies
+ * decision nodes by the hand buckets of their street to get info-set and
+ * action-slot counts for each hand abstraction, the memory those tables take
+ * under each storage layout, and the nodes one training iteration touches.
+ *
+ * Usage: game_size_estimator [--hand-abs minimal,standard,detailed]
+ *                            [--bet-abs minimal,standard] [--max-nodes N]
+ *                            [--calibrate N]
+ *
+ * --calibrate N trains N iterations per traversal mode on a fresh solver to
+ * measure ns/node; the per-iteration estimate is nodes x ns/node and is a lower
+ * bound for large tables, whose lookups miss cache more often.
+ */
+
+using namespace poker;
+
+namespace {
+
+constexpr int NUM_ROUNDS = 4;
+
+// Shape of the abstracted betting tree, per street
+struct TreeShape {
+    size_t decisionNodes[NUM_ROUNDS] = {};
+    size_t actionSlots[NUM_ROUNDS] = {};
+    size_t terminalNodes = 0;
+    size_t maxActions = 0;
+    int maxDepth = 0;
+    double monteCarloPathLength = 0.0;     // Expected nodes per MC iteration (uniform play)
+
+    // Entries keyed by (street, key length without bucket digits, action count)
+    std::map<std::tuple<int, size_t, size_t>, size_t> entryShapes;
+
+    size_t totalNodes() const {
+        size_t total = terminalNodes;
+        for (size_t count : decisionNodes) {
+            total += count;
+        }
+        return total;
+    }
+};
+
+class TreeWalker {
+public:
+    TreeWalker(const CFRSolver& solver, size_t maxNodes) : solver_(solver), maxNodes_(maxNodes) {}
+
+    // Returns the expected path length below state under uniform sampling
+    double walk(const GameState& state, int depth, TreeShape& shape) {
+        if (shape.totalNodes() >= maxNodes_) {
+            throw std::runtime_error("Betting tree exceeds " + std::to_string(maxNodes_) +
+                                     " nodes (raise --max-nodes)");
+        }
+        shape.maxDepth = std::max(shape.maxDepth, depth);
+
+        if (state.isTerminal()) {
+            shape.terminalNodes++;
+            return 1.0;
+        }
+
+        std::vector<Action> actions = solver_.getAbstractedActions(state);
+        if (actions.empty()) {
+            throw std::runtime_error("No valid actions for non-terminal state");
+        }
+
+        int round = static_cast<int>(state.getBettingRound());
+        shape.decisionNodes[round]++;
+        shape.actionSlots[round] += actions.size();
+        shape.maxActions = std::max(shape.maxActions, actions.size());
+
+        // Key length with a one-digit bucket; more digits are added per bucket later
+        size_t keyLength = CFRSolver::makeInfoSetKey(state.getCurrentPosition(), state.getBettingRound(), 0,
+                                                     state.getActionHistory().toString()).size();
+        shape.entryShapes[{round, keyLength, actions.size()}]++;
+
+        double childPathLength = 0.0;
+        for (const auto& action : actions) {
+            auto next = state.clone();
+            bool roundOver = next->applyAction(action);
+            if (roundOver && !next->isTerminal()) {
+                next->startNextBettingRound();
+            }
+            childPathLength += walk(*next, depth + 1, shape);
+        }
+
+        return 1.0 + childPathLength / actions.size();
+    }
+
+private:
+    const CFRSolver& solver_;
+    size_t maxNodes_;
+};
+
+// Adds count copies of one entry's footprint
+void addScaled(TableFootprint& total, const TableFootprint& entry, size_t count) {
+    total.entries += entry.entries * count;
+    total.actions += entry.actions * count;
+    total.nodeBytes += entry.nodeBytes * count;
+    total.keyBytes += entry.keyBytes * count;
+    total.bucketBytes += entry.bucketBytes * count;
+    total.allocations += entry.allocations * count;
+    total.allocatorOverhead += entry.allocatorOverhead * count;
+}
+
+// Buckets whose index has the given number of decimal digits
+size_t bucketsWithDigits(int numBuckets, int digits) {
+    long low = digits == 1 ? 0 : 1;
+    for (int i = 1; i < digits; ++i) {
+        low *= 10;
+    }
+    long high = low == 0 ? 10 : low * 10;
+    long count = std::min<long>(numBuckets, high) - low;
+    return count > 0 ? static_cast<size_t>(count) : 0;
+}
+
+// Outer bucket array: libstdc++ doubles on growth, so expect ~1.5 buckets per entry
+void addOuterBuckets(TableFootprint& footprint) {
+    size_t bytes = footprint.entries * 3 / 2 * sizeof(void*);
+    footprint.bucketBytes += bytes;
+    footprint.addAllocation(bytes);
+}
+
+struct Calibration {
+    double vanillaNsPerNode = 0.0;
+    double monteCarloNsPerNode = 0.0;
+};
+
+double measureNsPerNode(std::shared_ptr<HandAbstraction> handAbstraction,
+                        std::shared_ptr<BetAbstraction> betAbstraction,
+                        CFRSolver::TraversalMode mode, int iterations) {
+    CFRSolver solver(std::make_unique<GameState>(), handAbstraction, betAbstraction);
+    solver.setSeed(1);
+
+    auto start = std::chrono::steady_clock::now();
+    solver.train(iterations, mode);
+    double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t nodes = solver.getNodesVisited();
+    return nodes > 0 ? nanos / nodes : 0.0;
+}
+
+std::string formatCount(double value) {
+    std::ostringstream oss;
+    if (value >= 1e9) {
+        oss << std::fixed << std::setprecision(2) << value / 1e9 << "G";
+    } else if (value >= 1e6) {
+        oss << std::fixed << std::setprecision(2) << value / 1e6 << "M";
+    } else if (value >= 1e4) {
+        oss << std::fixed << std::setprecision(1) << value / 1e3 << "K";
+    } else {
+        oss << std::fixed << std::setprecision(0) << value;
+    }
+    return oss.str();
+}
+
+void report(const std::string& handName, const HandAbstraction& handAbstraction,
+            const std::string& betName, const TreeShape& shape, const Calibration* calibration) {
+    static const char* roundNames[NUM_ROUNDS] = {"preflop", "flop", "turn", "river"};
+
+    std::cout << "\n=== hand " << handName << " x bet " << betName << " ===\n";
+    std::cout << std::left << std::setw(10) << "street" << std::right << std::setw(10) << "buckets"
+              << std::setw(12) << "histories" << std::setw(14) << "info sets" << std::setw(14) << "action slots"
+              << "\n";
+
+    size_t totalInfoSets = 0;
+    size_t totalSlots = 0;
+    for (int round = 0; round < NUM_ROUNDS; ++round) {
+        size_t buckets = handAbstraction.getNumBuckets(static_cast<BettingRound>(round));
+        size_t infoSets = shape.decisionNodes[round] * buckets;
+        size_t slots = shape.actionSlots[round] * buckets;
+        totalInfoSets += infoSets;
+        totalSlots += slots;
+
+        std::cout << std::left << std::setw(10) << roundNames[round] << std::right << std::setw(10) << buckets
+                  << std::setw(12) << shape.decisionNodes[round] << std::setw(14) << formatCount(infoSets)
+                  << std::setw(14) << formatCount(slots) << "\n";
+    }
+    std::cout << std::left << std::setw(10) << "total" << std::right << std::setw(10) << ""
+              << std::setw(12) << shape.totalNodes() - shape.terminalNodes << std::setw(14)
+              << formatCount(totalInfoSets) << std::setw(14) << formatCount(totalSlots) << "\n";
+
+    // Hash-map tables: one entry per info set, sized from the real entry layout
+    TableFootprint regrets;
+    regrets.name = "regrets";
+    TableFootprint strategy;
+    strategy.name = "strategy";
+    for (const auto& [entryShape, histories] : shape.entryShapes) {
+        auto [round, keyLength, numActions] = entryShape;
+        int numBuckets = handAbstraction.getNumBuckets(static_cast<BettingRound>(round));
+        for (int digits = 1; bucketsWithDigits(numBuckets, digits) > 0; ++digits) {
+            size_t count = histories * bucketsWithDigits(numBuckets, digits);
+            addScaled(regrets, RegretTable::estimateEntry(keyLength + digits - 1, numActions), count);
+            addScaled(strategy, StrategyTable::estimateEntry(keyLength + digits - 1, numActions), count);
+        }
+    }
+    addOuterBuckets(regrets);
+    addOuterBuckets(strategy);
+
+    std::cout << "\nTable memory by storage layout (regrets + current strategy + strategy sum):\n";
+    std::cout << formatFootprints({regrets, strategy});
+    std::cout << "  hash-map (current tables): " << formatBytes(regrets.totalBytes() + strategy.totalBytes()) << "\n"
+              << "  dense float64 arrays:      " << formatBytes(totalSlots * 3 * sizeof(double)) << "\n"
+              << "  dense float32 arrays:      " << formatBytes(totalSlots * 3 * sizeof(float)) << "\n";
+
+    std::cout << "\nPer-iteration cost:\n"
+              << "  vanilla:     " << formatCount(shape.totalNodes()) << " nodes (full tree, "
+              << shape.terminalNodes << " terminals)\n"
+              << "  monte_carlo: " << std::fixed << std::setprecision(1) << shape.monteCarloPathLength
+              << " nodes expected (uniform play, max depth " << shape.maxDepth << ")\n";
+    if (calibration) {
+        std::cout << "  vanilla:     ~" << std::setprecision(3)
+                  << shape.totalNodes() * calibration->vanillaNsPerNode / 1e6 << " ms/iteration at "
+                  << std::setprecision(0) << calibration->vanillaNsPerNode << " ns/node\n"
+                  << "  monte_carlo: ~" << std::setprecision(3)
+                  << shape.monteCarloPathLength * calibration->monteCarloNsPerNode / 1e3 << " us/iteration at "
+                  << std::setprecision(0) << calibration->monteCarloNsPerNode << " ns/node\n";
+    }
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::istringstream iss(list);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+template <typename Level>
+bool parseLevel(const std::string& name, Level& level) {
+    if (name == "none") level = Level::NONE;
+    else if (name == "minimal") level = Level::MINIMAL;
+    else if (name == "standard") level = Level::STANDARD;
+    else if (name == "detailed") level = Level::DETAILED;
+    else return false;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> handLevels = {"minimal", "standard", "detailed"};
+    std::vector<std::string> betLevels = {"minimal", "standard"};
+    size_t maxNodes = 50000000;
+    int calibrateIterations = 0;
+
+    const std::string usage = std::string("Usage: ") + argv[0] +
+        " [--hand-abs LEVEL,...] [--bet-abs LEVEL,...] [--max-nodes N] [--calibrate N]";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--hand-abs" && hasValue) {
+            handLevels = splitList(argv[++i]);
+        } else if (arg == "--bet-abs" && hasValue) {
+            betLevels = splitList(argv[++i]);
+        } else if (arg == "--max-nodes" && hasValue) {
+            maxNodes = std::stoull(argv[++i]);
+        } else if (arg == "--calibrate" && hasValue) {
+            calibrateIterations = std::stoi(argv[++i]);
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+
+    // Calibration trains briefly; keep its progress logging quiet
+    Logger::getInstance().init(Logger::Level::WARNING);
+
+    try {
+        for (const auto& betName : betLevels) {
+            BetAbstraction::Level betLevel;
+            if (!parseLevel(betName, betLevel)) {
+                std::cerr << "Unknown bet abstraction: " << betName << std::endl;
+                return 1;
+            }
+            auto betAbstraction = BetAbstraction::create(betLevel);
+
+            // The betting tree depends only on the bet abstraction
+            CFRSolver solver(std::make_unique<GameState>(), nullptr, betAbstraction);
+            GameState root;
+            root.reset();
+            root.dealHoleCards();
+
+            TreeShape shape;
+            TreeWalker walker(solver, maxNodes);
+            auto walkStart = std::chrono::steady_clock::now();
+            shape.monteCarloPathLength = walker.walk(root, 0, shape);
+            double walkSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - walkStart).count();
+            std::cout << "Bet abstraction " << betName << ": " << shape.totalNodes() << " tree nodes, up to "
+                      << shape.maxActions << " actions per decision (walked in " << std::fixed
+                      << std::setprecision(2) << walkSeconds << " s)\n";
+
+            for (const auto& handName : handLevels) {
+                HandAbstraction::Level handLevel;
+                if (!parseLevel(handName, handLevel)) {
+                    std::cerr << "Unknown hand abstraction: " << handName << std::endl;
+                    return 1;
+                }
+                auto handAbstraction = HandAbstraction::create(handLevel);
+
+                Calibration calibration;
+                if (calibrateIterations > 0) {
+                    calibration.vanillaNsPerNode = measureNsPerNode(
+                        handAbstraction, betAbstraction, CFRSolver::TraversalMode::VANILLA, calibrateIterations);
+                    calibration.monteCarloNsPerNode = measureNsPerNode(
+                        handAbstraction, betAbstraction, CFRSolver::TraversalMode::MONTE_CARLO, calibrateIterations);
+                }
+
+                report(handName, *handAbstraction, betName, shape, calibrateIterations > 0 ? &calibration : nullptr);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "game/PreflopEquity.hpp"
+#include "utils/Logger.hpp"
+
+using namespace poker;
+
+/**
+ * Builds the preflop all-in equity table that GameState scores preflop
+ * all-ins with (load it with --preflop-equity in poker_cfr_bot).
+ *
+ * Usage: preflop_equity_builder [--out FILE] [--boards N] [--headsup-boards N]
+ *                               [--threads N] [--seed N] [--heads-up-only]
+ *
+ * Heads-up equities are exact by default (every board, ~47k matchups).
+ * Exact 3-way equities need C(46,5) boards for each of ~12.7M matchups, so
+ * 3-way boards are sampled (--boards, default 5000: standard error below
+ * 0.7% equity); --boards 0 enumerates them too, given enough CPU time.
+ */
+
+namespace {
+
+constexpr uint32_t NUM_HAND_INDICES = 52 * 51 / 2;
+
+// Pair of card indices for every hand index (same order as the table's keys)
+std::vector<CardMask> handMasks() {
+    std::vector<CardMask> masks;
+    masks.reserve(NUM_HAND_INDICES);
+    for (uint8_t high = 1; high < DECK_SIZE; ++high) {
+        for (uint8_t low = 0; low < high; ++low) {
+            masks.push_back(cardBit(high) | cardBit(low));
+        }
+    }
+    return masks;
+}
+
+// Canonical keys of every 2- or 3-hand class, sorted
+std::vector<uint64_t> enumerateClasses(int numHands, unsigned numThreads) {
+    const std::vector<CardMask> masks = handMasks();
+    std::atomic<uint32_t> nextFirst{0};
+    std::vector<std::vector<uint64_t>> perThread(numThreads);
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] {
+            int slots[PreflopEquityTable::MAX_HANDS];
+            uint32_t indices[PreflopEquityTable::MAX_HANDS];
+            CardMask hands[PreflopEquityTable::MAX_HANDS];
+            for (uint32_t i0; (i0 = nextFirst.fetch_add(1)) < NUM_HAND_INDICES;) {
+                for (uint32_t i1 = 0; i1 < i0; ++i1) {
+                    if (masks[i0] & masks[i1]) continue;
+                    uint32_t lastEnd = numHands == 3 ? i1 : 1;
+                    for (uint32_t i2 = 0; i2 < lastEnd; ++i2) {
+                        if (numHands == 3 && ((masks[i0] | masks[i1]) & masks[i2])) continue;
+                        indices[0] = i0;
+                        indices[1] = i1;
+                        indices[2] = i2;
+                        for (int h = 0; h < numHands; ++h) {
+                            hands[h] = masks[indices[h]];
+                        }
+                        // A matchup represents its class when its own key
+                        // (indices are descending) is the canonical one
+                        uint64_t key = PreflopEquityTable::packKey(indices, numHands);
+                        if (PreflopEquityTable::canonicalKey(hands, numHands, slots) == key) {
+                            perThread[t].push_back(key);
+                        }
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<uint64_t> keys;
+    for (const auto& local : perThread) {
+        keys.insert(keys.end(), local.begin(), local.end());
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// Equities of every key; boards for the given hand count (0 = exact)
+void computeRecords(const std::vector<uint64_t>& keys, std::vector<PreflopEquityTable::Record>& records,
+                    uint32_t headsUpBoards, uint32_t threeWayBoards, uint64_t seed, unsigned numThreads) {
+    constexpr size_t CHUNK = 64;
+    records.assign(keys.size(), PreflopEquityTable::Record{});
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<size_t> done{0};
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&] {
+            CardMask hands[PreflopEquityTable::MAX_HANDS];
+            double equities[PreflopEquityTable::MAX_HANDS];
+            for (size_t begin; (begin = nextChunk.fetch_add(CHUNK)) < keys.size();) {
+                size_t end = std::min(begin + CHUNK, keys.size());
+                for (size_t i = begin; i < end; ++i) {
+                    int numHands = PreflopEquityTable::handsOfKey(keys[i], hands);
+                    uint32_t boards = numHands == 2 ? headsUpBoards : threeWayBoards;
+                    PreflopEquityTable::computeEquities(hands, numHands, boards,
+                                                        seed ^ (keys[i] * 0x9E3779B97F4A7C15ULL), equities);
+                    for (int h = 0; h < numHands; ++h) {
+                        records[i].equity[h] = static_cast<float>(equities[h]);
+                    }
+                }
+
+                size_t total = done.fetch_add(end - begin) + (end - begin);
+                if (total * 100 / keys.size() != (total - (end - begin)) * 100 / keys.size()) {
+                    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    LOG_INFO(std::to_string(total) + "/" + std::to_string(keys.size()) + " matchups after " +
+                             std::to_string(static_cast<int>(seconds)) + "s");
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string outFile = "preflop_equity.bin";
+    uint32_t threeWayBoards = 5000;
+    uint32_t headsUpBoards = 0;
+    unsigned numThreads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t seed = 42;
+    bool headsUpOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            outFile = argv[++i];
+        } else if (arg == "--boards" && i + 1 < argc) {
+            threeWayBoards = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--headsup-boards" && i + 1 < argc) {
+            headsUpBoards = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            numThreads = std::max(1u, static_cast<unsigned>(std::stoul(argv[++i])));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else if (arg == "--heads-up-only") {
+            headsUpOnly = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--out FILE] [--boards N] [--headsup-boards N]"
+                      << " [--threads N] [--seed N] [--heads-up-only]" << std::endl;
+            return 1;
+        }
+    }
+
+    Logger::getInstance().init(Logger::Level::INFO);
+
+    std::vector<uint64_t> keys = enumerateClasses(2, numThreads);
+    LOG_INFO(std::to_string(keys.size()) + " heads-up matchups");
+    if (!headsUpOnly) {
+        std::vector<uint64_t> threeWay = enumerateClasses(3, numThreads);
+        LOG_INFO(std::to_string(threeWay.size()) + " 3-way matchups");
+        // Heads-up keys sort before 3-way keys (the hand count is the top field)
+        keys.insert(keys.end(), threeWay.begin(), threeWay.end());
+    }
+
+    std::vector<PreflopEquityTable::Record> records;
+    computeRecords(keys, records, headsUpBoards, threeWayBoards, seed, numThreads);
+
+    if (!PreflopEquityTable::write(outFile, keys, records, headsUpBoards, threeWayBoards)) {
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
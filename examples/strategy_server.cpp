@@ -0,0 +1,104 @@
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "abstraction/HandAbstraction.hpp"
+#include "runtime/MappedStrategy.hpp"
+#include "runtime/StrategyQueryEngine.hpp"
+#include "runtime/StrategyServer.hpp"
+#include "utils/Logger.hpp"
+
+using namespace poker;
+
+/**
+ * Serves one mapped strategy (see --export-runtime in poker_cfr_bot) to every
+ * bot process on the host over a Unix domain socket.
+ *
+ * Usage: strategy_server --strategy FILE [--socket PATH] [--threads N]
+ *                        [--hand-abs minimal|standard|detailed]
+ *
+ * The hand abstraction must be the one the strategy was trained with.
+ * SIGHUP re-reads the strategy file and swaps it in while queries keep
+ * running (write the new file elsewhere and rename it over the old one).
+ * SIGINT/SIGTERM shut the server down cleanly.
+ */
+
+namespace {
+
+bool parseHandLevel(const std::string& name, HandAbstraction::Level& level) {
+    if (name == "minimal") level = HandAbstraction::Level::MINIMAL;
+    else if (name == "standard") level = HandAbstraction::Level::STANDARD;
+    else if (name == "detailed") level = HandAbstraction::Level::DETAILED;
+    else return false;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string strategyFile;
+    std::string socketPath = "/tmp/poker_strategy.sock";
+    unsigned numThreads = 0;
+    HandAbstraction::Level handLevel = HandAbstraction::Level::DETAILED;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--strategy" && i + 1 < argc) {
+            strategyFile = argv[++i];
+        } else if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            numThreads = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (arg == "--hand-abs" && i + 1 < argc && parseHandLevel(argv[i + 1], handLevel)) {
+            ++i;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " --strategy FILE [--socket PATH] [--threads N]"
+                      << " [--hand-abs minimal|standard|detailed]" << std::endl;
+            return 1;
+        }
+    }
+    if (strategyFile.empty()) {
+        std::cerr << "--strategy is required" << std::endl;
+        return 1;
+    }
+
+    Logger::getInstance().init(Logger::Level::INFO);
+
+    // Block the control signals in every thread; main waits for them below
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGHUP);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    auto strategy = std::make_shared<MappedStrategy>();
+    if (!strategy->open(strategyFile)) {
+        return 1;
+    }
+    LOG_INFO("Mapped " + std::to_string(strategy->size()) + " info sets (" +
+             MappedStrategy::encodingToString(strategy->encoding()) + ") from " + strategyFile);
+
+    auto handAbstraction = HandAbstraction::create(handLevel);
+    handAbstraction->precompute();
+
+    auto engine = std::make_shared<StrategyQueryEngine>(std::move(strategy), handAbstraction);
+    StrategyServer server(engine, numThreads);
+    if (!server.start(socketPath)) {
+        return 1;
+    }
+
+    // Reloads run here, off the worker threads
+    int signal = 0;
+    while (sigwait(&signals, &signal) == 0 && signal == SIGHUP) {
+        engine->reload(strategyFile);
+    }
+    LOG_INFO("Received signal " + std::to_string(signal) + ", shutting down");
+    server.stop();
+
+    StrategyServer::Stats stats = server.getStats();
+    std::cout << "Connections: " << stats.connections << ", requests: " << stats.requests
+              << ", decisions: " << stats.decisions << ", errors: " << stats.errors << std::endl;
+    return 0;
+}
\ No newline at end of file
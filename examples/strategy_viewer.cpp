@@ -5,6 +5,7 @@
 #include "cfr/StrategyTable.hpp"
 #include "game/Action.hpp"
 #include "utils/Logger.hpp"
+#include "utils/MemoryFootprint.hpp"
 
 using namespace poker;
 
@@ -53,6 +54,10 @@ int main(int argc, char* argv[]) {
     std::cout << "Turn info sets: " << turnSets << std::endl;
     std::cout << "River info sets: " << riverSets << std::endl;
     
+    // Print memory footprint of the loaded table
+    auto footprint = strategyTable.footprint();
+    std::cout << "\nMemory footprint:\n" << formatFootprints({footprint.current, footprint.sum});
+    
     // Print each info set and its strategies (applying filter if provided)
     int displayCount = 0;
     const int MAX_DISPLAY = 50; // Limit the number of displayed info sets
@@ -7,6 +7,7 @@
 #include <mutex>
 
 #include "game/PokerDefs.hpp"
+#include "utils/MemoryFootprint.hpp"
 
 namespace poker {
 
@@ -33,6 +34,13 @@ public:
         const std::vector<Card>& communityCards
     ) const;
     
+    // Same bucket as getBucket, but a postflop miss is not cached; for boards
+    // that are only bucketed once, such as every combo of one training deal
+    int getBucketUncached(
+        const std::array<Card, NUM_HOLE_CARDS>& holeCards,
+        const std::vector<Card>& communityCards
+    ) const;
+    
     std::string getBucketHandRange(int bucket, BettingRound round) const;
     std::string convertToHandString(const std::array<Card, NUM_HOLE_CARDS>& holeCards) const;
     std::string compressHandRange(const std::vector<std::string>& hands) const;
@@ -53,6 +61,9 @@ public:
     // Get abstraction name
     std::string getName() const;
     
+    // Memory breakdown of the hand-to-bucket cache
+    TableFootprint getCacheFootprint() const;
+    
     // Create abstraction based on level
     static std::shared_ptr<HandAbstraction> create(Level level);
 
@@ -87,7 +98,11 @@ private:
     // Precomputation helpers
     void computePreflopBuckets();
     
-    // Helper methods for bucket calculation
+    // Helper methods for bucket calculation (callers hold mutex_)
+    int calculateBucket(
+        const std::array<Card, NUM_HOLE_CARDS>& holeCards,
+        const std::vector<Card>& communityCards
+    ) const;
     int calculatePreflopBucket(const std::array<Card, NUM_HOLE_CARDS>& holeCards) const;
     int calculatePostflopBucket(double equity, BettingRound round) const;
     double calculatePreflopHandStrength(const std::array<Card, NUM_HOLE_CARDS>& holeCards) const;
@@ -6,12 +6,20 @@
 #include <vector>
 #include <functional>
 #include <atomic>
+#include <array>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "game/GameState.hpp"
+#include "game/RangeShowdown.hpp"
 #include "cfr/RegretTable.hpp"
 #include "cfr/StrategyTable.hpp"
+#include "cfr/Checkpoint.hpp"
+#include "cfr/DealPipeline.hpp"
 #include "abstraction/HandAbstraction.hpp"
 #include "abstraction/BetAbstraction.hpp"
+#include "utils/Metrics.hpp"
 
 namespace poker {
 
@@ -31,12 +39,26 @@ public:
     // Destructor
     ~CFRSolver();
     
+    // Tree traversal used by each training iteration
+    enum class TraversalMode {
+        VANILLA,        // Full-width CFR over the abstracted tree
+        MONTE_CARLO,    // Sample one action per decision node
+        PUBLIC_TREE     // Full-width CFR over public states for every hole-card
+                        // combo at once, on one sampled board per iteration
+    };
+    static std::string traversalModeToString(TraversalMode mode);
+    
     // Run CFR for specified number of iterations
     void train(int iterations, bool useMonteCarloSampling = false);
+    void train(int iterations, TraversalMode mode);
     
     // Run single CFR iteration
     void runIteration(bool useMonteCarloSampling = false);
     
+    // Seed all training randomness; each iteration draws from its own stream
+    // derived from (seed, iteration), so runs are reproducible
+    void setSeed(uint64_t seed);
+    
     // Get current strategy
     std::unordered_map<Action, double, RegretTable::ActionHash> 
     getStrategy(const std::string& infoSet, const std::vector<Action>& validActions);
@@ -51,14 +73,62 @@ public:
     // Load strategy
     bool loadStrategy(const std::string& filename);
     
+    // Save/restore full training state (regrets, strategies, iteration count and
+    // seed) in the chunked checkpoint format; numThreads 0 = hardware concurrency.
+    // Loading fails if the checkpoint was made with different abstractions.
+    bool saveCheckpoint(const std::string& filename, unsigned numThreads = 0) const;
+    bool loadCheckpoint(const std::string& filename, unsigned numThreads = 0);
+    
+    // Checkpoint to filename every intervalIterations completed iterations during
+    // train() (0 disables). The tables are encoded in memory at the iteration
+    // boundary and written by a background thread while training continues;
+    // loadCheckpoint() on the file resumes exactly where it was taken.
+    void setCheckpointing(const std::string& filename, int intervalIterations, unsigned numThreads = 0);
+    
+    // Wait for an in-flight background checkpoint; false if the last one failed
+    bool waitForCheckpoint();
+    
+    // Deals (with every player's street buckets) train() prepares ahead of the
+    // traversal on a background thread; 0 prepares each one on the training thread.
+    // The thread carries on across train() calls until the seed, iteration count
+    // or depth changes.
+    void setDealPrefetch(size_t depth) { dealPrefetch_ = depth; }
+    
     // Get training statistics
     struct TrainingStats {
         int iterations;
-        double exploitability;
+        double exploitability;      // Last estimateExploitability() result (0 if never run)
         size_t infoSetCount;
         double avgTimePerIteration;
+        uint64_t nodesVisited;
+        size_t tableBytes;          // Estimated regret + strategy table memory
+        std::vector<TableFootprint> footprint;  // Per-table breakdown; empty in progress callbacks
+        MetricsSnapshot metrics;    // Per-phase counters, times and iteration latency percentiles
     };
-    TrainingStats getTrainingStats() const;
+    // includeFootprint walks every table (see getMemoryFootprint)
+    TrainingStats getTrainingStats(bool includeFootprint = true) const;
+    
+    // Estimate the exploitability (NashConv, chips per hand) of the average strategy.
+    // Each player's best response is computed over sampleCount deals drawn from seed;
+    // the same seed gives the same deals, so estimates at different points of training
+    // are directly comparable. Small samples bias the estimate upward.
+    double estimateExploitability(int sampleCount, uint64_t seed = 0);
+    
+    // Game-tree nodes visited by training so far
+    uint64_t getNodesVisited() const { return nodesVisited_.load(std::memory_order_relaxed); }
+    
+    // Cap the estimated regret + strategy table memory (0 = unlimited). Once over
+    // the cap, each iteration evicts least-recently-used info sets, scanning at
+    // most maxBucketsPerIteration buckets per table, instead of the periodic
+    // full-table prune.
+    void setMemoryBudget(size_t bytes, size_t maxBucketsPerIteration = 8192);
+    
+    // Estimated regret + strategy table memory
+    size_t getTableMemoryBytes() const;
+    
+    // Memory breakdown of the regret table, both strategy parts and the hand
+    // bucket cache. Walks every table, so cost grows with the info-set count.
+    std::vector<TableFootprint> getMemoryFootprint() const;
     
     // Progress callback
     using ProgressCallback = std::function<void(int iteration, const TrainingStats&)>;
@@ -68,6 +138,21 @@ public:
                           const std::string& sbOutputFile = "sb_rfi_range.txt") const;
 
     const StrategyTable& getStrategyTable() const { return strategyTable_; }
+    const RegretTable& getRegretTable() const { return regretTable_; }
+    
+    // Each player's root value in the last PUBLIC_TREE iteration, summed over
+    // every hole-card combo on that board; zero-sum across players
+    const std::array<double, NUM_PLAYERS>& getPublicTreeRootValues() const { return publicRootValues_; }
+
+    // Get abstracted information set (key used by the regret/strategy tables)
+    std::string getAbstractedInfoSet(const GameState& state, Position position) const;
+    
+    // Get abstracted actions
+    std::vector<Action> getAbstractedActions(const GameState& state) const;
+    
+    // Info-set key: <position>|<round>|<hand_bucket>|<action_history>
+    static std::string makeInfoSetKey(Position position, BettingRound round, int handBucket,
+                                      const std::string& actionHistory);
 
 private:
     // CFR+ implementation with regret matching and averaging
@@ -78,13 +163,48 @@ private:
     std::unordered_map<Position, double> 
     monteCarloSample(GameState& state, std::unordered_map<Position, double>& reachProbabilities, int depth);
     
-    // Get abstracted information set
-    std::string getAbstractedInfoSet(const GameState& state, Position position) const;
+    // Reach probabilities or counterfactual values of one player, indexed like
+    // publicShowdown_.hands()
+    using RangeVector = std::vector<double>;
+    using Ranges = std::array<RangeVector, NUM_PLAYERS>;
     
-    // Get abstracted actions
-    std::vector<Action> getAbstractedActions(const GameState& state) const;
+    // Public-tree CFR: one walk of the betting tree updates every combo of
+    // every player. values[p][i] is player p's counterfactual value holding
+    // combo i (weighted by the opponents' reach).
+    void publicTreeCfr(const GameState& state, const Ranges& reach, Ranges& values, int depth);
+    void publicTreeTerminal(const GameState& state, const Ranges& reach, Ranges& values) const;
+    
+    // Info-set key of a traversal node, bucketed from dealBuckets_
+    std::string traversalInfoSet(const GameState& state, Position position) const;
     
     void pruneStrategiesAndRegrets();
+    
+    // Incremental eviction step run after each iteration when a budget is set
+    void enforceMemoryBudget();
+    
+    // Header fields describing the current training state
+    CheckpointMetadata checkpointMetadata() const;
+    
+    // Snapshot the tables and hand them to the background writer
+    void startBackgroundCheckpoint();
+    
+    // Body of the writer thread: write each handed-over snapshot until stopped
+    void checkpointWriterLoop();
+    
+    // Hand bucket of each player on each street of one sampled deal
+    using DealBuckets = DealPipeline::DealBuckets;
+    
+    // Best-response pass for estimateExploitability. Values are per deal: brValues
+    // when responder best-responds, policyValues when it plays the average strategy.
+    void bestResponse(const GameState& state, Position responder,
+                      const std::vector<DealOutcome>& deals, const std::vector<DealBuckets>& buckets,
+                      const std::vector<double>& opponentReach,
+                      std::vector<double>& brValues, std::vector<double>& policyValues,
+                      int depth) const;
+    
+    // Regret matching into a contiguous array aligned with validActions
+    void computeStrategy(const std::string& infoSet, const std::vector<Action>& validActions,
+                         double* strategy) const;
 
     // Update strategy based on current regrets
     void updateStrategy(const std::string& infoSet, const std::vector<Action>& validActions);
@@ -97,10 +217,38 @@ private:
     RegretTable regretTable_;
     StrategyTable strategyTable_;
     
+    // Buckets of the deal cfr()/monteCarloSample() are traversing
+    DealBuckets dealBuckets_{};
+    size_t dealPrefetch_{4};
+    std::unique_ptr<DealPipeline> dealPipeline_;    // Created by the first train()
+    
+    // PUBLIC_TREE state for the current iteration's board
+    RangeShowdown publicShowdown_;
+    DealPipeline::RangeBuckets publicBuckets_;      // [round][combo]
+    std::array<double, NUM_PLAYERS> publicRootValues_{};
+    
     // Training statistics - no need for atomic since we protect with mutex
     static constexpr int MAX_RECURSION_DEPTH = 100;
+    // Upper bound on abstracted actions at one decision (sizes stack buffers)
+    static constexpr size_t MAX_ACTIONS = 16;
     int iterationsCompleted_{0};
     double totalTrainingTime_{0.0};
+    double lastExploitability_{0.0};
+    std::atomic<uint64_t> nodesVisited_{0};
+    size_t memoryBudget_{0};
+    size_t evictionBucketsPerIteration_{8192};
+    std::string checkpointFile_;
+    int checkpointInterval_{0};
+    unsigned checkpointThreads_{0};
+    int lastCheckpointIteration_{0};
+    std::thread checkpointWriter_;              // Started by the first background checkpoint
+    std::mutex checkpointMutex_;
+    std::condition_variable checkpointCondition_;
+    std::unique_ptr<CheckpointSnapshot> pendingCheckpoint_;    // Guarded by checkpointMutex_
+    std::string pendingCheckpointFile_;
+    bool checkpointBusy_{false};                // Snapshot pending or being written
+    bool stopCheckpointWriter_{false};
+    std::atomic<bool> lastCheckpointOk_{true};
     ProgressCallback progressCallback_;
     mutable std::mutex statsMutex_;  // Add mutex for thread safety
 };
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "game/Action.hpp"
+
+namespace poker {
+
+class RegretTable;
+class StrategyTable;
+
+/**
+ * One chunk of table entries in the checkpoint's fixed-width layout:
+ *
+ *   ChunkPrefix  {numEntries, numSlots, valuesPerSlot, keyPoolBytes}
+ *   EntryRecord  [numEntries]   key offset/length and slot count (8 bytes)
+ *   SlotRecord   [numSlots]     action type/amount and value presence (16 bytes)
+ *   double       [numSlots * valuesPerSlot]
+ *   char         [keyPoolBytes] info-set keys, concatenated
+ *
+ * Entries own consecutive slots, so a reader walks records without parsing
+ * strings. Values are stored in host byte order.
+ */
+class CheckpointChunk {
+public:
+    struct EntryRecord {
+        uint32_t keyOffset;
+        uint16_t keyLength;
+        uint16_t numSlots;
+    };
+
+    struct SlotRecord {
+        double amount;
+        uint8_t type;           // ActionType
+        uint8_t present;        // Bit i set if value i is stored for this action
+        uint8_t padding[6];
+    };
+
+    explicit CheckpointChunk(uint32_t valuesPerSlot = 1);
+
+    // Start a new entry; following addSlot calls belong to it
+    void addEntry(const std::string& key);
+
+    // Add an action with valuesPerSlot values (absent ones are ignored)
+    void addSlot(const Action& action, const double* values, uint8_t present);
+
+    // Call fn(key, slots, values, numSlots) for every entry in order
+    template <typename Fn>
+    void forEachEntry(Fn fn) const {
+        size_t slot = 0;
+        for (const auto& entry : entries_) {
+            fn(keyPool_.substr(entry.keyOffset, entry.keyLength), &slots_[slot],
+               &values_[slot * valuesPerSlot_], static_cast<size_t>(entry.numSlots));
+            slot += entry.numSlots;
+        }
+    }
+
+    static Action slotAction(const SlotRecord& slot) {
+        return Action(static_cast<ActionType>(slot.type), slot.amount);
+    }
+
+    size_t numEntries() const { return entries_.size(); }
+    uint32_t valuesPerSlot() const { return valuesPerSlot_; }
+
+    // Serialize into out (replacing its contents)
+    void encode(std::vector<char>& out) const;
+
+    // Parse a serialized chunk; false if it is malformed
+    bool decode(const char* data, size_t size);
+
+private:
+    uint32_t valuesPerSlot_;
+    std::vector<EntryRecord> entries_;
+    std::vector<SlotRecord> slots_;
+    std::vector<double> values_;
+    std::string keyPool_;
+};
+
+// Solver identity and progress stored in the checkpoint header
+struct CheckpointMetadata {
+    uint32_t handAbstraction = 0;   // HandAbstraction::Level
+    uint32_t betAbstraction = 0;    // BetAbstraction::Level
+    uint64_t iteration = 0;         // Iterations completed
+    uint64_t seed = 0;              // Master training seed
+    uint64_t nodesVisited = 0;      // Training counters, restored on resume
+    double trainingMillis = 0.0;
+};
+
+/**
+ * Fully encoded checkpoint held in memory. Capturing is the only step that
+ * reads the tables; writing the snapshot to disk can then run on another
+ * thread while training continues.
+ */
+struct CheckpointSnapshot {
+    struct Chunk {
+        uint32_t table = 0;
+        uint32_t valuesPerSlot = 1;
+        uint64_t entries = 0;
+        uint64_t checksum = 0;
+        std::vector<char> bytes;
+    };
+
+    CheckpointMetadata metadata;
+    std::vector<Chunk> chunks;
+
+    size_t bytes() const {
+        size_t total = 0;
+        for (const auto& chunk : chunks) total += chunk.bytes.size();
+        return total;
+    }
+};
+
+/**
+ * Checkpoint reads and writes full solver state (regrets, current strategy and
+ * strategy sums) as a chunked binary file:
+ *
+ *   Header     magic, version, metadata, chunk count, directory offset, checksums
+ *   Chunks     CheckpointChunk payloads, in completion order
+ *   Directory  per chunk: table, offset, size, entry count, checksum
+ *
+ * Each table is split into chunks by bucket range; chunks are encoded and
+ * written by a pool of threads at offsets claimed with an atomic counter, and
+ * read, verified and decoded in parallel on load. Files are written to a
+ * temporary name and renamed into place once complete.
+ */
+class Checkpoint {
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    // Target entries per chunk (the chunk count is at least the thread count)
+    static constexpr size_t ENTRIES_PER_CHUNK = 1 << 16;
+
+    // Save both tables; numThreads 0 = hardware concurrency. Tables must not
+    // be modified while saving.
+    static bool save(const std::string& filename, const CheckpointMetadata& metadata,
+                     const RegretTable& regrets, const StrategyTable& strategies,
+                     unsigned numThreads = 0);
+
+    // Encode both tables into memory in parallel. Tables must not be modified
+    // while capturing.
+    static CheckpointSnapshot capture(const CheckpointMetadata& metadata,
+                                      const RegretTable& regrets, const StrategyTable& strategies,
+                                      unsigned numThreads = 0);
+
+    // Write a captured snapshot in the same file format as save()
+    static bool write(const std::string& filename, const CheckpointSnapshot& snapshot);
+
+    // Replace both tables with a checkpoint's contents. Fails (and leaves the
+    // tables cleared) if any chunk is missing or its checksum does not match.
+    static bool load(const std::string& filename, CheckpointMetadata& metadata,
+                     RegretTable& regrets, StrategyTable& strategies,
+                     unsigned numThreads = 0);
+
+    // Read and verify only the header
+    static bool readMetadata(const std::string& filename, CheckpointMetadata& metadata);
+
+    // 64-bit checksum for corruption detection (not cryptographic)
+    static uint64_t checksum(const void* data, size_t size);
+};
+
+} // namespace poker
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "game/Deck.hpp"
+#include "game/RangeShowdown.hpp"
+#include "abstraction/HandAbstraction.hpp"
+#include "utils/RingBuffer.hpp"
+#include "utils/Xoshiro.hpp"
+
+namespace poker {
+
+/**
+ * DealPipeline prepares the chance outcome of upcoming training iterations
+ * ahead of their traversal. Each entry holds the full deal, every player's
+ * hand bucket on all four streets, and the iteration's random stream as it
+ * stands after the deal was drawn, so the trainer carries on with exactly
+ * the draws it would have made dealing for itself.
+ *
+ * With a positive depth a producer thread keeps up to depth entries queued
+ * while earlier iterations are traversed; depth 0 prepares each entry on the
+ * calling thread. An UNBOUNDED count keeps the producer going until the
+ * pipeline is destroyed, so one pipeline can serve many train() calls.
+ *
+ * With ranges on, for range-vs-range (PUBLIC_TREE) training, each entry also
+ * ranks every combo that misses the board and buckets each combo on every
+ * street. Those are about 4.3k bucket lookups per entry, of which the
+ * postflop ones that are not already cached each run the abstraction's
+ * sampled equity; the producer does that work off the trainer's thread, and
+ * those boards are not added to the abstraction's cache.
+ */
+class DealPipeline {
+public:
+    // Hand bucket of each player on each street, [position][round]
+    using DealBuckets = std::array<std::array<int, 4>, NUM_PLAYERS>;
+    // Bucket of each combo of a board on each street, [round][combo]
+    using RangeBuckets = std::array<std::vector<int>, 4>;
+
+    struct PreparedDeal {
+        uint64_t iteration = 0;
+        DealOutcome deal;
+        DealBuckets buckets{};
+        Xoshiro256 stream;      // Iteration stream, advanced past the deal
+        // With ranges on: the deal's board ranked, and rangeBuckets indexed
+        // like showdown.hands()
+        RangeShowdown showdown;
+        RangeBuckets rangeBuckets;
+    };
+
+    static constexpr uint64_t UNBOUNDED = UINT64_MAX;
+
+    // Prepare iterations [firstIteration, firstIteration + count), drawing each
+    // from the stream Random::beginStream(iteration) gives under masterSeed
+    DealPipeline(std::shared_ptr<HandAbstraction> handAbstraction, uint64_t masterSeed,
+                 uint64_t firstIteration, uint64_t count, size_t depth, bool withRanges = false);
+    ~DealPipeline();
+
+    // Next iteration's entry, in order; blocks until it is ready. Rethrows a
+    // failure of the producer thread.
+    void next(PreparedDeal& prepared);
+
+    uint64_t getSeed() const { return masterSeed_; }
+    size_t getDepth() const { return depth_; }
+    bool hasRanges() const { return withRanges_; }
+    // Iteration the next call to next() returns
+    uint64_t nextIteration() const { return firstIteration_ + consumed_; }
+
+    // Bucket of every player on every street of deal
+    static DealBuckets computeBuckets(const HandAbstraction& handAbstraction, const DealOutcome& deal);
+
+    // Bucket of every combo of showdown on every street of deal's board.
+    // Hands already in the abstraction's cache (such as the dealt ones after
+    // computeBuckets) keep their cached bucket; other postflop boards are
+    // not cached.
+    static RangeBuckets computeRangeBuckets(const HandAbstraction& handAbstraction, const DealOutcome& deal,
+                                            const RangeShowdown& showdown);
+
+private:
+    void prepare(uint64_t iteration, PreparedDeal& prepared) const;
+    void produce();
+
+    // Wake the other side after a push or pop
+    void notify();
+
+    std::shared_ptr<HandAbstraction> handAbstraction_;
+    uint64_t masterSeed_;
+    uint64_t firstIteration_;
+    uint64_t count_;
+    size_t depth_;
+    bool withRanges_;
+    uint64_t consumed_{0};
+
+    std::unique_ptr<MpscRingBuffer<PreparedDeal>> queue_;
+    std::thread producer_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    std::atomic<bool> stopRequested_{false};
+    std::exception_ptr producerError_;      // Set under wakeMutex_
+
+    // Prevent copying
+    DealPipeline(const DealPipeline&) = delete;
+    DealPipeline& operator=(const DealPipeline&) = delete;
+};
+
+} // namespace poker
\ No newline at end of file
@@ -5,11 +5,15 @@
 #include <vector>
 #include <mutex>
 #include <shared_mutex>
+#include <atomic>
 
 #include "game/Action.hpp"
+#include "cfr/TableMemory.hpp"
 
 namespace poker {
 
+class CheckpointChunk;
+
 /**
  * RegretTable stores and manages regrets for information sets.
  * This is a key component of the CFR algorithm.
@@ -33,6 +37,10 @@ public:
     // Get all regrets for an information set
     std::unordered_map<Action, double, ActionHash> getRegrets(const std::string& infoSet) const;
     
+    // Copy regrets for the given actions into out[0..actions.size()) without
+    // copying the info set's map (missing entries read as 0)
+    void getRegrets(const std::string& infoSet, const std::vector<Action>& actions, double* out) const;
+    
     // Check if an information set exists in the table
     bool hasInfoSet(const std::string& infoSet) const;
     
@@ -50,15 +58,53 @@ public:
     
     // Get all info sets
     std::vector<std::string> getAllInfoSets() const;
+    
+    // Advance the access epoch (once per training iteration)
+    void advanceEpoch() { epoch_.fetch_add(1, std::memory_order_relaxed); }
+    
+    // Estimated live bytes of the table (entries, keys, nodes and bucket arrays)
+    size_t memoryBytes() const;
+    
+    // Full breakdown of the table's memory; walks every entry
+    TableFootprint footprint() const;
+    
+    // Footprint of one entry with the given key length and action count
+    static TableFootprint estimateEntry(size_t keyLength, size_t numActions);
+    
+    // Checkpoint support: append the entries in bucket range chunk/numChunks
+    // (chunks of one bucket count partition the table; do not modify the
+    // table between calls), insert a decoded chunk's entries, pre-size for load
+    void exportChunk(size_t chunk, size_t numChunks, CheckpointChunk& out) const;
+    void importChunk(const CheckpointChunk& chunk);
+    void reserve(size_t entries);
+    
+    // Incremental CLOCK eviction: scan at most maxBuckets buckets and erase
+    // entries not used since the hand last passed, until bytesToFree bytes are
+    // released. Returns bytes freed.
+    size_t evict(size_t bytesToFree, size_t maxBuckets);
 
 private:
     // Type definitions for nested maps
     using ActionRegretMap = std::unordered_map<Action, double, ActionHash>;
-    using InfoSetRegretMap = std::unordered_map<std::string, ActionRegretMap>;
+    
+    // One info set: regrets plus access metadata for eviction
+    struct Entry {
+        ActionRegretMap regrets;
+        EntryMetadata meta;
+    };
+    using InfoSetRegretMap = std::unordered_map<std::string, Entry>;
+    
+    // Estimated bytes of one entry
+    static size_t entryBytes(const std::string& infoSet, const Entry& entry);
     
     // Regrets data
     InfoSetRegretMap regrets_;
     
+    // Memory accounting and eviction state
+    std::atomic<size_t> entryBytes_{0};     // Sum of entryBytes over all entries
+    std::atomic<uint32_t> epoch_{0};
+    size_t clockHand_ = 0;                  // Guarded by the write lock
+    
     // Thread safety
     mutable std::shared_mutex mutex_;
 };
@@ -5,11 +5,15 @@
 #include <vector>
 #include <mutex>
 #include <shared_mutex>
+#include <atomic>
 
 #include "game/Action.hpp"
+#include "cfr/TableMemory.hpp"
 
 namespace poker {
 
+class CheckpointChunk;
+
 /**
  * StrategyTable stores and manages strategy probabilities for information sets.
  * It maintains both current strategy and strategy sum for average strategy calculation.
@@ -42,6 +46,11 @@ public:
     // Get all average strategy probabilities for an information set
     std::unordered_map<Action, double, ActionHash> getAverageStrategies(const std::string& infoSet) const;
     
+    // Average strategy for the given actions into out[0..actions.size()), renormalized
+    // over those actions; uniform if the info set has no strategy mass.
+    // Returns false if the info set has never been visited.
+    bool getAverageStrategy(const std::string& infoSet, const std::vector<Action>& actions, double* out) const;
+    
     // Check if an information set exists in the table
     bool hasInfoSet(const std::string& infoSet) const;
     
@@ -57,15 +66,60 @@ public:
     
     // Get all info sets
     std::vector<std::string> getAllInfoSets() const;
+    
+    // Advance the access epoch (once per training iteration)
+    void advanceEpoch() { epoch_.fetch_add(1, std::memory_order_relaxed); }
+    
+    // Estimated live bytes of the table (entries, keys, nodes and bucket arrays)
+    size_t memoryBytes() const;
+    
+    // Full breakdown of the table's memory; walks every entry. Outer nodes and
+    // keys are shared by both parts and are counted under current.
+    struct Footprint {
+        TableFootprint current;
+        TableFootprint sum;
+    };
+    Footprint footprint() const;
+    
+    // Footprint of one entry with the given key length and action count
+    // (current strategy and strategy sum combined)
+    static TableFootprint estimateEntry(size_t keyLength, size_t numActions);
+    
+    // Checkpoint support, see RegretTable. Slots carry two values: current
+    // strategy (bit 0) and strategy sum (bit 1).
+    void exportChunk(size_t chunk, size_t numChunks, CheckpointChunk& out) const;
+    void importChunk(const CheckpointChunk& chunk);
+    void reserve(size_t entries);
+    
+    // Incremental CLOCK eviction, see RegretTable::evict. Returns bytes freed.
+    size_t evict(size_t bytesToFree, size_t maxBuckets);
 
 private:
     // Type definitions for nested maps
     using ActionStrategyMap = std::unordered_map<Action, double, ActionHash>;
-    using InfoSetStrategyMap = std::unordered_map<std::string, ActionStrategyMap>;
+    
+    // One info set: current strategy and strategy sum share a key and metadata
+    struct Entry {
+        ActionStrategyMap current;
+        ActionStrategyMap sum;
+        EntryMetadata meta;
+    };
+    using InfoSetStrategyMap = std::unordered_map<std::string, Entry>;
+    
+    // Estimated bytes of one entry
+    static size_t entryBytes(const std::string& infoSet, const Entry& entry);
+    
+    // Add to one of the entry's maps and account for its growth
+    template <typename Update>
+    void updateEntry(const std::string& infoSet, Update update);
     
     // Data members
-    InfoSetStrategyMap currentStrategy_;
-    InfoSetStrategyMap strategySum_;
+    InfoSetStrategyMap strategies_;
+    
+    // Memory accounting and eviction state
+    std::atomic<size_t> entryBytes_{0};     // Sum of entryBytes over all entries
+    std::atomic<uint32_t> epoch_{0};
+    size_t clockHand_ = 0;                  // Guarded by the write lock
     
     // Thread safety
     mutable std::shared_mutex mutex_;
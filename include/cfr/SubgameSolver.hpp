@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "game/GameState.hpp"
+#include "cfr/StrategyTable.hpp"
+#include "abstraction/HandAbstraction.hpp"
+#include "abstraction/BetAbstraction.hpp"
+#include "utils/Xoshiro.hpp"
+
+namespace poker {
+
+/**
+ * SubgameSolver refines the blueprint for one decision at play time.
+ *
+ * Beliefs: opponent hands and runouts are sampled around the known cards and
+ * weighted by the probability that the blueprint takes the observed actions
+ * with each hand. Off-tree bet sizes are matched to the nearest blueprint
+ * action.
+ *
+ * Subgame: the rest of the current street (plus lookaheadRounds more) is
+ * built with the subgame's own, usually finer, bet abstraction. Depth-limit
+ * leaves are valued by rolling the blueprint out from them.
+ *
+ * Solving: chance-sampled CFR+ with linear averaging runs until the time
+ * budget or iteration cap is reached. The average strategy of the acting
+ * player's real hand at the root is returned. The blueprint is only read.
+ *
+ * Setup gets at most half the time budget: past it, sampling stops with the
+ * deals drawn so far (at least MIN_DEALS) and every further decision of the
+ * subgame becomes a blueprint leaf. One iteration always runs, so a budget
+ * smaller than setup plus that iteration is overrun by that much.
+ */
+class SubgameSolver {
+public:
+    struct Options {
+        double timeBudgetMs = 50.0;     // Wall clock for the whole solve, setup included (see above)
+        int maxIterations = 100000;
+        int lookaheadRounds = 0;        // Streets solved after the current one before blueprint leaves
+        int numDeals = 256;             // Sampled opponent hands and runouts
+        int rolloutsPerLeaf = 4;        // Blueprint rollouts averaged per leaf and deal
+        size_t maxNodes = 20000;        // Decisions past the cap become blueprint leaves
+        uint64_t seed = 0;
+    };
+
+    struct Result {
+        std::vector<Action> actions;        // Subgame actions at the root
+        std::vector<double> probabilities;  // Aligned with actions
+        int iterations = 0;
+        int deals = 0;                      // Deals sampled (fewer than numDeals if setup ran short)
+        size_t nodes = 0;
+        size_t leaves = 0;                  // Depth-limit leaves (blueprint values)
+        double elapsedMs = 0.0;
+    };
+
+    // The blueprint must outlive the solver; invalid_argument on bad options
+    SubgameSolver(const StrategyTable& blueprint,
+                  std::shared_ptr<HandAbstraction> handAbstraction,
+                  std::shared_ptr<BetAbstraction> blueprintBets,
+                  std::shared_ptr<BetAbstraction> subgameBets);
+    SubgameSolver(const StrategyTable& blueprint,
+                  std::shared_ptr<HandAbstraction> handAbstraction,
+                  std::shared_ptr<BetAbstraction> blueprintBets,
+                  std::shared_ptr<BetAbstraction> subgameBets,
+                  Options options);
+
+    // Re-solve the decision of state's current player. Only that player's hole
+    // cards and the revealed board are read from state's deal.
+    Result solve(const GameState& state);
+
+    const Options& getOptions() const { return options_; }
+
+    // Upper bound on actions at one decision (sizes stack buffers)
+    static constexpr size_t MAX_ACTIONS = 16;
+
+    // Deals sampled before the setup deadline can cut sampling short
+    static constexpr int MIN_DEALS = 8;
+
+private:
+    enum class NodeKind : uint8_t { DECISION, TERMINAL, LEAF };
+
+    using Values = std::array<double, NUM_PLAYERS>;
+    using DealBuckets = std::array<std::array<int, 4>, NUM_PLAYERS>;
+
+    struct InfoSet {
+        std::vector<double> regrets;
+        std::vector<double> strategySum;
+    };
+
+    struct Node {
+        NodeKind kind = NodeKind::DECISION;
+        Position player = Position::SB;
+        size_t round = 0;                       // Index into DealBuckets
+        std::vector<Action> actions;
+        std::vector<size_t> children;
+        std::unordered_map<int, InfoSet> infoSets;      // By the acting player's bucket
+
+        // Terminal and leaf nodes: the state, its blueprint-translated
+        // history and values per deal (computed on first use)
+        std::unique_ptr<GameState> state;
+        ActionHistory history;
+        std::vector<Values> values;
+        std::vector<uint8_t> valueReady;
+    };
+
+    // Deals around the known cards, their buckets and belief weights
+    void sampleBeliefs(const GameState& state);
+
+    // Append the subtree rooted at state; returns its node index
+    size_t buildTree(std::unique_ptr<GameState> state, const ActionHistory& history, int roundsLeft);
+    size_t addValueNode(NodeKind kind, std::unique_ptr<GameState> state, const ActionHistory& history);
+
+    // One CFR+ pass over the tree for one deal
+    Values traverse(size_t nodeIndex, size_t deal, const Values& reach, double weight);
+
+    const Values& nodeValues(size_t nodeIndex, size_t deal);
+    Values rollout(const Node& leaf, size_t deal, Xoshiro256& rng) const;
+
+    // Blueprint abstraction's actions at a state
+    std::vector<Action> blueprintActions(const GameState& state) const;
+
+    // Blueprint average strategy over actions. Stored actions are matched to
+    // the nearest action of the same type, so a pot that drifted off the
+    // blueprint tree still finds its info set's strategy; uniform if unknown.
+    void blueprintPolicy(Position position, BettingRound round, int bucket, const std::string& history,
+                         const std::vector<Action>& actions, double* out) const;
+
+    // Index of the same-type action with the closest amount (actions.size() if none)
+    static size_t nearestAction(const std::vector<Action>& actions, const Action& action);
+
+    const StrategyTable& blueprint_;
+    std::shared_ptr<HandAbstraction> handAbstraction_;
+    std::shared_ptr<BetAbstraction> blueprintBets_;
+    std::shared_ptr<BetAbstraction> subgameBets_;
+    Options options_;
+
+    // Per-solve state
+    std::chrono::steady_clock::time_point setupDeadline_;
+    std::vector<DealOutcome> deals_;
+    std::vector<DealBuckets> dealBuckets_;
+    std::vector<double> beliefWeights_;
+    ActionHistory rootHistory_;
+    std::vector<Node> nodes_;
+    size_t numLeaves_ = 0;
+};
+
+} // namespace poker
\ No newline at end of file
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/MemoryFootprint.hpp"
+
+namespace poker {
+
+/**
+ * Access metadata kept with every info-set entry of the regret and strategy
+ * tables. Fields are atomics so readers holding only a shared lock can mark an
+ * entry as used; they are copied with relaxed loads.
+ */
+struct EntryMetadata {
+    mutable std::atomic<uint32_t> lastVisit{0};     // Table epoch of the last access
+    mutable std::atomic<uint32_t> visits{0};        // Number of updates
+    mutable std::atomic<bool> referenced{true};     // CLOCK reference bit
+
+    EntryMetadata() = default;
+    EntryMetadata(const EntryMetadata& other) { *this = other; }
+    EntryMetadata& operator=(const EntryMetadata& other) {
+        lastVisit.store(other.lastVisit.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        visits.store(other.visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        referenced.store(other.referenced.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    // Mark as used in this epoch (only writes when something changes)
+    void touch(uint32_t epoch) const {
+        if (lastVisit.load(std::memory_order_relaxed) != epoch) {
+            lastVisit.store(epoch, std::memory_order_relaxed);
+        }
+        if (!referenced.load(std::memory_order_relaxed)) {
+            referenced.store(true, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * Byte accounting and eviction shared by RegretTable and StrategyTable.
+ * Sizes are estimates of live heap bytes for libstdc++'s node-based
+ * unordered_map: one node per element (value + next pointer + cached hash)
+ * plus the bucket array; allocator headers are not included.
+ */
+namespace TableMemory {
+
+constexpr size_t NODE_OVERHEAD = sizeof(void*) + sizeof(size_t);
+constexpr size_t SSO_CAPACITY = 15;
+
+// Heap bytes owned by a string beyond the object itself
+inline size_t stringHeapBytes(const std::string& str) {
+    return str.capacity() > SSO_CAPACITY ? str.capacity() + 1 : 0;
+}
+
+// Bucket array of an unordered container (a single bucket is stored inline)
+template <typename Map>
+size_t bucketArrayBytes(const Map& map) {
+    return map.bucket_count() > 1 ? map.bucket_count() * sizeof(void*) : 0;
+}
+
+// Nodes plus bucket array of a flat action -> value map
+template <typename Map>
+size_t actionMapBytes(const Map& map) {
+    return map.size() * (sizeof(typename Map::value_type) + NODE_OVERHEAD) + bucketArrayBytes(map);
+}
+
+// Outer node and key of one info-set entry (excluding the entry's own maps)
+template <typename Map>
+size_t entryNodeBytes(const std::string& key) {
+    return sizeof(typename Map::value_type) + NODE_OVERHEAD + stringHeapBytes(key);
+}
+
+// Add a table's bucket array to a footprint
+template <typename Map>
+void addBucketArray(TableFootprint& footprint, const Map& map) {
+    size_t bytes = bucketArrayBytes(map);
+    if (bytes > 0) {
+        footprint.bucketBytes += bytes;
+        footprint.addAllocation(bytes);
+    }
+}
+
+// Add one info-set entry's outer node and key to a footprint
+template <typename Map>
+void addEntryNode(TableFootprint& footprint, const std::string& key) {
+    size_t nodeBytes = sizeof(typename Map::value_type) + NODE_OVERHEAD;
+    footprint.entries++;
+    footprint.nodeBytes += nodeBytes;
+    footprint.addAllocation(nodeBytes);
+
+    size_t keyBytes = stringHeapBytes(key);
+    if (keyBytes > 0) {
+        footprint.keyBytes += keyBytes;
+        footprint.addAllocation(keyBytes);
+    }
+}
+
+// Add a per-entry action map (nodes and bucket array) to a footprint
+template <typename Map>
+void addActionMap(TableFootprint& footprint, const Map& map) {
+    size_t nodeBytes = sizeof(typename Map::value_type) + NODE_OVERHEAD;
+    footprint.actions += map.size();
+    footprint.nodeBytes += map.size() * nodeBytes;
+    footprint.addAllocation(nodeBytes, map.size());
+    addBucketArray(footprint, map);
+}
+
+/**
+ * Incremental CLOCK (second-chance) sweep. Starting at bucket `hand`, visits
+ * at most maxBuckets buckets; a referenced entry has its bit cleared and is
+ * skipped, an unreferenced one is erased. Stops once bytesToFree bytes are
+ * released. The hand is a bucket index, so it stays valid across rehashes.
+ * Returns the bytes freed; evicted receives the number of entries erased.
+ */
+template <typename Map, typename EntryBytes>
+size_t clockEvict(Map& table, size_t& hand, size_t bytesToFree, size_t maxBuckets,
+                  EntryBytes entryBytes, size_t& evicted) {
+    evicted = 0;
+    size_t bucketCount = table.bucket_count();
+    if (table.empty() || bucketCount == 0) {
+        return 0;
+    }
+
+    size_t freed = 0;
+    std::vector<std::string> victims;
+
+    for (size_t scanned = 0; scanned < maxBuckets && freed < bytesToFree; ++scanned) {
+        size_t bucket = hand % bucketCount;
+        hand = (bucket + 1) % bucketCount;
+
+        victims.clear();
+        for (auto it = table.begin(bucket); it != table.end(bucket); ++it) {
+            if (it->second.meta.referenced.exchange(false, std::memory_order_relaxed)) {
+                continue;   // Second chance
+            }
+            victims.push_back(it->first);
+            freed += entryBytes(it->first, it->second);
+            if (freed >= bytesToFree) {
+                break;
+            }
+        }
+
+        // Erasing does not rehash, so bucketCount stays valid
+        for (const auto& key : victims) {
+            table.erase(key);
+        }
+        evicted += victims.size();
+    }
+
+    return freed;
+}
+
+} // namespace TableMemory
+
+} // namespace poker
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "game/PokerDefs.hpp"
+#include "utils/Xoshiro.hpp"
+#include <pokerstove/peval/CardSet.h>
+
+namespace poker {
+
+// Cards are indexed 0..51 with the same encoding as pokerstove::Card::code(),
+// so a CardMask bit index is directly usable as a pokerstove::CardSet mask.
+using CardMask = uint64_t;
+
+constexpr int DECK_SIZE = 52;
+constexpr int HOLE_CARDS_PER_PLAYER = 2;
+constexpr int BOARD_SIZE = 5;
+constexpr CardMask FULL_DECK_MASK = (CardMask(1) << DECK_SIZE) - 1;
+
+inline CardMask cardBit(uint8_t card) { return CardMask(1) << card; }
+
+/**
+ * DealOutcome is every chance outcome of one hand, drawn up front: both hole
+ * cards for each player and the full board. Streets only reveal a prefix of
+ * the board, so a GameState carries these 11 bytes instead of a deck.
+ */
+struct DealOutcome {
+    std::array<std::array<uint8_t, HOLE_CARDS_PER_PLAYER>, NUM_PLAYERS> holeCards{};
+    std::array<uint8_t, BOARD_SIZE> board{};
+
+    // Hole cards of one player as a mask
+    CardMask holeMask(Position position) const {
+        const auto& cards = holeCards[static_cast<size_t>(position)];
+        return cardBit(cards[0]) | cardBit(cards[1]);
+    }
+
+    // First numCards board cards as a mask (3 = flop, 4 = turn, 5 = river)
+    CardMask boardMask(int numCards) const {
+        CardMask mask = 0;
+        for (int i = 0; i < numCards && i < BOARD_SIZE; ++i) {
+            mask |= cardBit(board[i]);
+        }
+        return mask;
+    }
+
+    bool operator==(const DealOutcome& other) const {
+        return holeCards == other.holeCards && board == other.board;
+    }
+};
+
+/**
+ * Deck is a 64-bit mask of the cards still available. Drawing uses a partial
+ * Fisher-Yates shuffle over the remaining cards, so a deal only costs as many
+ * random draws as cards dealt and never allocates.
+ */
+class Deck {
+public:
+    // Constructors
+    Deck() = default;
+    explicit Deck(CardMask deadCards) : remaining_(FULL_DECK_MASK & ~deadCards) {}
+
+    // Put every card back
+    void reset() { remaining_ = FULL_DECK_MASK; }
+
+    // Remove known cards (e.g. hole cards and board in a re-solve)
+    void remove(CardMask cards) { remaining_ &= ~cards; }
+
+    // Cards still in the deck
+    CardMask remaining() const { return remaining_; }
+    int size() const { return __builtin_popcountll(remaining_); }
+
+    // Draw count distinct cards into out and remove them from the deck
+    void draw(uint8_t* out, int count, Xoshiro256& rng);
+
+    // Draw all hole cards and the full board for one hand in one shot
+    DealOutcome drawOutcome(Xoshiro256& rng);
+
+    // Conversions to pokerstove types
+    static pokerstove::CardSet toCardSet(CardMask mask) { return pokerstove::CardSet(mask); }
+
+private:
+    CardMask remaining_ = FULL_DECK_MASK;
+};
+
+} // namespace poker
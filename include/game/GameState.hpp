@@ -4,13 +4,12 @@
 #include <string>
 #include <array>
 #include <memory>
-#include <random>
 #include <unordered_map>
 
 #include <game/PokerDefs.hpp>
 #include <game/Action.hpp>
+#include <game/Deck.hpp>
 #include <pokerstove/peval/CardSet.h>
-#include <pokerstove/penum/SimpleDeck.hpp>
 
 namespace poker {
 
@@ -39,22 +38,32 @@ public:
     
 /*
 This resets the game state including player chips, hole cards, deck, and action.
+All chance outcomes for the hand (hole cards and full board) are drawn here.
 */
     void reset();
 /*
+Same as reset() but with a predetermined chance outcome instead of a fresh draw.
+*/
+    void reset(const DealOutcome& deal);
+/*
+Swaps in a different chance outcome without touching the betting state. Hole cards and
+the board cards revealed so far are replaced; used to evaluate one line of play across many deals.
+*/
+    void setDeal(const DealOutcome& deal);
+/*
 Deals the 2 Hole cards to each player.
 */    
     void dealHoleCards();
 /*
-Puts 3 cards in the community cardset and removes them from the deck
+Reveals the 3 pre-drawn flop cards into the community cardset
 */
     void dealFlop();
 /*
-Puts 1 card in the community set and removes it from the deck
+Reveals the pre-drawn turn card into the community set
 */
     void dealTurn();
 /*
-Puts 1 card in the community set and removes it from the deck
+Reveals the pre-drawn river card into the community set
 */
     void dealRiver();
 /*
@@ -92,6 +101,9 @@ Starts the next betting round after all actions are done
     // Community cards access
     const pokerstove::CardSet& getCommunityCards() const { return communityCards_; }
     
+    // Chance outcome for this hand (including board cards not revealed yet)
+    const DealOutcome& getDeal() const { return deal_; }
+    
     // Action history
     const ActionHistory& getActionHistory() const { return actionHistory_; }
     
@@ -108,11 +120,17 @@ private:
     // Betting
     void applyBlinds();
     double getHighestBet() const;
+
+    // True if no more betting is possible before showdown (at most one active
+    // player has chips and owes nothing) and the runout can be scored without
+    // dealing: from every flop/turn runout, or preflop from the loaded
+    // PreflopEquityTable. Fills equities (by position) unless null.
+    bool allInEquities(std::array<double, NUM_PLAYERS>* equities) const;
     
     // State variables
     std::array<PlayerState, NUM_PLAYERS> players_;
     pokerstove::CardSet communityCards_;
-    pokerstove::SimpleDeck deck_;
+    DealOutcome deal_;
     
     Position currentPosition_ = Position::BTN;
     Position lastAggressor_ = Position::SB;
@@ -121,9 +139,6 @@ private:
     double pot_ = 0.0;
     ActionHistory actionHistory_;
     
-    // Random number generator
-    std::mt19937 rng_;
-    
     // Hand evaluator
     pokerstove::HoldemHandEvaluator handEvaluator;
 };
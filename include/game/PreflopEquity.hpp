@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "game/Deck.hpp"
+
+namespace poker {
+
+/**
+ * PreflopEquityTable holds the all-in equity of every heads-up and 3-way
+ * preflop matchup, so a hand that is all-in before the flop is scored by one
+ * lookup instead of one sampled board.
+ *
+ * Matchups are stored once per suit-isomorphism class: the canonical form
+ * of a set of hands is the smallest key over all 24 suit relabelings, with
+ * the hands sorted. That leaves about 47k heads-up and 12.7M 3-way entries.
+ * The file (written by preflop_equity_builder) is a sorted key array and a
+ * parallel equity array, memory-mapped read-only and binary-searched.
+ *
+ * Load it once at startup, before training threads start; lookups are const
+ * and may run concurrently.
+ */
+class PreflopEquityTable {
+public:
+    static constexpr int MAX_HANDS = 3;
+
+    // Singleton access
+    static PreflopEquityTable& getInstance();
+
+    ~PreflopEquityTable();
+
+    // Map a table file; false (logged) on failure
+    bool load(const std::string& filename);
+    void unload();
+    bool isLoaded() const { return data_ != nullptr; }
+
+    // Pot share of each of numHands (2 or 3) disjoint hole-card masks over
+    // all boards. False if the table is not loaded or lacks the matchup.
+    bool lookup(const CardMask* hands, int numHands, double* equities) const;
+
+    size_t size() const { return numEntries_; }
+
+    // Boards each equity was computed from (0 = every board)
+    uint32_t headsUpBoards() const { return headsUpBoards_; }
+    uint32_t threeWayBoards() const { return threeWayBoards_; }
+
+    // Canonical key of a matchup. slots[i] receives the position of hands[i]
+    // in the canonical order (the order of a record's equities).
+    static uint64_t canonicalKey(const CardMask* hands, int numHands, int* slots);
+
+    // Key of numHands hand indices (0..1325, each pair's high card index
+    // * (high - 1) / 2 + low), given in descending order
+    static uint64_t packKey(const uint32_t* handIndices, int numHands);
+
+    // Hands of a canonical key in canonical order; returns their count
+    static int handsOfKey(uint64_t key, CardMask* hands);
+
+    // Pot share of each hand, over every board (numBoards 0) or numBoards
+    // boards sampled from a generator seeded with seed
+    static void computeEquities(const CardMask* hands, int numHands, uint32_t numBoards, uint64_t seed,
+                                double* equities);
+
+    struct Record {
+        float equity[MAX_HANDS];        // By canonical slot; unused slots are 0
+    };
+
+    // Write a table; keys must be sorted and unique, records parallel to them
+    static bool write(const std::string& filename, const std::vector<uint64_t>& keys,
+                      const std::vector<Record>& records, uint32_t headsUpBoards, uint32_t threeWayBoards);
+
+private:
+    PreflopEquityTable() = default;
+
+    // Prevent copying
+    PreflopEquityTable(const PreflopEquityTable&) = delete;
+    PreflopEquityTable& operator=(const PreflopEquityTable&) = delete;
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    const uint64_t* keys_ = nullptr;
+    const Record* records_ = nullptr;
+    size_t numEntries_ = 0;
+    uint32_t headsUpBoards_ = 0;
+    uint32_t threeWayBoards_ = 0;
+};
+
+} // namespace poker
\ No newline at end of file
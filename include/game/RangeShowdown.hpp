@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "game/Deck.hpp"
+
+namespace poker {
+
+/**
+ * RangeShowdown values every hole-card combo at once against opponent ranges
+ * on one complete board, for range-vs-range traversals and best responses.
+ *
+ * setBoard lists the combos that miss the board (1081 of 1326), evaluates
+ * each one and sorts them by strength once. A showdown is then one sweep in
+ * that order: the opponents' reach below the current strength, at it and
+ * above it is kept as a total and per card. Opponent holdings that collide
+ * with the combo or with each other are removed by inclusion-exclusion over
+ * those per-card sums, so each combo costs one pass over the live cards
+ * instead of a pass over every opponent pair.
+ */
+class RangeShowdown {
+public:
+    static constexpr int MAX_OPPONENTS = NUM_PLAYERS - 1;
+    static_assert(MAX_OPPONENTS == 2, "Range showdowns are written for three players");
+
+    // List and rank the combos that miss board (5 cards)
+    void setBoard(CardMask board);
+
+    CardMask board() const { return board_; }
+    size_t size() const { return hands_.size(); }
+    const std::vector<CardMask>& hands() const { return hands_; }
+    const std::vector<int>& strengths() const { return strengths_; }
+
+    // Value every combo against both opponents' ranges (indexed like hands()),
+    // counting only holdings where no two hands share a card.
+    // masses[i]: reach-weighted count of those opponent holdings.
+    // shares[i]: the part of masses[i] combo i wins, ties split evenly, against
+    // the opponents with contending set (folded opponents still block cards).
+    void evaluate(const double* const* opponentReach, const bool* contending, double* shares,
+                  double* masses) const;
+
+private:
+    CardMask board_ = 0;
+    std::vector<CardMask> hands_;
+    std::vector<int> strengths_;
+    std::vector<uint16_t> handIndex_;       // Pair index of each combo (0..1325)
+    std::vector<std::array<uint8_t, 2>> cards_;
+    std::vector<int> strengthByIndex_;      // By pair index; board collisions never match
+    std::vector<uint8_t> liveCards_;        // Cards not on the board
+    std::vector<uint32_t> order_;           // Indices into hands_, weakest first
+    std::vector<uint32_t> groupEnds_;       // End of each run of equal strength in order_
+};
+
+} // namespace poker
\ No newline at end of file
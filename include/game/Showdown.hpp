@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#include "game/Deck.hpp"
+
+namespace poker {
+
+/**
+ * Showdown scores hole-card sets against boards: the pot share (equity) of
+ * each hand, with ties split evenly. It settles all-in states, where no
+ * more betting is possible, by scoring every runout of the missing board
+ * cards rather than one sampled runout.
+ *
+ * Boards are scored in fixed-size blocks. Each hand's strengths go into one
+ * array per hand, and the winner and split passes then run branch-free over
+ * those arrays.
+ */
+class Showdown {
+public:
+    static constexpr int MAX_HANDS = NUM_PLAYERS;
+
+    // 7-card strength of hole cards plus a full board; higher is better
+    static int handStrength(CardMask cards);
+
+    // Add each hand's pot share on every board to totals (numHands 1..3)
+    static void scoreBoards(const CardMask* hands, int numHands, const CardMask* boards, size_t numBoards,
+                            double* totals);
+
+    // Equity of each hand over every completion of board (0 to 5 cards known)
+    static void enumerateEquities(const CardMask* hands, int numHands, CardMask board, double* equities);
+
+    // enumerateEquities behind a small per-thread cache; one traversal reaches
+    // the same deal at many all-in terminals
+    static void cachedEquities(const CardMask* hands, int numHands, CardMask board, double* equities);
+
+    // Boards scored per block
+    static constexpr size_t BLOCK_SIZE = 256;
+
+    // Per-thread cache entries
+    static constexpr size_t CACHE_SLOTS = 64;
+};
+
+} // namespace poker
\ No newline at end of file
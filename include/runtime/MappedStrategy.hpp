@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "game/Action.hpp"
+#include "cfr/StrategyTable.hpp"
+
+namespace poker {
+
+/**
+ * MappedStrategy is a read-only average strategy queried in place from a
+ * memory-mapped file. Nothing is parsed or copied on open, so processes on one
+ * host share the file's page cache and start immediately.
+ *
+ * File layout (host byte order, every section 8-byte aligned):
+ *
+ *   Header          magic, version, encoding, counts, section offsets, checksums
+ *   Index           uint32 [2^indexBits + 1]   first entry of each hash bucket
+ *   EntryRecord     [numEntries]               sorted by (key hash, key)
+ *   ActionSetRecord [numActionSets]            distinct action lists
+ *   ActionRecord    [numActions]               the lists' actions, consecutive
+ *   Values          per entry: presence bitmap, then one value per set bit
+ *   char            [keyBytes]                 info-set keys, concatenated
+ *
+ * Entries share action lists (most decisions offer the same few), so an entry
+ * costs its record, its key and its values. Values are stored as float or as
+ * 16/8-bit fixed point; zero probabilities are left out via the bitmap.
+ *
+ * A lookup hashes the key, takes the top indexBits bits as the bucket and
+ * compares hashes over that bucket's entries (about one on average), checking
+ * the key only on a hash match.
+ *
+ * open() checksums the body and bounds-checks every record once, so lookups
+ * can follow the records' offsets unchecked; a corrupt file is rejected.
+ */
+class MappedStrategy {
+public:
+    static constexpr uint32_t VERSION = 3;
+
+    // Storage of the probabilities
+    enum class Encoding : uint32_t {
+        FLOAT32,        // Full single precision
+        Q16,            // Fixed point in 1/65535 steps
+        Q8              // Fixed point in 1/255 steps
+    };
+    static std::string encodingToString(Encoding encoding);
+    static bool encodingFromString(const std::string& str, Encoding& encoding);
+
+    struct EntryRecord {
+        uint64_t hash;
+        uint32_t keyOffset;
+        uint32_t valueOffset;   // Byte offset of the bitmap in the value section
+        uint32_t actionSet;
+        uint16_t keyLength;
+        uint16_t numActions;
+    };
+
+    struct ActionSetRecord {
+        uint32_t firstAction;
+        uint32_t numActions;
+    };
+
+    struct ActionRecord {
+        double amount;
+        uint8_t type;           // ActionType
+        uint8_t padding[7];
+    };
+
+    MappedStrategy() = default;
+    ~MappedStrategy();
+
+    MappedStrategy(const MappedStrategy&) = delete;
+    MappedStrategy& operator=(const MappedStrategy&) = delete;
+    MappedStrategy(MappedStrategy&& other) noexcept;
+    MappedStrategy& operator=(MappedStrategy&& other) noexcept;
+
+    // Map and validate a file written by write(); false (logged) if the
+    // header, the body checksum or any record's ranges are bad
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    // Number of info sets
+    size_t size() const { return numEntries_; }
+
+    // Size of the mapping
+    size_t mappedBytes() const { return size_; }
+
+    // Fault every page of the mapping in, so the first lookups after a
+    // reload do not pay for page faults and disk reads
+    void prefault() const;
+
+    // Entry for an info set, or nullptr
+    const EntryRecord* find(const std::string& infoSet) const;
+
+    // Lookup with a precomputed hashKey(key, length)
+    const EntryRecord* find(const char* key, size_t length, uint64_t hash) const;
+
+    // Start loading the cache lines a lookup of hash will touch: the index
+    // slot, or with the index already cached, the bucket's first entry. Batch
+    // callers prefetch every query before resolving any.
+    void prefetchIndex(uint64_t hash) const;
+    void prefetchEntry(uint64_t hash) const;
+
+    Encoding encoding() const { return encoding_; }
+
+    // Actions of an entry, entry.numActions long
+    const ActionRecord* actions(const EntryRecord& entry) const {
+        return actions_ + actionSets_[entry.actionSet].firstAction;
+    }
+
+    // Decode an entry's probabilities into out[0..entry.numActions), aligned with actions(entry)
+    void probabilities(const EntryRecord& entry, double* out) const;
+
+    std::string key(const EntryRecord& entry) const { return std::string(keys_ + entry.keyOffset, entry.keyLength); }
+
+    // Same contract as StrategyTable::getAverageStrategy: probabilities for the
+    // given actions into out, renormalized over them, uniform without mass.
+    // Returns false if the info set is not in the file.
+    bool getAverageStrategy(const std::string& infoSet, const std::vector<Action>& actions, double* out) const;
+
+    // Same for an entry from find() (nullptr gives uniform)
+    void getAverageStrategy(const EntryRecord* entry, const Action* actions, size_t numActions, double* out) const;
+
+    // All stored actions of an info set (empty if absent)
+    std::unordered_map<Action, double, StrategyTable::ActionHash> getAverageStrategies(const std::string& infoSet) const;
+
+    // Export the normalized average strategy of every visited info set.
+    // Fixed-point encodings round so an entry's values still sum to one;
+    // probabilities much smaller than a step can round to zero.
+    static bool write(const std::string& filename, const StrategyTable& strategies,
+                      Encoding encoding = Encoding::FLOAT32);
+
+    // Stable 64-bit key hash used by the file's index
+    static uint64_t hashKey(const char* data, size_t length);
+
+    static Action recordAction(const ActionRecord& record) {
+        return Action(static_cast<ActionType>(record.type), record.amount);
+    }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t numEntries_ = 0;
+    uint32_t indexBits_ = 0;
+    Encoding encoding_ = Encoding::FLOAT32;
+    const uint32_t* index_ = nullptr;
+    const EntryRecord* entries_ = nullptr;
+    const ActionSetRecord* actionSets_ = nullptr;
+    const ActionRecord* actions_ = nullptr;
+    const char* values_ = nullptr;
+    const char* keys_ = nullptr;
+};
+
+} // namespace poker
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "game/Action.hpp"
+#include "runtime/MappedStrategy.hpp"
+#include "runtime/StrategyQueryEngine.hpp"
+
+namespace poker {
+
+/**
+ * Binary protocol of the strategy server. Every message is a FrameHeader
+ * followed by bodyBytes of payload, in host byte order (both ends run on the
+ * same host).
+ *
+ * Request body, per decision:
+ *   DecisionRecord                          cards, position, counts (24 bytes)
+ *   MappedStrategy::ActionRecord [numActions]
+ *   char [historyLength]                    rendered history, padded to 8 bytes
+ *
+ * Response body:
+ *   uint8_t [numDecisions]                  1 if the info set was found, padded to 4 bytes
+ *   float   [total actions]                 probabilities, packed in request order
+ *
+ * One request carries a batch of decisions and is answered with one
+ * response; a connection has at most one request in flight.
+ */
+class StrategyProtocol {
+public:
+    static constexpr uint32_t REQUEST_MAGIC = 0x51524B50;   // "PKRQ"
+    static constexpr uint32_t RESPONSE_MAGIC = 0x53524B50;  // "PKRS"
+    static constexpr uint16_t VERSION = 1;
+
+    // Limits a server enforces before allocating anything
+    static constexpr uint32_t MAX_DECISIONS = 4096;
+    static constexpr uint64_t MAX_BODY_BYTES = 16 << 20;
+
+    enum class Status : uint16_t {
+        OK,
+        BAD_REQUEST,        // Malformed body; the connection is closed after the reply
+        SERVER_ERROR        // The query failed; the connection is closed after the reply
+    };
+
+    struct FrameHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t status;        // Status (responses only)
+        uint32_t numDecisions;
+        uint32_t requestId;     // Echoed in the response
+        uint64_t bodyBytes;
+    };
+
+    struct DecisionRecord {
+        uint64_t holeCards;
+        uint64_t board;
+        uint8_t position;
+        uint8_t numActions;
+        uint16_t historyLength;
+        uint32_t reserved;
+    };
+
+    // A decoded request; decisions point into actions and histories
+    struct Request {
+        uint32_t requestId = 0;
+        std::vector<StrategyQueryEngine::Decision> decisions;
+        std::vector<Action> actions;
+        std::vector<std::string> histories;
+    };
+
+    // A decoded response
+    struct Response {
+        uint32_t requestId = 0;
+        Status status = Status::OK;
+        std::vector<uint8_t> found;
+        std::vector<float> probabilities;
+    };
+
+    // Frame builders (out is replaced). Requests need 1-255 actions and a
+    // history under 64KB per decision (invalid_argument otherwise).
+    static void encodeRequest(uint32_t requestId, const StrategyQueryEngine::Decision* decisions, size_t count,
+                              std::vector<char>& out);
+    static void encodeResponse(uint32_t requestId, Status status, const bool* found, size_t numDecisions,
+                               const double* probabilities, size_t numProbabilities, std::vector<char>& out);
+
+    // Body parsers; false if the body does not match the header. Requests are
+    // also rejected unless every decision has 2 hole cards and a 0, 3, 4 or
+    // 5 card board, all distinct cards of the deck.
+    static bool decodeRequest(const FrameHeader& header, const std::vector<char>& body, Request& request);
+    static bool decodeResponse(const FrameHeader& header, const std::vector<char>& body, Response& response);
+
+    // Blocking socket I/O. readFrame fails on EOF, I/O error, a wrong magic or
+    // version, or a body over MAX_BODY_BYTES.
+    static bool readFrame(int fd, uint32_t expectedMagic, FrameHeader& header, std::vector<char>& body);
+    static bool writeAll(int fd, const void* data, size_t size);
+};
+
+} // namespace poker
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "game/Action.hpp"
+#include "game/Deck.hpp"
+#include "game/PokerDefs.hpp"
+#include "abstraction/HandAbstraction.hpp"
+#include "runtime/MappedStrategy.hpp"
+#include "utils/RcuPointer.hpp"
+
+namespace poker {
+
+/**
+ * StrategyQueryEngine answers play-time decisions from a mapped average
+ * strategy. Callers describe a decision by position, cards and betting
+ * history; the engine buckets the hand, builds the same info-set key as
+ * training and writes probabilities into a caller-provided buffer, so a query
+ * allocates only the key. The history is passed rendered, so it can be kept
+ * across decisions or sent by a remote client as plain bytes.
+ *
+ * Batch queries resolve many decisions (one per table in a multi-table bot)
+ * in three passes: build every key and prefetch its index slot, prefetch the
+ * first entry of every bucket, then resolve and decode. The memory stalls of
+ * a batch overlap instead of being paid one query at a time.
+ *
+ * Queries are const and may run concurrently. The strategy can be replaced
+ * while queries run (setStrategy, reload): each query or batch pins the
+ * version it started with, and a replaced version is unmapped once the last
+ * query using it has finished.
+ */
+class StrategyQueryEngine {
+public:
+    struct Decision {
+        Position position;
+        CardMask holeCards;
+        CardMask board;                 // 0, 3, 4 or 5 cards
+        const std::string* history;     // ActionHistory::toString() of the actions so far
+        const Action* actions;          // Abstracted actions to score
+        size_t numActions;
+    };
+
+    // Decisions resolved together; larger batches are split into windows of
+    // this size so prefetched lines are still cached when they are used
+    static constexpr size_t BATCH_WINDOW = 32;
+
+    StrategyQueryEngine(std::shared_ptr<const MappedStrategy> strategy,
+                        std::shared_ptr<HandAbstraction> handAbstraction);
+
+    // Probabilities for decision.actions into out[0..numActions). Returns false
+    // (and a uniform strategy) if the info set is not in the strategy.
+    bool query(const Decision& decision, double* out) const;
+
+    // Query count decisions. Results are packed: decision i writes numActions
+    // values after those of decisions 0..i-1. found, if given, receives one
+    // flag per decision. Returns the number of decisions found.
+    size_t queryBatch(const Decision* decisions, size_t count, double* out, bool* found = nullptr) const;
+
+    // Info-set key of a decision, as built during training
+    std::string infoSetKey(const Decision& decision) const { return infoSetKey(*handAbstraction_, decision); }
+    static std::string infoSetKey(const HandAbstraction& handAbstraction, const Decision& decision);
+
+    // Betting round implied by the number of board cards
+    static BettingRound roundForBoard(CardMask board);
+
+    // Publish a new strategy without pausing queries. Returns once no query
+    // can still see the previous one; throws invalid_argument if not open.
+    void setStrategy(std::shared_ptr<const MappedStrategy> strategy);
+
+    // Map and prefault a strategy file, then publish it. Runs on the calling
+    // thread, so call it off the query threads. On failure (logged) the
+    // current strategy stays in place.
+    bool reload(const std::string& filename);
+
+    std::shared_ptr<const MappedStrategy> getStrategy() const { return strategy_.load(); }
+
+    // Number of strategies published since construction
+    uint64_t getGeneration() const { return strategy_.generation(); }
+
+private:
+    RcuPointer<const MappedStrategy> strategy_;
+    std::shared_ptr<HandAbstraction> handAbstraction_;
+};
+
+} // namespace poker
\ No newline at end of file
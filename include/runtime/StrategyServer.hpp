@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "runtime/StrategyQueryEngine.hpp"
+
+namespace poker {
+
+/**
+ * StrategyServer answers StrategyProtocol requests on a Unix domain socket,
+ * so every bot process on a host shares one mapped strategy.
+ *
+ * One poll thread accepts connections and watches idle ones. A readable
+ * connection is handed to the worker pool; the worker reads one request,
+ * answers its whole batch with StrategyQueryEngine::queryBatch, writes the
+ * response and hands the connection back to the poll thread. A connection
+ * therefore has at most one request in flight, and workers never block on
+ * a client that has nothing to send.
+ */
+class StrategyServer {
+public:
+    // numThreads 0 = hardware concurrency
+    explicit StrategyServer(std::shared_ptr<StrategyQueryEngine> engine, unsigned numThreads = 0);
+    ~StrategyServer();
+
+    StrategyServer(const StrategyServer&) = delete;
+    StrategyServer& operator=(const StrategyServer&) = delete;
+
+    // Bind socketPath (replacing a stale socket file) and start serving; false
+    // (logged) if the socket cannot be set up
+    bool start(const std::string& socketPath);
+
+    // Stop accepting, finish in-flight requests and close every connection
+    void stop();
+
+    bool isRunning() const { return running_.load(); }
+
+    struct Stats {
+        uint64_t connections = 0;   // Accepted so far
+        uint64_t requests = 0;
+        uint64_t decisions = 0;
+        uint64_t errors = 0;        // Malformed requests and failed writes
+    };
+    Stats getStats() const;
+
+    // A client that sends nothing for this long while a worker waits on it is dropped
+    static constexpr int RECEIVE_TIMEOUT_MS = 5000;
+
+private:
+    void pollLoop();
+    void workerLoop();
+
+    // Serve one request; false if the connection should be closed
+    bool serveRequest(int fd);
+
+    // Give a connection back to the poll thread (-1 only wakes it). Waits while
+    // the wake pipe is full; closes the connection if it cannot be handed back.
+    void returnConnection(int fd);
+
+    std::shared_ptr<StrategyQueryEngine> engine_;
+    unsigned numThreads_;
+    std::string socketPath_;
+
+    int listenFd_ = -1;
+    int wakePipe_[2] = {-1, -1};
+    std::atomic<bool> running_{false};
+
+    std::thread pollThread_;
+    std::vector<std::thread> workers_;
+
+    // Connections with a request waiting
+    std::mutex queueMutex_;
+    std::condition_variable queueReady_;
+    std::deque<int> readyConnections_;
+
+    std::atomic<uint64_t> connections_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> decisions_{0};
+    std::atomic<uint64_t> errors_{0};
+};
+
+} // namespace poker
\ No newline at end of file
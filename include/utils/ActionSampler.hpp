@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "utils/Xoshiro.hpp"
+
+namespace poker {
+
+/**
+ * Sampling over a contiguous array of action probabilities, indexed the same
+ * way as the action list they were computed for. Nothing here allocates on
+ * the sampling path.
+ */
+
+// Pick an index with one uniform draw and a linear prefix scan. The weights
+// do not have to be normalized if their total is passed in. Entries with zero
+// weight are never returned; if every weight is zero the choice is uniform.
+inline size_t sampleIndex(const double* weights, size_t count, double uniform, double total = 1.0) {
+    if (count == 0) {
+        return 0;
+    }
+
+    if (total <= 0.0) {
+        size_t index = static_cast<size_t>(uniform * static_cast<double>(count));
+        return index < count ? index : count - 1;
+    }
+
+    double target = uniform * total;
+    double cumulative = 0.0;
+    size_t lastPositive = 0;
+    bool foundPositive = false;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (weights[i] <= 0.0) {
+            continue;
+        }
+        cumulative += weights[i];
+        lastPositive = i;
+        foundPositive = true;
+        if (target < cumulative) {
+            return i;
+        }
+    }
+
+    // Rounding left the target past the end, or every weight was zero
+    if (!foundPositive) {
+        size_t index = static_cast<size_t>(uniform * static_cast<double>(count));
+        return index < count ? index : count - 1;
+    }
+    return lastPositive;
+}
+
+/**
+ * AliasTable samples a fixed distribution in O(1) with one draw (Vose's
+ * method). Building costs O(n), so it pays off for strategies that are frozen
+ * and sampled many times, e.g. the average strategy at play time.
+ */
+class AliasTable {
+public:
+    AliasTable() = default;
+    AliasTable(const double* weights, size_t count) { build(weights, count); }
+
+    // (Re)build the table from non-negative weights
+    void build(const double* weights, size_t count) {
+        probability_.assign(count, 0.0);
+        alias_.assign(count, 0);
+        if (count == 0) {
+            return;
+        }
+
+        double total = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            total += weights[i] > 0.0 ? weights[i] : 0.0;
+        }
+
+        // Scaled weights: average bucket height is 1
+        std::vector<double> scaled(count);
+        std::vector<uint32_t> small;
+        std::vector<uint32_t> large;
+        small.reserve(count);
+        large.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            double weight = weights[i] > 0.0 ? weights[i] : 0.0;
+            scaled[i] = total > 0.0 ? weight * static_cast<double>(count) / total : 1.0;
+            (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+        }
+
+        while (!small.empty() && !large.empty()) {
+            uint32_t less = small.back();
+            small.pop_back();
+            uint32_t more = large.back();
+
+            probability_[less] = scaled[less];
+            alias_[less] = more;
+
+            scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+            if (scaled[more] < 1.0) {
+                large.pop_back();
+                small.push_back(more);
+            }
+        }
+
+        // Leftovers are full buckets (up to rounding)
+        for (uint32_t index : large) {
+            probability_[index] = 1.0;
+            alias_[index] = index;
+        }
+        for (uint32_t index : small) {
+            probability_[index] = 1.0;
+            alias_[index] = index;
+        }
+    }
+
+    // Sample an index with a single 64-bit draw
+    size_t sample(Xoshiro256& generator) const {
+        uint64_t bits = generator();
+        // High 32 bits choose the bucket, low 32 bits the coin
+        size_t bucket = static_cast<size_t>(((bits >> 32) * static_cast<uint64_t>(alias_.size())) >> 32);
+        double coin = static_cast<double>(bits & 0xFFFFFFFFULL) * 0x1.0p-32;
+        return coin < probability_[bucket] ? bucket : alias_[bucket];
+    }
+
+    size_t size() const { return alias_.size(); }
+    bool empty() const { return alias_.empty(); }
+
+private:
+    std::vector<double> probability_;
+    std::vector<uint32_t> alias_;
+};
+
+} // namespace poker
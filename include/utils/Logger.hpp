@@ -9,6 +9,11 @@
 #include <sstream>
 #include <chrono>
 #include <iomanip>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+
+#include "utils/RingBuffer.hpp"
 
 namespace poker {
 
@@ -50,6 +55,11 @@ public:
     // Generic log method
     void log(Level level, const std::string& message);
     
+    // Cheap lock-free check used by the logging macros before building a message
+    bool isEnabled(Level level) const {
+        return level >= minLevel_.load(std::memory_order_relaxed);
+    }
+    
     // Set minimum log level
     void setLevel(Level level);
     
@@ -62,6 +72,25 @@ public:
     // Convert log level to string
     static std::string levelToString(Level level);
     
+    // Switch to asynchronous mode: log() only enqueues into a bounded lock-free
+    // ring buffer and a background thread batches the writes. When the buffer
+    // is full, messages below WARNING are dropped (and counted) instead of
+    // blocking the caller.
+    void startAsync(size_t queueCapacity = 16384,
+                    std::chrono::milliseconds flushInterval = std::chrono::milliseconds(250));
+    
+    // Drain the queue, stop the background thread and return to synchronous mode
+    void stopAsync();
+    
+    // Block until everything logged so far has been written and flushed
+    void flush();
+    
+    // Check if the asynchronous backend is running
+    bool isAsync() const { return async_.load(std::memory_order_acquire); }
+    
+    // Number of messages dropped because the async queue was full
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    
     // Destructor
     ~Logger();
 
@@ -69,30 +98,83 @@ private:
     // Private constructor for singleton
     Logger();
     
-    // Timestamp formatting
-    std::string getTimestamp() const;
+    // Queued message for the asynchronous backend
+    struct LogRecord {
+        Level level = Level::INFO;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+    };
+    
+    // Timestamp formatting (appends "YYYY-mm-dd HH:MM:SS.mmm")
+    void appendTimestamp(std::string& out, std::chrono::system_clock::time_point time) const;
     
     // Format log message
-    std::string formatLogMessage(Level level, const std::string& message) const;
+    std::string formatLogMessage(Level level, const std::string& message,
+                                 std::chrono::system_clock::time_point time) const;
+    
+    // Enqueue a message for the background writer
+    void enqueue(Level level, const std::string& message);
+    
+    // Background writer loop
+    void asyncWriterLoop();
+    
+    // Write a batch of formatted lines (caller holds mutex_)
+    void writeBatch(const std::string& consoleOut, const std::string& consoleErr,
+                    const std::string& fileOut);
     
     // Data members
-    Level minLevel_ = Level::INFO;
+    std::atomic<Level> minLevel_{Level::INFO};
     Destination destination_ = Destination::CONSOLE;
     std::string filename_;
     std::ofstream logFile_;
     std::mutex mutex_;
     
+    // Asynchronous backend state
+    std::atomic<bool> async_{false};
+    std::atomic<bool> stopRequested_{false};
+    std::unique_ptr<MpscRingBuffer<LogRecord>> queue_;
+    std::thread writerThread_;
+    std::chrono::milliseconds flushInterval_{250};
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    
     // Prevent copying
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 };
 
+// Compile-time logging floor: 0 = DEBUG, 1 = INFO, 2 = WARNING, 3 = ERROR, 4 = FATAL.
+// Statements below this level fold to a constant-false branch that the compiler
+// drops, and their arguments are never evaluated. Set through the POKER_STRIP_DEBUG_LOGS CMake option.
+#ifndef POKER_LOG_COMPILED_LEVEL
+#define POKER_LOG_COMPILED_LEVEL 0
+#endif
+
+// True when a statement at the given level would be written. Use it to guard
+// expensive message construction that does not fit in a single macro argument.
+#define LOG_LEVEL_ENABLED(level) \
+    (static_cast<int>(level) >= POKER_LOG_COMPILED_LEVEL && \
+     poker::Logger::getInstance().isEnabled(level))
+
+#define LOG_DEBUG_ENABLED() LOG_LEVEL_ENABLED(poker::Logger::Level::DEBUG)
+
+// The message expression is only evaluated when the level is enabled
+#define POKER_LOG_AT(level, message) \
+    do { \
+        if (LOG_LEVEL_ENABLED(level)) { \
+            poker::Logger::getInstance().log(level, message); \
+        } \
+    } while (0)
+
 // Convenience macros for logging
-#define LOG_DEBUG(message) poker::Logger::getInstance().debug(message)
-#define LOG_INFO(message) poker::Logger::getInstance().info(message)
-#define LOG_WARNING(message) poker::Logger::getInstance().warning(message)
-#define LOG_ERROR(message) poker::Logger::getInstance().error(message)
-#define LOG_FATAL(message) poker::Logger::getInstance().fatal(message)
+#define LOG_DEBUG(message) POKER_LOG_AT(poker::Logger::Level::DEBUG, message)
+#define LOG_INFO(message) POKER_LOG_AT(poker::Logger::Level::INFO, message)
+#define LOG_WARNING(message) POKER_LOG_AT(poker::Logger::Level::WARNING, message)
+#define LOG_ERROR(message) POKER_LOG_AT(poker::Logger::Level::ERROR, message)
+#define LOG_FATAL(message) POKER_LOG_AT(poker::Logger::Level::FATAL, message)
 
 // Stream-style log wrapper
 class LogStream {
@@ -111,11 +193,14 @@ private:
     std::ostringstream stream_;
 };
 
-// Stream logging macros
-#define DEBUG_LOG poker::LogStream(poker::Logger::Level::DEBUG)
-#define INFO_LOG poker::LogStream(poker::Logger::Level::INFO)
-#define WARNING_LOG poker::LogStream(poker::Logger::Level::WARNING)
-#define ERROR_LOG poker::LogStream(poker::Logger::Level::ERROR)
-#define FATAL_LOG poker::LogStream(poker::Logger::Level::FATAL)
+// Stream logging macros (the stream and its operands are skipped when disabled)
+#define POKER_LOG_STREAM(level) \
+    if (!LOG_LEVEL_ENABLED(level)) {} else poker::LogStream(level)
+
+#define DEBUG_LOG POKER_LOG_STREAM(poker::Logger::Level::DEBUG)
+#define INFO_LOG POKER_LOG_STREAM(poker::Logger::Level::INFO)
+#define WARNING_LOG POKER_LOG_STREAM(poker::Logger::Level::WARNING)
+#define ERROR_LOG POKER_LOG_STREAM(poker::Logger::Level::ERROR)
+#define FATAL_LOG POKER_LOG_STREAM(poker::Logger::Level::FATAL)
 
 } // namespace poker
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+/**
+ * Memory breakdown of one hash table. Byte counts are estimates for
+ * libstdc++ node-based containers on a 64-bit glibc system: live bytes are
+ * what the elements, keys and bucket arrays request; allocator overhead is the
+ * malloc chunk header and size-class rounding on top of each request.
+ */
+struct TableFootprint {
+    std::string name;
+    size_t entries = 0;             // Outer elements (info sets, cached hands)
+    size_t actions = 0;             // Elements of per-entry action maps (0 for flat tables)
+    size_t nodeBytes = 0;           // Hash nodes: element + next pointer + cached hash
+    size_t keyBytes = 0;            // Heap storage owned by keys (long strings, card vectors)
+    size_t bucketBytes = 0;         // Bucket arrays
+    size_t allocations = 0;         // Heap blocks behind the above
+    size_t allocatorOverhead = 0;   // malloc headers and rounding across those blocks
+
+    // Bytes requested by the table
+    size_t liveBytes() const { return nodeBytes + keyBytes + bucketBytes; }
+
+    // Bytes actually taken from the heap
+    size_t totalBytes() const { return liveBytes() + allocatorOverhead; }
+
+    double avgActionsPerEntry() const {
+        return entries > 0 ? static_cast<double>(actions) / entries : 0.0;
+    }
+
+    // Record count heap blocks of the given requested size
+    void addAllocation(size_t bytes, size_t count = 1);
+
+    // Merge another footprint's counts into this one (keeps this name)
+    TableFootprint& operator+=(const TableFootprint& other);
+
+    // One-line human-readable summary
+    std::string toString() const;
+};
+
+// Malloc overhead for one request: glibc rounds size + 8-byte header up to a
+// multiple of 16 with a 32-byte minimum
+inline size_t mallocOverhead(size_t bytes) {
+    size_t chunk = (bytes + sizeof(size_t) + 15) & ~static_cast<size_t>(15);
+    return (chunk < 32 ? 32 : chunk) - bytes;
+}
+
+// Human-readable byte count (B, KB, MB, GB)
+std::string formatBytes(size_t bytes);
+
+// Table of footprints with a total row
+std::string formatFootprints(const std::vector<TableFootprint>& footprints);
+
+} // namespace poker
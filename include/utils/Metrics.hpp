@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+// Hot-path event counters
+enum class Counter : uint8_t {
+    NODES_VISITED,      // Game-tree nodes entered by a traversal
+    TERMINAL_EVALS,     // Terminal payoff evaluations
+    BUCKET_LOOKUPS,     // HandAbstraction::getBucket calls
+    BUCKET_MISSES,      // getBucket calls that had to compute the bucket
+    KEYS_BUILT,         // Info-set key strings built
+    REGRET_READS,       // RegretTable lookups
+    REGRET_WRITES,      // RegretTable updates
+    STRATEGY_READS,     // StrategyTable lookups
+    STRATEGY_WRITES,    // StrategyTable updates
+    STATE_CLONES,       // GameState copies made for recursion
+    EVICTIONS,          // Info sets evicted to stay under the memory budget
+    ALLIN_EVALS,        // All-in terminals scored over every runout
+    ALLIN_CACHE_HITS,   // All-in runout enumerations served from the cache
+    DEAL_STALLS,        // Iterations that waited for the deal pipeline
+    COUNT
+};
+
+// Timed phases. TRAVERSAL is inclusive of the fine-grained phases below it.
+enum class Phase : uint8_t {
+    DEAL,               // Reset and deal at the start of an iteration
+    TRAVERSAL,          // One cfr()/monteCarloSample() call from the root
+    PRUNE,              // Periodic table cleanup
+    CALLBACK,           // Progress callback
+    CHECKPOINT,         // Capturing a periodic checkpoint (the write runs in the background)
+    BUCKET,             // Hand bucket lookups (detailed timing only)
+    TERMINAL,           // Terminal payoff evaluation (detailed timing only)
+    COUNT
+};
+
+constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::COUNT);
+constexpr size_t PHASE_COUNT = static_cast<size_t>(Phase::COUNT);
+
+std::string counterToString(Counter counter);
+std::string phaseToString(Phase phase);
+
+/**
+ * Log-linear latency histogram: each power of two is split into 8 sub-buckets,
+ * so recorded values are accurate to ~12%. Recording is a couple of shifts and
+ * one relaxed atomic update.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int NUM_BINS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static int binIndex(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<int>(value);
+        }
+        int exponent = 63 - __builtin_clzll(value);
+        int sub = static_cast<int>((value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    // Smallest value that lands in a bin
+    static uint64_t binLowerBound(int index) {
+        if (index < SUB_BUCKETS) {
+            return static_cast<uint64_t>(index);
+        }
+        int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+        uint64_t sub = static_cast<uint64_t>(index % SUB_BUCKETS);
+        return (uint64_t(1) << exponent) | (sub << (exponent - SUB_BUCKET_BITS));
+    }
+};
+
+// Aggregated view over every thread
+struct MetricsSnapshot {
+    std::array<uint64_t, COUNTER_COUNT> counters{};
+    std::array<uint64_t, PHASE_COUNT> phaseNanos{};
+
+    // Iteration latency (microseconds)
+    uint64_t iterationsRecorded = 0;
+    double iterationP50Us = 0.0;
+    double iterationP90Us = 0.0;
+    double iterationP99Us = 0.0;
+    double iterationMaxUs = 0.0;
+
+    uint64_t get(Counter counter) const { return counters[static_cast<size_t>(counter)]; }
+    double phaseMillis(Phase phase) const { return phaseNanos[static_cast<size_t>(phase)] / 1e6; }
+
+    std::string toJson() const;
+};
+
+/**
+ * Metrics collects per-thread counters, phase times and iteration latencies.
+ * Each thread writes only to its own block (relaxed load + store, no
+ * read-modify-write), and blocks are summed when a snapshot is taken. When a
+ * thread exits its counts are folded into a retired total and its block is
+ * reused by the next new thread, so the number of blocks is bounded by the
+ * peak number of live threads.
+ */
+class Metrics {
+public:
+    // Singleton access
+    static Metrics& getInstance();
+
+    // Hot-path recording (calling thread's block)
+    static void increment(Counter counter, uint64_t amount = 1) {
+        bump(threadBlock().counters[static_cast<size_t>(counter)], amount);
+    }
+    static void addPhaseTime(Phase phase, uint64_t nanos) {
+        bump(threadBlock().phaseNanos[static_cast<size_t>(phase)], nanos);
+    }
+    static void recordIterationLatency(uint64_t nanos);
+
+    // Fine-grained phases (BUCKET, TERMINAL) add two clock reads per call,
+    // so they are only timed when detailed timing is on
+    void setDetailedTiming(bool enabled) { detailedTiming_.store(enabled, std::memory_order_relaxed); }
+    bool isTimed(Phase phase) const {
+        return (phase != Phase::BUCKET && phase != Phase::TERMINAL) ||
+               detailedTiming_.load(std::memory_order_relaxed);
+    }
+
+    // Sum over all threads (including threads that have exited)
+    MetricsSnapshot snapshot() const;
+
+    // Zero every block; meant to be called between runs
+    void reset();
+
+    // Write snapshot().toJson() to a file
+    bool writeJson(const std::string& filename) const;
+
+    // Blocks allocated so far
+    size_t getBlockCount() const;
+
+private:
+    Metrics() = default;
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    struct ThreadBlock {
+        std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters{};
+        std::array<std::atomic<uint64_t>, PHASE_COUNT> phaseNanos{};
+        std::array<std::atomic<uint64_t>, LatencyHistogram::NUM_BINS> latencyBins{};
+        std::atomic<uint64_t> latencyMax{0};
+    };
+
+    // Single writer per block, so a plain load + store is enough
+    static void bump(std::atomic<uint64_t>& value, uint64_t amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    // Holds the calling thread's block and hands it back when the thread exits
+    struct BlockLease {
+        ThreadBlock* block;
+        BlockLease() : block(getInstance().acquireBlock()) {}
+        ~BlockLease() { getInstance().releaseBlock(block); }
+    };
+
+    // Calling thread's block, acquired on first use
+    static ThreadBlock& threadBlock() {
+        thread_local BlockLease lease;
+        return *lease.block;
+    }
+    ThreadBlock* acquireBlock();
+    void releaseBlock(ThreadBlock* block);
+
+    mutable std::mutex registryMutex_;
+    std::vector<std::unique_ptr<ThreadBlock>> blocks_;
+    std::vector<ThreadBlock*> freeBlocks_;      // Zeroed blocks of exited threads
+    ThreadBlock retired_;                       // Counts of exited threads
+    std::atomic<bool> detailedTiming_{false};
+};
+
+/**
+ * ScopedPhase adds the time spent in its scope to a phase of the calling thread.
+ */
+class ScopedPhase {
+public:
+    explicit ScopedPhase(Phase phase)
+        : phase_(phase), active_(Metrics::getInstance().isTimed(phase)) {
+        if (active_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedPhase() {
+        if (active_) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            Metrics::addPhaseTime(phase_, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+    Phase phase_;
+    bool active_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace poker
\ No newline at end of file
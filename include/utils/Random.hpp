@@ -5,24 +5,36 @@
 #include <vector>
 #include <algorithm>
 #include <unordered_map>
-#include <mutex>
+#include <atomic>
 #include "game/Action.hpp"
 #include "game/PokerDefs.hpp"
 #include "cfr/RegretTable.hpp"
 #include "cfr/StrategyTable.hpp"
+#include "utils/Xoshiro.hpp"
+#include "utils/ActionSampler.hpp"
 
 namespace poker {
 
 /**
- * Random provides thread-safe random number generation utilities.
+ * Random provides random number generation utilities. Every thread draws from
+ * its own Xoshiro256 stream, so there is no lock on the sampling path. Streams
+ * are derived from a process-wide master seed; calling beginStream() at the
+ * start of each unit of work (e.g. a CFR iteration) makes the draws depend
+ * only on (seed, iteration, thread) and keeps runs bit-for-bit reproducible.
  */
 class Random {
 public:
     // Get singleton instance
     static Random& getInstance();
     
-    // Seed the random number generator
-    void seed(unsigned int seed);
+    // Set the master seed and restart the calling thread's stream from it
+    void seed(uint64_t seed);
+    
+    // Get the master seed
+    uint64_t getSeed() const { return masterSeed_.load(std::memory_order_relaxed); }
+    
+    // Reset the calling thread's generator to the stream for (iteration, thread)
+    void beginStream(uint64_t iteration, uint64_t threadIndex = 0);
     
     // Get a random integer in range [min, max]
     int getInt(int min, int max);
@@ -45,6 +57,11 @@ public:
     template <typename T>
     T sample(const std::unordered_map<T, double>& distribution);
     
+    // Sample an index from a contiguous probability array (allocation-free)
+    size_t sampleIndex(const double* weights, size_t count, double total = 1.0) {
+        return poker::sampleIndex(weights, count, threadGenerator().nextDouble(), total);
+    }
+    
     // Sample from vector of weights
     template <typename T>
     T sample(const std::vector<T>& elements, const std::vector<double>& weights);
@@ -53,8 +70,8 @@ public:
     template <typename T>
     T sampleUniform(const std::vector<T>& elements);
     
-    // Get underlying generator (use with caution, not thread-safe)
-    std::mt19937& getGenerator();
+    // Get the calling thread's generator
+    Xoshiro256& getGenerator() { return threadGenerator(); }
     
     // Destructor
     ~Random() = default;
@@ -63,9 +80,12 @@ private:
     // Private constructor for singleton
     Random();
     
+    // Per-thread generator, lazily seeded from the master seed
+    static Xoshiro256& threadGenerator();
+    
     // Data members
-    std::mt19937 generator_;
-    std::mutex mutex_;
+    std::atomic<uint64_t> masterSeed_;
+    std::atomic<uint64_t> nextThreadIndex_{0};
     
     // Prevent copying
     Random(const Random&) = delete;
@@ -76,8 +96,7 @@ private:
 
 template <typename T>
 void Random::shuffle(std::vector<T>& vec) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::shuffle(vec.begin(), vec.end(), generator_);
+    std::shuffle(vec.begin(), vec.end(), threadGenerator());
 }
 
 template <typename T>
@@ -86,8 +105,6 @@ T Random::sample(const std::unordered_map<T, double>& distribution) {
         throw std::invalid_argument("Cannot sample from empty distribution");
     }
     
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     // Convert map to vectors
     std::vector<T> elements;
     std::vector<double> weights;
@@ -104,7 +121,7 @@ T Random::sample(const std::unordered_map<T, double>& distribution) {
     std::discrete_distribution<size_t> disc_dist(weights.begin(), weights.end());
     
     // Sample and return
-    size_t index = disc_dist(generator_);
+    size_t index = disc_dist(threadGenerator());
     return elements[index];
 }
 
@@ -114,13 +131,11 @@ T Random::sample(const std::vector<T>& elements, const std::vector<double>& weig
         throw std::invalid_argument("Elements and weights must have same non-zero size");
     }
     
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     // Create discrete distribution
     std::discrete_distribution<size_t> disc_dist(weights.begin(), weights.end());
     
     // Sample and return
-    size_t index = disc_dist(generator_);
+    size_t index = disc_dist(threadGenerator());
     return elements[index];
 }
 
@@ -130,13 +145,11 @@ T Random::sampleUniform(const std::vector<T>& elements) {
         throw std::invalid_argument("Cannot sample from empty vector");
     }
     
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     // Uniform distribution over indices
     std::uniform_int_distribution<size_t> uniform_dist(0, elements.size() - 1);
     
     // Sample and return
-    size_t index = uniform_dist(generator_);
+    size_t index = uniform_dist(threadGenerator());
     return elements[index];
 }
 
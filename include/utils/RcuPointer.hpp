@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace poker {
+
+/**
+ * RcuPointer publishes a shared object to many readers and swaps it without
+ * blocking them. Readers pin the current value with a ReadGuard: two atomic
+ * loads and one increment of a per-thread counter slot, with no lock and no
+ * shared reference count. A writer publishes a new value with one atomic
+ * exchange, then waits until every reader that may still hold the old value
+ * has left, and only then drops its reference.
+ *
+ * Reader counters are split by epoch parity. Publishing flips the epoch;
+ * readers that entered before the flip are counted under the old parity, so
+ * once those counters reach zero nobody can still see the old value.
+ *
+ * A thread must not publish while it holds a ReadGuard on the same pointer.
+ */
+template <typename T>
+class RcuPointer {
+public:
+    explicit RcuPointer(std::shared_ptr<T> initial = nullptr);
+    ~RcuPointer() { delete current_.load(); }
+
+    class ReadGuard {
+    public:
+        ~ReadGuard() { release(); }
+        ReadGuard(ReadGuard&& other) noexcept : counter_(other.counter_), value_(other.value_) {
+            other.counter_ = nullptr;
+        }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        T* get() const { return value_; }
+        T& operator*() const { return *value_; }
+        T* operator->() const { return value_; }
+        explicit operator bool() const { return value_ != nullptr; }
+
+    private:
+        friend class RcuPointer;
+        ReadGuard(std::atomic<int64_t>* counter, T* value) : counter_(counter), value_(value) {}
+
+        void release() {
+            if (counter_) counter_->fetch_sub(1, std::memory_order_release);
+            counter_ = nullptr;
+        }
+
+        std::atomic<int64_t>* counter_;
+        T* value_;
+    };
+
+    // Pin the current value for the guard's lifetime
+    ReadGuard read() const;
+
+    // Publish next and wait for readers of the previous value to drain. The
+    // previous value is returned, so the last reference is released (and the
+    // object destroyed) by the caller, outside every reader.
+    std::shared_ptr<T> exchange(std::shared_ptr<T> next);
+
+    // Owning reference to the current value
+    std::shared_ptr<T> load() const;
+
+    // Number of values published after the initial one
+    uint64_t generation() const { return epoch_.load(std::memory_order_acquire); }
+
+    // Reader counter slots; threads are spread over them round-robin
+    static constexpr size_t READER_SLOTS = 64;
+
+private:
+    static size_t threadSlot();
+
+    struct alignas(64) ReaderSlot {
+        std::array<std::atomic<int64_t>, 2> readers{};     // By epoch parity
+    };
+
+    // Readers see a plain pointer; the node keeps the shared_ptr alive
+    struct Node {
+        std::shared_ptr<T> value;
+    };
+
+    std::atomic<Node*> current_;
+    std::atomic<uint64_t> epoch_{0};
+    std::unique_ptr<ReaderSlot[]> slots_;
+    mutable std::mutex writeMutex_;
+
+    // Prevent copying
+    RcuPointer(const RcuPointer&) = delete;
+    RcuPointer& operator=(const RcuPointer&) = delete;
+};
+
+// Template implementations
+
+template <typename T>
+RcuPointer<T>::RcuPointer(std::shared_ptr<T> initial)
+    : current_(new Node{std::move(initial)}), slots_(new ReaderSlot[READER_SLOTS]) {}
+
+template <typename T>
+size_t RcuPointer<T>::threadSlot() {
+    static std::atomic<size_t> nextSlot{0};
+    thread_local size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+    return slot;
+}
+
+template <typename T>
+typename RcuPointer<T>::ReadGuard RcuPointer<T>::read() const {
+    ReaderSlot& slot = slots_[threadSlot()];
+    for (;;) {
+        uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+        std::atomic<int64_t>& counter = slot.readers[epoch & 1];
+        counter.fetch_add(1, std::memory_order_seq_cst);
+
+        // A flip between the load and the increment would leave this reader
+        // under a parity the writer is no longer waiting on; retry
+        if (epoch_.load(std::memory_order_seq_cst) == epoch) {
+            Node* node = current_.load(std::memory_order_seq_cst);
+            return ReadGuard(&counter, node->value.get());
+        }
+        counter.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+std::shared_ptr<T> RcuPointer<T>::exchange(std::shared_ptr<T> next) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    Node* previous = current_.exchange(new Node{std::move(next)}, std::memory_order_seq_cst);
+
+    // Readers that entered before the flip are counted under the old parity
+    uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    size_t parity = epoch & 1;
+    for (size_t i = 0; i < READER_SLOTS; ++i) {
+        while (slots_[i].readers[parity].load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::shared_ptr<T> value = std::move(previous->value);
+    delete previous;
+    return value;
+}
+
+template <typename T>
+std::shared_ptr<T> RcuPointer<T>::load() const {
+    // The write lock keeps the node alive while its shared_ptr is copied
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return current_.load(std::memory_order_acquire)->value;
+}
+
+} // namespace poker
\ No newline at end of file
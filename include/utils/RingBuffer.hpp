@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace poker {
+
+/**
+ * MpscRingBuffer is a bounded lock-free queue for many producers and a single
+ * consumer. Every slot carries a sequence number so producers only contend on
+ * one atomic counter and never block: a push into a full buffer fails and the
+ * caller decides what to drop.
+ */
+template <typename T>
+class MpscRingBuffer {
+public:
+    // Capacity is rounded up to the next power of two
+    explicit MpscRingBuffer(size_t capacity);
+
+    // Enqueue from any thread, returns false if the buffer is full
+    bool tryPush(T&& value);
+
+    // Dequeue from the consumer thread, returns false if the buffer is empty
+    bool tryPop(T& value);
+
+    // Number of slots
+    size_t capacity() const { return mask_ + 1; }
+
+    // Approximate number of queued elements (exact only when producers are idle)
+    size_t sizeApprox() const;
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        T value;
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t value);
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+
+    // Producers and consumer live on separate cache lines
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+
+    // Prevent copying
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+};
+
+// Template implementations
+
+template <typename T>
+MpscRingBuffer<T>::MpscRingBuffer(size_t capacity)
+    : slots_(new Slot[roundUpToPowerOfTwo(capacity)]),
+      mask_(roundUpToPowerOfTwo(capacity) - 1) {
+    for (size_t i = 0; i <= mask_; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool MpscRingBuffer<T>::tryPush(T&& value) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            // Slot is free for this position, try to claim it
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Consumer has not released this slot yet: buffer is full
+            return false;
+        } else {
+            // Another producer claimed the position, reload and retry
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->value = std::move(value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool MpscRingBuffer<T>::tryPop(T& value) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & mask_];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+    if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0) {
+        return false;
+    }
+
+    value = std::move(slot.value);
+    slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    tail_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T>
+size_t MpscRingBuffer<T>::sizeApprox() const {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    return head > tail ? head - tail : 0;
+}
+
+template <typename T>
+size_t MpscRingBuffer<T>::roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace poker
@@ -28,6 +28,16 @@ public:
     static bool loadFromFile(std::unordered_map<std::string, std::unordered_map<Action, T, Hash>>& data, 
                             const std::string& filename);
     
+    // Save a table whose entries wrap an action map: project(entry) returns the
+    // map to write. Entries whose projected map is empty are skipped.
+    template <typename Map, typename Projection>
+    static bool saveToFile(const Map& data, const std::string& filename, Projection project);
+    
+    // Load into such a table: assign(entry, actionMap) stores each loaded map.
+    // Existing entries are kept, so several files can fill one table.
+    template <typename T, typename Hash, typename Map, typename Assign>
+    static bool loadFromFile(Map& data, const std::string& filename, Assign assign);
+    
     // Serialize/deserialize card
     static std::string serializeCard(const Card& card);
     static Card deserializeCard(const std::string& str);
@@ -68,19 +78,45 @@ public:
 template <typename T, typename Hash>
 bool Serialization::saveToFile(const std::unordered_map<std::string, std::unordered_map<Action, T, Hash>>& data, 
                               const std::string& filename) {
+    return saveToFile(data, filename,
+                      [](const std::unordered_map<Action, T, Hash>& actionMap) -> const auto& { return actionMap; });
+}
+
+// Template implementation for loading strategy data
+template <typename T, typename Hash>
+bool Serialization::loadFromFile(std::unordered_map<std::string, std::unordered_map<Action, T, Hash>>& data, 
+                                const std::string& filename) {
+    data.clear();
+    return loadFromFile<T, Hash>(data, filename,
+                                 [](std::unordered_map<Action, T, Hash>& entry, std::unordered_map<Action, T, Hash>&& actionMap) {
+                                     entry = std::move(actionMap);
+                                 });
+}
+
+// Template implementation for saving projected entries
+template <typename Map, typename Projection>
+bool Serialization::saveToFile(const Map& data, const std::string& filename, Projection project) {
     std::ofstream ofs(filename, std::ios::binary);
     if (!ofs.is_open()) {
         return false;
     }
     
     // Write number of info sets
-    int numInfoSets = static_cast<int>(data.size());
+    int numInfoSets = 0;
+    for (const auto& infoSetPair : data) {
+        if (!project(infoSetPair.second).empty()) {
+            numInfoSets++;
+        }
+    }
     writeBinary(ofs, numInfoSets);
     
     // Write each info set
     for (const auto& infoSetPair : data) {
         const std::string& infoSet = infoSetPair.first;
-        const auto& actionMap = infoSetPair.second;
+        const auto& actionMap = project(infoSetPair.second);
+        if (actionMap.empty()) {
+            continue;
+        }
         
         // Write info set string
         writeBinary(ofs, infoSet);
@@ -92,14 +128,13 @@ bool Serialization::saveToFile(const std::unordered_map<std::string, std::unorde
         // Write each action and its value
         for (const auto& actionPair : actionMap) {
             const Action& action = actionPair.first;
-            T value = actionPair.second;
             
             // Write action
             std::string actionStr = serializeAction(action);
             writeBinary(ofs, actionStr);
             
             // Write value
-            writeBinary(ofs, static_cast<double>(value));
+            writeBinary(ofs, static_cast<double>(actionPair.second));
         }
     }
     
@@ -107,17 +142,14 @@ bool Serialization::saveToFile(const std::unordered_map<std::string, std::unorde
     return true;
 }
 
-// Template implementation for loading strategy data
-template <typename T, typename Hash>
-bool Serialization::loadFromFile(std::unordered_map<std::string, std::unordered_map<Action, T, Hash>>& data, 
-                                const std::string& filename) {
+// Template implementation for loading projected entries
+template <typename T, typename Hash, typename Map, typename Assign>
+bool Serialization::loadFromFile(Map& data, const std::string& filename, Assign assign) {
     std::ifstream ifs(filename, std::ios::binary);
     if (!ifs.is_open()) {
         return false;
     }
     
-    data.clear();
-    
     // Read number of info sets
     int numInfoSets = readBinaryInt(ifs);
     
@@ -144,7 +176,7 @@ bool Serialization::loadFromFile(std::unordered_map<std::string, std::unordered_
         }
         
         // Store in data map
-        data[infoSet] = std::move(actionMap);
+        assign(data[infoSet], std::move(actionMap));
     }
     
     ifs.close();
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+// One completed span. Names must be string literals (only the pointer is stored).
+struct TraceEvent {
+    const char* name;
+    uint64_t startNs;       // Relative to Tracer::start()
+    uint64_t durationNs;
+    int64_t arg;            // Optional argument (e.g. iteration number), -1 if unused
+};
+
+/**
+ * Tracer records scoped spans into per-thread buffers and writes them as
+ * Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev). Each thread
+ * appends to its own bounded buffer and publishes with a release store, so
+ * recording never takes a lock; a full buffer drops new spans and counts them.
+ * When tracing is off a span costs one relaxed load.
+ *
+ * Buffers grow in small chunks as spans arrive, so a short-lived thread only
+ * holds what it recorded. When a thread exits its buffer is handed back for
+ * reuse by the next new thread, once its spans have been written out.
+ */
+class Tracer {
+public:
+    // Singleton access
+    static Tracer& getInstance();
+
+    // Start recording; clears earlier spans. Call while no other thread is recording.
+    void start(size_t eventsPerThread = 1 << 16);
+
+    // Stop recording (already recorded spans are kept)
+    void stop();
+
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Name shown for the calling thread in the trace viewer
+    void setThreadName(const std::string& name);
+
+    // Append a span for the calling thread
+    void record(const char* name, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end, int64_t arg = -1);
+
+    // Spans recorded / dropped across all threads
+    size_t getEventCount() const;
+    uint64_t getDroppedCount() const;
+
+    // Buffers allocated so far
+    size_t getBufferCount() const;
+
+    // Write every recorded span as Chrome trace JSON; buffers of exited threads
+    // are recycled afterwards
+    bool writeChromeTrace(const std::string& filename);
+
+private:
+    Tracer() = default;
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    // Events per chunk of a thread buffer
+    static constexpr size_t CHUNK_EVENTS = 1024;
+
+    struct ThreadBuffer {
+        // Chunk table sized for capacity; chunks are allocated by the owning
+        // thread before it publishes the first span in them
+        std::unique_ptr<std::unique_ptr<TraceEvent[]>[]> chunks;
+        size_t numChunks = 0;
+        size_t capacity = 0;
+        std::atomic<size_t> count{0};
+        std::atomic<uint64_t> dropped{0};
+        uint32_t threadId = 0;
+        std::string threadName;
+        bool live = false;      // Owned by a running thread (guarded by registryMutex_)
+    };
+
+    // Holds the calling thread's buffer and hands it back when the thread exits
+    struct BufferLease {
+        ThreadBuffer* buffer;
+        BufferLease() : buffer(getInstance().acquireBuffer()) {}
+        ~BufferLease() { getInstance().releaseBuffer(buffer); }
+    };
+
+    ThreadBuffer& threadBuffer() {
+        thread_local BufferLease lease;
+        return *lease.buffer;
+    }
+    ThreadBuffer* acquireBuffer();
+    void releaseBuffer(ThreadBuffer* buffer);
+
+    // Drop a buffer's spans and chunks and make it available (lock held)
+    void recycleLocked(ThreadBuffer* buffer);
+
+    // Size a buffer's chunk table for eventsPerThread_ (lock held)
+    void resizeLocked(ThreadBuffer* buffer) const;
+
+    std::atomic<bool> enabled_{false};
+    std::chrono::steady_clock::time_point epoch_{std::chrono::steady_clock::now()};
+    size_t eventsPerThread_ = 1 << 16;
+
+    mutable std::mutex registryMutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::vector<ThreadBuffer*> freeBuffers_;
+    uint32_t nextThreadId_ = 0;
+};
+
+/**
+ * ScopedTrace records its scope as one span if tracing is enabled.
+ */
+class ScopedTrace {
+public:
+    explicit ScopedTrace(const char* name, int64_t arg = -1)
+        : name_(name), arg_(arg), active_(Tracer::getInstance().isEnabled()) {
+        if (active_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedTrace() {
+        if (active_) {
+            Tracer::getInstance().record(name_, start_, std::chrono::steady_clock::now(), arg_);
+        }
+    }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+private:
+    const char* name_;
+    int64_t arg_;
+    bool active_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace poker
+
+// Tracing macros; define POKER_DISABLE_TRACING to compile them out
+#define POKER_TRACE_CONCAT_INNER(a, b) a##b
+#define POKER_TRACE_CONCAT(a, b) POKER_TRACE_CONCAT_INNER(a, b)
+
+#ifdef POKER_DISABLE_TRACING
+#define TRACE_SCOPE(name) do {} while (0)
+#define TRACE_SCOPE_ARG(name, arg) do {} while (0)
+#else
+#define TRACE_SCOPE(name) poker::ScopedTrace POKER_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_SCOPE_ARG(name, arg) \
+    poker::ScopedTrace POKER_TRACE_CONCAT(traceScope_, __LINE__)(name, static_cast<int64_t>(arg))
+#endif
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace poker {
+
+/**
+ * SplitMix64 step. Used to expand a 64-bit seed into generator state and to
+ * hash (seed, iteration, thread) tuples into independent stream seeds.
+ */
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Xoshiro256 is the xoshiro256** generator: 32 bytes of state, a few
+ * nanoseconds per draw and jump functions that split one seed into 2^128
+ * non-overlapping sub-streams. It satisfies UniformRandomBitGenerator so it
+ * can drive the std:: distributions and algorithms.
+ */
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+    using State = std::array<uint64_t, 4>;
+
+    // Constructors
+    Xoshiro256() { seed(0x853C49E6748FEA9BULL); }
+    explicit Xoshiro256(uint64_t seedValue) { seed(seedValue); }
+
+    // Reproducible stream for a (master seed, iteration, thread) tuple. The
+    // state only depends on the tuple, so any iteration can be replayed
+    // without generating the ones before it.
+    static Xoshiro256 forStream(uint64_t masterSeed, uint64_t iteration, uint64_t threadIndex) {
+        uint64_t mix = masterSeed;
+        uint64_t key = splitMix64(mix);
+        mix = key ^ iteration;
+        key = splitMix64(mix);
+        mix = key ^ threadIndex;
+        return Xoshiro256(splitMix64(mix));
+    }
+
+    // Seed the generator (all-zero state is impossible after SplitMix64)
+    void seed(uint64_t seedValue) {
+        uint64_t sm = seedValue;
+        for (auto& word : state_) {
+            word = splitMix64(sm);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    // Next 64 random bits
+    result_type operator()() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+
+        return result;
+    }
+
+    // Uniform double in [0, 1) from the top 53 bits
+    double nextDouble() {
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    // Uniform integer in [0, bound) using Lemire's multiply-shift reduction
+    uint32_t nextBounded(uint32_t bound) {
+        uint64_t product = ((*this)() >> 32) * static_cast<uint64_t>(bound);
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // Advance by 2^128 draws (one sub-stream per thread)
+    void jump() {
+        static constexpr uint64_t JUMP[] = {
+            0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+            0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+        };
+        applyJump(JUMP);
+    }
+
+    // Advance by 2^192 draws (one sub-stream per process/machine)
+    void longJump() {
+        static constexpr uint64_t LONG_JUMP[] = {
+            0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL,
+            0x77710069854EE241ULL, 0x39109BB02ACBE635ULL
+        };
+        applyJump(LONG_JUMP);
+    }
+
+    // Raw state access for checkpointing
+    const State& getState() const { return state_; }
+    void setState(const State& state) { state_ = state; }
+
+    bool operator==(const Xoshiro256& other) const { return state_ == other.state_; }
+    bool operator!=(const Xoshiro256& other) const { return !(*this == other); }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    void applyJump(const uint64_t (&polynomial)[4]) {
+        State jumped = {0, 0, 0, 0};
+        for (uint64_t word : polynomial) {
+            for (int bit = 0; bit < 64; ++bit) {
+                if (word & (uint64_t(1) << bit)) {
+                    for (size_t i = 0; i < jumped.size(); ++i) {
+                        jumped[i] ^= state_[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        state_ = jumped;
+    }
+
+    State state_;
+};
+
+} // namespace poker
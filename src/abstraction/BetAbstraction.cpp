@@ -139,8 +139,10 @@ std::vector<Action> BetAbstraction::getAbstractedActions(
         }
     }
     
-    // Add debug logging
-    debugLogActions(validActions, abstractedActions);
+    // Add debug logging (skipped entirely unless DEBUG output is enabled)
+    if (LOG_DEBUG_ENABLED()) {
+        debugLogActions(validActions, abstractedActions);
+    }
     
     return abstractedActions;
 }
@@ -1,5 +1,8 @@
 #include <HandAbstraction.hpp>
 #include <game/HandEvaluator.hpp>
+#include <utils/Metrics.hpp>
+#include <utils/Trace.hpp>
+#include <cfr/TableMemory.hpp>
 #include <algorithm>
 #include <fstream>
 #include <iostream>
@@ -54,6 +57,8 @@ int HandAbstraction::getBucket(
     const std::array<Card, NUM_HOLE_CARDS>& holeCards,
     const std::vector<Card>& communityCards
 ) const {
+    Metrics::increment(Counter::BUCKET_LOOKUPS);
+    
     // Create the key for the hand
     BucketKey key{holeCards, communityCards};
     
@@ -66,8 +71,41 @@ int HandAbstraction::getBucket(
         return it->second;
     }
     
-    // If not, we need to compute the bucket
+    // Compute and cache the result
+    int bucket = calculateBucket(holeCards, communityCards);
+    handToBucket_[key] = bucket;
+    
+    return bucket;
+}
+
+int HandAbstraction::getBucketUncached(
+    const std::array<Card, NUM_HOLE_CARDS>& holeCards,
+    const std::vector<Card>& communityCards
+) const {
+    // Preflop entries are bounded by the 1326 combos
+    if (communityCards.empty()) {
+        return getBucket(holeCards, communityCards);
+    }
+    
+    Metrics::increment(Counter::BUCKET_LOOKUPS);
+    BucketKey key{holeCards, communityCards};
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // A cached bucket wins, so hands already looked up keep their bucket
+    auto it = handToBucket_.find(key);
+    if (it != handToBucket_.end()) {
+        return it->second;
+    }
+    return calculateBucket(holeCards, communityCards);
+}
+
+int HandAbstraction::calculateBucket(
+    const std::array<Card, NUM_HOLE_CARDS>& holeCards,
+    const std::vector<Card>& communityCards
+) const {
     // This depends on the betting round
+    Metrics::increment(Counter::BUCKET_MISSES);
+    TRACE_SCOPE("bucket_miss");
     BettingRound round;
     if (communityCards.empty()) {
         round = BettingRound::PREFLOP;
@@ -98,9 +136,6 @@ int HandAbstraction::getBucket(
             break;
     }
     
-    // Cache the result
-    handToBucket_[key] = bucket;
-    
     return bucket;
 }
 
@@ -227,6 +262,30 @@ bool HandAbstraction::loadFromFile(const std::string& filename) {
     return true;
 }
 
+TableFootprint HandAbstraction::getCacheFootprint() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    TableFootprint footprint;
+    footprint.name = "hand_buckets";
+    
+    size_t nodeBytes = sizeof(decltype(handToBucket_)::value_type) + TableMemory::NODE_OVERHEAD;
+    for (const auto& entry : handToBucket_) {
+        footprint.entries++;
+        footprint.nodeBytes += nodeBytes;
+        footprint.addAllocation(nodeBytes);
+        
+        // Community cards live in a separate vector allocation
+        size_t boardBytes = entry.first.communityCards.capacity() * sizeof(Card);
+        if (boardBytes > 0) {
+            footprint.keyBytes += boardBytes;
+            footprint.addAllocation(boardBytes);
+        }
+    }
+    TableMemory::addBucketArray(footprint, handToBucket_);
+    
+    return footprint;
+}
+
 std::string HandAbstraction::getName() const {
     switch (level_) {
         case Level::NONE:
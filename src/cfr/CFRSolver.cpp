@@ -1,7 +1,11 @@
 #include "cfr/CFRSolver.hpp"
+#include "cfr/Checkpoint.hpp"
 #include "utils/Logger.hpp"
 #include "utils/Random.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/Trace.hpp"
 #include "abstraction/BetAbstraction.hpp"
+#include "game/Deck.hpp"
 #include <chrono>
 #include <iostream>
 #include <thread>
@@ -36,27 +40,88 @@ CFRSolver::CFRSolver(
 }
 
 CFRSolver::~CFRSolver() {
-    // Nothing to clean up explicitly
+    // Let an in-flight checkpoint finish writing, then retire the writer
+    waitForCheckpoint();
+    if (checkpointWriter_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(checkpointMutex_);
+            stopCheckpointWriter_ = true;
+        }
+        checkpointCondition_.notify_all();
+        checkpointWriter_.join();
+    }
+}
+
+std::string CFRSolver::traversalModeToString(TraversalMode mode) {
+    switch (mode) {
+        case TraversalMode::VANILLA: return "vanilla";
+        case TraversalMode::MONTE_CARLO: return "monte_carlo";
+        case TraversalMode::PUBLIC_TREE: return "public_tree";
+        default: return "unknown";
+    }
 }
 
 void CFRSolver::train(int iterations, bool useMonteCarloSampling) {
+    train(iterations, useMonteCarloSampling ? TraversalMode::MONTE_CARLO : TraversalMode::VANILLA);
+}
+
+void CFRSolver::train(int iterations, TraversalMode mode) {
     auto startTime = std::chrono::high_resolution_clock::now();
     
     LOG_INFO("Starting CFRM training for " + std::to_string(iterations) + " iterations");
     LOG_INFO("Hand abstraction: " + handAbstraction_->getName());
     LOG_INFO("Bet abstraction: " + betAbstraction_->getName());
-    LOG_INFO("Using Monte Carlo sampling: " + std::string(useMonteCarloSampling ? "Yes" : "No"));
+    LOG_INFO("Traversal: " + traversalModeToString(mode));
     
     // OPTIMIZATION: Initialize game state once and reuse it
     auto gameState = initialState_->clone();
     
+    // OPTIMIZATION: Deals and their hand buckets are prepared ahead, overlapping
+    // with the traversals, so the traversal never calls the hand abstraction.
+    // The pipeline outlives this call, so a loop of short train() calls keeps
+    // one producer thread instead of starting and joining one per call.
+    // PUBLIC_TREE also has the producer rank and bucket every combo.
+    uint64_t seed = Random::getInstance().getSeed();
+    uint64_t firstIteration = static_cast<uint64_t>(iterationsCompleted_);
+    bool withRanges = mode == TraversalMode::PUBLIC_TREE;
+    if (!dealPipeline_ || dealPipeline_->getSeed() != seed ||
+        dealPipeline_->nextIteration() != firstIteration || dealPipeline_->getDepth() != dealPrefetch_ ||
+        dealPipeline_->hasRanges() != withRanges) {
+        dealPipeline_.reset();      // Join the stale producer first
+        dealPipeline_ = std::make_unique<DealPipeline>(handAbstraction_, seed, firstIteration,
+                                                       DealPipeline::UNBOUNDED, dealPrefetch_, withRanges);
+    }
+    DealPipeline::PreparedDeal prepared;
+    
     // Run the specified number of iterations
     for (int i = 0; i < iterations; ++i) {
+        TRACE_SCOPE_ARG("iteration", iterationsCompleted_);
         auto iterationStart = std::chrono::high_resolution_clock::now();
         
+        // Entries touched from here on count as used in this iteration
+        regretTable_.advanceEpoch();
+        strategyTable_.advanceEpoch();
+        
         // Reset game state instead of creating new one
-        gameState->reset();
-        gameState->dealHoleCards();
+        {
+            ScopedPhase phase(Phase::DEAL);
+            TRACE_SCOPE("deal");
+            dealPipeline_->next(prepared);
+            
+            // Chance and sampling draws for this iteration come from a stream that
+            // only depends on the seed and the global iteration number; the deal
+            // was drawn from its start
+            Random::getInstance().getGenerator() = prepared.stream;
+            gameState->reset(prepared.deal);
+            gameState->dealHoleCards();
+            dealBuckets_ = prepared.buckets;
+            
+            // Only the board of the deal is used; every hole-card combo is played
+            if (withRanges) {
+                publicShowdown_ = std::move(prepared.showdown);
+                publicBuckets_ = std::move(prepared.rangeBuckets);
+            }
+        }
         
         // Initialize reach probabilities
         std::unordered_map<Position, double> reachProbabilities;
@@ -65,21 +130,43 @@ void CFRSolver::train(int iterations, bool useMonteCarloSampling) {
         reachProbabilities[Position::BTN] = 1.0;
         
         // Run CFR directly instead of through runIteration
-        if (useMonteCarloSampling) {
-            monteCarloSample(*gameState, reachProbabilities, 0);
-        } else {
-            cfr(*gameState, reachProbabilities, 0);
+        {
+            ScopedPhase phase(Phase::TRAVERSAL);
+            TRACE_SCOPE("traversal");
+            switch (mode) {
+                case TraversalMode::MONTE_CARLO:
+                    monteCarloSample(*gameState, reachProbabilities, 0);
+                    break;
+                case TraversalMode::VANILLA:
+                    cfr(*gameState, reachProbabilities, 0);
+                    break;
+                case TraversalMode::PUBLIC_TREE: {
+                    Ranges reach;
+                    for (auto& range : reach) {
+                        range.assign(publicShowdown_.size(), 1.0);
+                    }
+                    Ranges values;
+                    publicTreeCfr(*gameState, reach, values, 0);
+                    for (size_t p = 0; p < NUM_PLAYERS; ++p) {
+                        publicRootValues_[p] = std::accumulate(values[p].begin(), values[p].end(), 0.0);
+                    }
+                    break;
+                }
+            }
         }
         
-        auto iterationEnd = std::chrono::high_resolution_clock::now();
-        auto iterationTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-            iterationEnd - iterationStart).count();
+        // Keep sub-millisecond resolution; whole milliseconds round most MC iterations to 0
+        auto iterationNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - iterationStart).count();
+        double iterationTime = iterationNanos / 1e6;
+        Metrics::recordIterationLatency(static_cast<uint64_t>(iterationNanos));
         
         // Update counters with mutex protection
+        int completed;
         {
             std::lock_guard<std::mutex> lock(statsMutex_);
-            iterationsCompleted_++;
-            totalTrainingTime_ += static_cast<double>(iterationTime);
+            completed = ++iterationsCompleted_;
+            totalTrainingTime_ += iterationTime;
         }
         
         // Report progress
@@ -89,12 +176,24 @@ void CFRSolver::train(int iterations, bool useMonteCarloSampling) {
             
             // Calculate and report training stats
             if (progressCallback_) {
-                progressCallback_(i + 1, getTrainingStats());
+                ScopedPhase phase(Phase::CALLBACK);
+                TRACE_SCOPE("progress_callback");
+                progressCallback_(i + 1, getTrainingStats(false));
             }
         }
         
-        // OPTIMIZATION: Perform memory cleanup periodically
-        if ((i + 1) % 20 == 0) {
+        // OPTIMIZATION: With a memory budget, evict a bounded slice every iteration
+        // rather than stalling on a full-table prune
+        if (memoryBudget_ > 0) {
+            ScopedPhase phase(Phase::PRUNE);
+            TRACE_SCOPE("evict");
+            enforceMemoryBudget();
+        }
+        // OPTIMIZATION: Perform memory cleanup periodically. Keyed on the global
+        // iteration count so train(n) and n calls of train(1) do the same work.
+        else if (completed % 20 == 0) {
+            ScopedPhase phase(Phase::PRUNE);
+            TRACE_SCOPE("prune");
             LOG_INFO("Performing memory cleanup...");
             size_t beforeSize = regretTable_.size();
             pruneStrategiesAndRegrets();
@@ -102,6 +201,17 @@ void CFRSolver::train(int iterations, bool useMonteCarloSampling) {
             LOG_INFO("Memory cleanup: removed " + std::to_string(beforeSize - afterSize) + 
                      " low-value info sets");
         }
+        
+        // After pruning, so a resumed run sees the same tables as this one
+        if (checkpointInterval_ > 0 && completed % checkpointInterval_ == 0) {
+            ScopedPhase phase(Phase::CHECKPOINT);
+            TRACE_SCOPE("checkpoint_snapshot");
+            startBackgroundCheckpoint();
+        }
+    }
+    
+    if (checkpointInterval_ > 0) {
+        waitForCheckpoint();
     }
     
     auto endTime = std::chrono::high_resolution_clock::now();
@@ -112,6 +222,10 @@ void CFRSolver::train(int iterations, bool useMonteCarloSampling) {
     LOG_INFO("Processed information sets: " + std::to_string(regretTable_.size()));
 }
 
+void CFRSolver::setSeed(uint64_t seed) {
+    Random::getInstance().seed(seed);
+}
+
 // You'll need to add this helper method to the CFRSolver class:
 void CFRSolver::pruneStrategiesAndRegrets() {
     // Remove info sets with very small regrets to save memory
@@ -119,12 +233,59 @@ void CFRSolver::pruneStrategiesAndRegrets() {
     regretTable_.prune(REGRET_THRESHOLD);
 }
 
+void CFRSolver::setMemoryBudget(size_t bytes, size_t maxBucketsPerIteration) {
+    if (maxBucketsPerIteration == 0) {
+        throw std::invalid_argument("Eviction scan limit must be positive");
+    }
+    memoryBudget_ = bytes;
+    evictionBucketsPerIteration_ = maxBucketsPerIteration;
+}
+
+size_t CFRSolver::getTableMemoryBytes() const {
+    return regretTable_.memoryBytes() + strategyTable_.memoryBytes();
+}
+
+std::vector<TableFootprint> CFRSolver::getMemoryFootprint() const {
+    std::vector<TableFootprint> footprints;
+    footprints.push_back(regretTable_.footprint());
+    
+    auto strategyFootprint = strategyTable_.footprint();
+    footprints.push_back(strategyFootprint.current);
+    footprints.push_back(strategyFootprint.sum);
+    
+    if (handAbstraction_) {
+        footprints.push_back(handAbstraction_->getCacheFootprint());
+    }
+    
+    return footprints;
+}
+
+void CFRSolver::enforceMemoryBudget() {
+    size_t regretBytes = regretTable_.memoryBytes();
+    size_t strategyBytes = strategyTable_.memoryBytes();
+    size_t total = regretBytes + strategyBytes;
+    if (total <= memoryBudget_) {
+        return;
+    }
+    
+    // Free down to 90% of the budget so eviction does not run on every iteration
+    // at the cap; each table gives up its share of the excess
+    size_t excess = total - (memoryBudget_ - memoryBudget_ / 10);
+    size_t fromRegrets = static_cast<size_t>(static_cast<double>(excess) * regretBytes / total);
+    size_t freed = regretTable_.evict(fromRegrets, evictionBucketsPerIteration_);
+    freed += strategyTable_.evict(excess - std::min(excess, freed), evictionBucketsPerIteration_);
+    
+    LOG_DEBUG("Memory budget: evicted " + std::to_string(freed) + " of " +
+              std::to_string(excess) + " excess bytes");
+}
+
 void CFRSolver::runIteration(bool useMonteCarloSampling) {
     // Create a fresh game state for each iteration
     auto gameState = initialState_->clone();
     
     // Deal hole cards
     gameState->dealHoleCards();
+    dealBuckets_ = DealPipeline::computeBuckets(*handAbstraction_, gameState->getDeal());
     
     // Initialize reach probabilities (1.0 for each player)
     std::unordered_map<Position, double> reachProbabilities;
@@ -142,40 +303,44 @@ void CFRSolver::runIteration(bool useMonteCarloSampling) {
 
 std::unordered_map<Action, double, RegretTable::ActionHash> 
 CFRSolver::getStrategy(const std::string& infoSet, const std::vector<Action>& validActions) {
-    // Get all regrets for this info set
-    auto regrets = regretTable_.getRegrets(infoSet);
+    std::vector<double> probabilities(validActions.size());
+    computeStrategy(infoSet, validActions, probabilities.data());
+    
+    std::unordered_map<Action, double, RegretTable::ActionHash> strategy;
+    for (size_t i = 0; i < validActions.size(); ++i) {
+        strategy[validActions[i]] = probabilities[i];
+    }
+    
+    return strategy;
+}
+
+void CFRSolver::computeStrategy(const std::string& infoSet, const std::vector<Action>& validActions,
+                                double* strategy) const {
+    if (validActions.empty()) {
+        return;
+    }
+    
+    // Regrets land directly in the output array, aligned with validActions
+    regretTable_.getRegrets(infoSet, validActions, strategy);
     
     // Sum positive regrets
     double regretSum = 0.0;
-    for (const auto& action : validActions) {
-        double actionRegret = regrets[action];
-        if (actionRegret > 0.0) {
-            regretSum += actionRegret;
+    for (size_t i = 0; i < validActions.size(); ++i) {
+        if (strategy[i] > 0.0) {
+            regretSum += strategy[i];
         }
     }
     
-    // Calculate strategy based on regret-matching
-    std::unordered_map<Action, double, RegretTable::ActionHash> strategy;
-    
     if (regretSum > 0.0) {
         // Normalize by the sum of positive regrets
-        for (const auto& action : validActions) {
-            double actionRegret = regrets[action];
-            if (actionRegret > 0.0) {
-                strategy[action] = actionRegret / regretSum;
-            } else {
-                strategy[action] = 0.0;
-            }
+        for (size_t i = 0; i < validActions.size(); ++i) {
+            strategy[i] = strategy[i] > 0.0 ? strategy[i] / regretSum : 0.0;
         }
     } else {
         // If all regrets are non-positive, use uniform strategy
         double uniformProb = 1.0 / validActions.size();
-        for (const auto& action : validActions) {
-            strategy[action] = uniformProb;
-        }
+        std::fill(strategy, strategy + validActions.size(), uniformProb);
     }
-    
-    return strategy;
 }
 
 // FIXED: Added const qualifier to match header
@@ -222,7 +387,153 @@ bool CFRSolver::loadStrategy(const std::string& filename) {
     return success;
 }
 
-CFRSolver::TrainingStats CFRSolver::getTrainingStats() const {
+CheckpointMetadata CFRSolver::checkpointMetadata() const {
+    CheckpointMetadata metadata;
+    metadata.handAbstraction = static_cast<uint32_t>(handAbstraction_->getLevel());
+    metadata.betAbstraction = static_cast<uint32_t>(betAbstraction_->getLevel());
+    metadata.seed = Random::getInstance().getSeed();
+    metadata.nodesVisited = nodesVisited_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        metadata.iteration = static_cast<uint64_t>(iterationsCompleted_);
+        metadata.trainingMillis = totalTrainingTime_;
+    }
+    return metadata;
+}
+
+bool CFRSolver::saveCheckpoint(const std::string& filename, unsigned numThreads) const {
+    LOG_INFO("Saving checkpoint to: " + filename);
+    
+    CheckpointMetadata metadata = checkpointMetadata();
+    
+    auto start = std::chrono::steady_clock::now();
+    bool success = Checkpoint::save(filename, metadata, regretTable_, strategyTable_, numThreads);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    
+    if (success) {
+        LOG_INFO("Checkpoint saved in " + std::to_string(elapsed) + "ms (iteration " +
+                 std::to_string(metadata.iteration) + ")");
+    } else {
+        LOG_ERROR("Failed to save checkpoint");
+    }
+    
+    return success;
+}
+
+bool CFRSolver::loadCheckpoint(const std::string& filename, unsigned numThreads) {
+    LOG_INFO("Loading checkpoint from: " + filename);
+    
+    CheckpointMetadata metadata;
+    if (!Checkpoint::readMetadata(filename, metadata)) {
+        return false;
+    }
+    if (metadata.handAbstraction != static_cast<uint32_t>(handAbstraction_->getLevel()) ||
+        metadata.betAbstraction != static_cast<uint32_t>(betAbstraction_->getLevel())) {
+        LOG_ERROR("Checkpoint was made with different hand/bet abstractions: " + filename);
+        return false;
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    if (!Checkpoint::load(filename, metadata, regretTable_, strategyTable_, numThreads)) {
+        LOG_ERROR("Failed to load checkpoint");
+        return false;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    
+    // The RNG stream of each iteration derives from (seed, iteration), so these
+    // counters are the whole sampling state
+    Random::getInstance().seed(metadata.seed);
+    nodesVisited_.store(metadata.nodesVisited, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        iterationsCompleted_ = static_cast<int>(metadata.iteration);
+        totalTrainingTime_ = metadata.trainingMillis;
+    }
+    
+    LOG_INFO("Checkpoint loaded in " + std::to_string(elapsed) + "ms: " +
+             std::to_string(regretTable_.size()) + " info sets, iteration " +
+             std::to_string(metadata.iteration));
+    return true;
+}
+
+void CFRSolver::setCheckpointing(const std::string& filename, int intervalIterations, unsigned numThreads) {
+    if (intervalIterations < 0) {
+        throw std::invalid_argument("Checkpoint interval must be non-negative");
+    }
+    if (intervalIterations > 0 && filename.empty()) {
+        throw std::invalid_argument("Checkpoint filename must not be empty");
+    }
+    waitForCheckpoint();
+    checkpointFile_ = filename;
+    checkpointInterval_ = intervalIterations;
+    checkpointThreads_ = numThreads;
+}
+
+bool CFRSolver::waitForCheckpoint() {
+    std::unique_lock<std::mutex> lock(checkpointMutex_);
+    checkpointCondition_.wait(lock, [this] { return !checkpointBusy_; });
+    return lastCheckpointOk_.load();
+}
+
+void CFRSolver::startBackgroundCheckpoint() {
+    // One write in flight at a time; a slow disk throttles training here
+    // rather than piling up snapshots in memory
+    if (!waitForCheckpoint()) {
+        LOG_WARNING("Previous background checkpoint failed");
+    }
+    
+    // OPTIMIZATION: Training is paused only for a parallel in-memory encode;
+    // the file write and fsync happen on the writer thread
+    auto start = std::chrono::steady_clock::now();
+    CheckpointSnapshot snapshot = Checkpoint::capture(checkpointMetadata(), regretTable_, strategyTable_,
+                                                      checkpointThreads_);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    LOG_INFO("Checkpoint snapshot at iteration " + std::to_string(snapshot.metadata.iteration) + ": " +
+             std::to_string(snapshot.bytes() / (1024 * 1024)) + "MB in " + std::to_string(elapsed) + "ms");
+    
+    // OPTIMIZATION: One long-lived writer thread takes every snapshot, so
+    // periodic checkpoints do not start a thread (and its thread-local
+    // buffers) each time
+    {
+        std::lock_guard<std::mutex> lock(checkpointMutex_);
+        pendingCheckpoint_ = std::make_unique<CheckpointSnapshot>(std::move(snapshot));
+        pendingCheckpointFile_ = checkpointFile_;
+        checkpointBusy_ = true;
+    }
+    if (!checkpointWriter_.joinable()) {
+        checkpointWriter_ = std::thread(&CFRSolver::checkpointWriterLoop, this);
+    }
+    checkpointCondition_.notify_all();
+}
+
+void CFRSolver::checkpointWriterLoop() {
+    std::unique_lock<std::mutex> lock(checkpointMutex_);
+    while (true) {
+        checkpointCondition_.wait(lock, [this] { return pendingCheckpoint_ || stopCheckpointWriter_; });
+        if (!pendingCheckpoint_) {
+            return;
+        }
+        std::unique_ptr<CheckpointSnapshot> snapshot = std::move(pendingCheckpoint_);
+        std::string filename = pendingCheckpointFile_;
+        
+        lock.unlock();
+        bool success = Checkpoint::write(filename, *snapshot);
+        if (!success) {
+            LOG_ERROR("Background checkpoint failed: " + filename);
+        }
+        snapshot.reset();
+        lock.lock();
+        
+        lastCheckpointOk_.store(success);
+        checkpointBusy_ = false;
+        checkpointCondition_.notify_all();
+    }
+}
+
+CFRSolver::TrainingStats CFRSolver::getTrainingStats(bool includeFootprint) const {
     TrainingStats stats;
     
     // Thread safety for reading statistics
@@ -238,10 +549,18 @@ CFRSolver::TrainingStats CFRSolver::getTrainingStats() const {
     }
     
     stats.infoSetCount = regretTable_.size();
+    stats.nodesVisited = getNodesVisited();
+    stats.tableBytes = getTableMemoryBytes();
+    if (includeFootprint) {
+        stats.footprint = getMemoryFootprint();
+    }
+    stats.metrics = Metrics::getInstance().snapshot();
     
-    // TODO: Calculate exploitability
-    // This is computationally expensive and typically done offline
-    stats.exploitability = 0.0;
+    // Exploitability is expensive, so only the last explicit estimate is reported
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats.exploitability = lastExploitability_;
+    }
     
     return stats;
 }
@@ -264,14 +583,19 @@ CFRSolver::cfr(GameState& state, std::unordered_map<Position, double>& reachProb
         return emergency_payoffs;
     }
     
+    nodesVisited_.fetch_add(1, std::memory_order_relaxed);
+    Metrics::increment(Counter::NODES_VISITED);
+    
     // Terminal state check (fast path)
     if (state.isTerminal()) {
+        Metrics::increment(Counter::TERMINAL_EVALS);
+        ScopedPhase phase(Phase::TERMINAL);
         return state.getPayoffs();
     }
     
     // Get current player and info set
     Position currentPosition = state.getCurrentPosition();
-    std::string infoSet = getAbstractedInfoSet(state, currentPosition);
+    std::string infoSet = traversalInfoSet(state, currentPosition);
     
     // Get valid actions with abstraction
     std::vector<Action> validActions = getAbstractedActions(state);
@@ -285,14 +609,18 @@ CFRSolver::cfr(GameState& state, std::unordered_map<Position, double>& reachProb
     }
     
     // Get strategy using positive regrets only
-    auto strategy = getStrategy(infoSet, validActions);
+    if (validActions.size() > MAX_ACTIONS) {
+        throw std::runtime_error("Too many abstracted actions at info set " + infoSet);
+    }
+    double strategy[MAX_ACTIONS];
+    computeStrategy(infoSet, validActions, strategy);
     
     // OPTIMIZATION: Only update strategy sum if reach probability is significant
     double reachProb = reachProbabilities[currentPosition];
     if (reachProb > 0.00001) {
-        for (const auto& [action, prob] : strategy) {
-            if (prob > 0.0) {
-                strategyTable_.addToStrategySum(infoSet, action, reachProb * prob);
+        for (size_t i = 0; i < validActions.size(); ++i) {
+            if (strategy[i] > 0.0) {
+                strategyTable_.addToStrategySum(infoSet, validActions[i], reachProb * strategy[i]);
             }
         }
     }
@@ -315,7 +643,7 @@ CFRSolver::cfr(GameState& state, std::unordered_map<Position, double>& reachProb
         
         // OPTIMIZATION: Update reach probabilities without creating new map
         double oldReachProb = nextReachProbs[currentPosition];
-        nextReachProbs[currentPosition] = reachProb * strategy[action];
+        nextReachProbs[currentPosition] = reachProb * strategy[i];
         
         // Create a copy of the game state
         auto nextState = state.clone();
@@ -338,7 +666,7 @@ CFRSolver::cfr(GameState& state, std::unordered_map<Position, double>& reachProb
         
         // Update expected utilities
         for (const auto& [pos, util] : actionUtilities[i]) {
-            expectedUtilities[pos] += strategy[action] * util;
+            expectedUtilities[pos] += strategy[i] * util;
         }
         
         // OPTIMIZATION: Restore original reach probability
@@ -388,6 +716,9 @@ CFRSolver::monteCarloSample(GameState& state, std::unordered_map<Position, doubl
         return emergency_payoffs;
     }
     
+    nodesVisited_.fetch_add(1, std::memory_order_relaxed);
+    Metrics::increment(Counter::NODES_VISITED);
+    
     // Add debug logging
     LOG_DEBUG("monteCarloSample depth=" + std::to_string(depth) + 
               " round=" + bettingRoundToString(state.getBettingRound()) + 
@@ -395,62 +726,43 @@ CFRSolver::monteCarloSample(GameState& state, std::unordered_map<Position, doubl
 
     // If we're at a terminal state, return the payoffs
     if (state.isTerminal()) {
+        Metrics::increment(Counter::TERMINAL_EVALS);
+        ScopedPhase phase(Phase::TERMINAL);
         return state.getPayoffs();
     }
     
     // Get current player and their info set
     Position currentPosition = state.getCurrentPosition();
-    std::string infoSet = getAbstractedInfoSet(state, currentPosition);
+    std::string infoSet = traversalInfoSet(state, currentPosition);
     
     // Get valid actions for current player
     std::vector<Action> validActions = getAbstractedActions(state);
     
     // Get current strategy for this info set
-    auto strategy = getStrategy(infoSet, validActions);
-    
-    // Update strategy table
-    for (const auto& [action, prob] : strategy) {
-        if (prob > 0.0) {
-            strategyTable_.setStrategy(infoSet, action, prob);
-        }
+    if (validActions.empty()) {
+        throw std::runtime_error("No valid actions available in non-terminal state");
+    }
+    if (validActions.size() > MAX_ACTIONS) {
+        throw std::runtime_error("Too many abstracted actions at info set " + infoSet);
     }
+    double strategy[MAX_ACTIONS];
+    computeStrategy(infoSet, validActions, strategy);
     
-    // Add contribution to average strategy weighted by reach probability
-    for (const auto& [action, prob] : strategy) {
-        if (prob > 0.0) {
-            strategyTable_.addToStrategySum(infoSet, action, reachProbabilities[currentPosition] * prob);
+    // Update strategy table and add the contribution to the average strategy
+    // weighted by reach probability
+    double reachProb = reachProbabilities[currentPosition];
+    for (size_t i = 0; i < validActions.size(); ++i) {
+        if (strategy[i] > 0.0) {
+            strategyTable_.setStrategy(infoSet, validActions[i], strategy[i]);
+            strategyTable_.addToStrategySum(infoSet, validActions[i], reachProb * strategy[i]);
         }
     }
     
     // For Monte Carlo sampling, we'll sample one action according to the strategy
-    // instead of recursing on all actions
-    
-    // Sample action based on current strategy
-    auto& random = Random::getInstance();
-    Action sampledAction = random.sample(strategy);
-    
-    // Make sure the action is in our abstracted action set
-    if (sampledAction.getType() == ActionType::BET || sampledAction.getType() == ActionType::RAISE) {
-        // Find the closest valid action
-        Action closestAction = sampledAction;
-        double minDiff = std::numeric_limits<double>::max();
-        
-        for (const auto& validAction : validActions) {
-            if (validAction.getType() == sampledAction.getType()) {
-                double diff = std::abs(validAction.getAmount() - sampledAction.getAmount());
-                if (diff < minDiff) {
-                    minDiff = diff;
-                    closestAction = validAction;
-                }
-            }
-        }
-        
-        // If we found a closer valid action, use it
-        if (minDiff < std::numeric_limits<double>::max()) {
-            LOG_DEBUG("Adjusting action from " + sampledAction.toString() + " to " + closestAction.toString());
-            sampledAction = closestAction;
-        }
-    }
+    // instead of recursing on all actions. Sampling an index into validActions
+    // means the result is always an abstracted action.
+    size_t sampledIndex = Random::getInstance().sampleIndex(strategy, validActions.size());
+    Action sampledAction = validActions[sampledIndex];
     
     // Create a copy of the game state
     auto nextState = state.clone();
@@ -463,15 +775,11 @@ CFRSolver::monteCarloSample(GameState& state, std::unordered_map<Position, doubl
         // If action is invalid, log the error and try to recover
         LOG_ERROR("Invalid action in monteCarloSample: " + std::string(e.what()));
         
-        // Try to choose a valid action as fallback
-        if (!validActions.empty()) {
-            sampledAction = validActions[0]; // Use first valid action as fallback
-            LOG_INFO("Falling back to action: " + sampledAction.toString());
-            roundOver = nextState->applyAction(sampledAction);
-        } else {
-            // Something is seriously wrong if we have no valid actions
-            throw std::runtime_error("No valid actions available in non-terminal state");
-        }
+        // Use first valid action as fallback
+        sampledIndex = 0;
+        sampledAction = validActions[0];
+        LOG_INFO("Falling back to action: " + sampledAction.toString());
+        roundOver = nextState->applyAction(sampledAction);
     }
     
     // If round is over but game is not terminal, start next round
@@ -481,7 +789,7 @@ CFRSolver::monteCarloSample(GameState& state, std::unordered_map<Position, doubl
     
     // Update reach probabilities for recursion
     auto nextReachProbs = reachProbabilities;
-    nextReachProbs[currentPosition] *= strategy[sampledAction];
+    nextReachProbs[currentPosition] *= strategy[sampledIndex];
     
     // Recursively calculate utilities
     auto sampledUtil = monteCarloSample(*nextState, nextReachProbs, depth + 1);
@@ -500,8 +808,8 @@ CFRSolver::monteCarloSample(GameState& state, std::unordered_map<Position, doubl
     
     // For MC-CFR, we only calculate regrets for the sampled action
     // We need to scale the regret by 1/probability to get an unbiased estimator
-    if (strategy[sampledAction] > 0.0) {
-        double scaledCounterfactualProb = counterfactualProb / strategy[sampledAction];
+    if (strategy[sampledIndex] > 0.0) {
+        double scaledCounterfactualProb = counterfactualProb / strategy[sampledIndex];
         
         // Store regret for sampled action (no need to calculate for other actions)
         regretTable_.addRegret(infoSet, sampledAction, scaledCounterfactualProb * sampledUtil[currentPosition]);
@@ -510,6 +818,192 @@ CFRSolver::monteCarloSample(GameState& state, std::unordered_map<Position, doubl
     return expectedUtility;
 }
 
+void CFRSolver::publicTreeCfr(const GameState& state, const Ranges& reach, Ranges& values, int depth) {
+    const size_t numHands = publicShowdown_.size();
+    for (auto& range : values) {
+        range.assign(numHands, 0.0);
+    }
+    
+    if (depth > MAX_RECURSION_DEPTH) {
+        LOG_WARNING("Maximum recursion depth exceeded in publicTreeCfr");
+        return;
+    }
+    
+    nodesVisited_.fetch_add(1, std::memory_order_relaxed);
+    Metrics::increment(Counter::NODES_VISITED);
+    
+    if (state.isTerminal()) {
+        Metrics::increment(Counter::TERMINAL_EVALS);
+        ScopedPhase phase(Phase::TERMINAL);
+        publicTreeTerminal(state, reach, values);
+        return;
+    }
+    
+    Position currentPosition = state.getCurrentPosition();
+    std::vector<Action> validActions = getAbstractedActions(state);
+    if (validActions.empty()) {
+        LOG_ERROR("No valid actions for non-terminal state");
+        return;
+    }
+    if (validActions.size() > MAX_ACTIONS) {
+        throw std::runtime_error("Too many abstracted actions in publicTreeCfr");
+    }
+    const size_t numActions = validActions.size();
+    const size_t player = static_cast<size_t>(currentPosition);
+    const std::vector<int>& buckets =
+        publicBuckets_[std::min<size_t>(static_cast<size_t>(state.getBettingRound()), 3)];
+    const std::string history = state.getActionHistory().toString();
+    
+    // One info set per bucket: regret matching runs once per bucket, and
+    // regrets and reach are summed over the bucket's combos
+    struct BucketInfoSet {
+        std::string key;
+        double strategy[MAX_ACTIONS];
+        double regrets[MAX_ACTIONS] = {};
+        double reach = 0.0;
+    };
+    std::vector<BucketInfoSet> infoSets;
+    std::unordered_map<int, size_t> infoSetOfBucket;
+    std::vector<size_t> infoSetOfHand(numHands);
+    for (size_t i = 0; i < numHands; ++i) {
+        auto [it, inserted] = infoSetOfBucket.emplace(buckets[i], infoSets.size());
+        if (inserted) {
+            infoSets.emplace_back();
+            infoSets.back().key = makeInfoSetKey(currentPosition, state.getBettingRound(), buckets[i], history);
+            computeStrategy(infoSets.back().key, validActions, infoSets.back().strategy);
+        }
+        infoSetOfHand[i] = it->second;
+        infoSets[it->second].reach += reach[player][i];
+    }
+    
+    // Strategy per combo, action-major, so the kernels below stream through
+    // contiguous arrays
+    std::vector<double> strategy(numActions * numHands);
+    for (size_t i = 0; i < numHands; ++i) {
+        const double* bucketStrategy = infoSets[infoSetOfHand[i]].strategy;
+        for (size_t a = 0; a < numActions; ++a) {
+            strategy[a * numHands + i] = bucketStrategy[a];
+        }
+    }
+    
+    std::vector<Ranges> childValues(numActions);
+    Ranges childReach = reach;
+    for (size_t a = 0; a < numActions; ++a) {
+        // OPTIMIZATION: Only the acting player's range changes; one multiply
+        // per combo, vectorized
+        const double* actionStrategy = &strategy[a * numHands];
+        const double* ownReach = reach[player].data();
+        double* nextReach = childReach[player].data();
+        for (size_t i = 0; i < numHands; ++i) {
+            nextReach[i] = ownReach[i] * actionStrategy[i];
+        }
+        
+        auto nextState = state.clone();
+        bool roundOver = false;
+        try {
+            roundOver = nextState->applyAction(validActions[a]);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Error applying action: " + std::string(e.what()));
+            for (auto& range : childValues[a]) {
+                range.assign(numHands, 0.0);
+            }
+            continue;
+        }
+        if (roundOver && !nextState->isTerminal()) {
+            nextState->startNextBettingRound();
+        }
+        
+        publicTreeCfr(*nextState, childReach, childValues[a], depth + 1);
+    }
+    
+    // Opponents' values already carry this player's action probabilities;
+    // the acting player's value is its strategy-weighted mix
+    for (size_t p = 0; p < NUM_PLAYERS; ++p) {
+        double* out = values[p].data();
+        for (size_t a = 0; a < numActions; ++a) {
+            const double* child = childValues[a][p].data();
+            if (p == player) {
+                const double* actionStrategy = &strategy[a * numHands];
+                for (size_t i = 0; i < numHands; ++i) {
+                    out[i] += actionStrategy[i] * child[i];
+                }
+            } else {
+                for (size_t i = 0; i < numHands; ++i) {
+                    out[i] += child[i];
+                }
+            }
+        }
+    }
+    
+    // Counterfactual regrets summed per info set; the table floors the
+    // cumulative regret at zero (CFR+)
+    const double* ownValues = values[player].data();
+    for (size_t i = 0; i < numHands; ++i) {
+        BucketInfoSet& infoSet = infoSets[infoSetOfHand[i]];
+        for (size_t a = 0; a < numActions; ++a) {
+            infoSet.regrets[a] += childValues[a][player][i] - ownValues[i];
+        }
+    }
+    for (const BucketInfoSet& infoSet : infoSets) {
+        for (size_t a = 0; a < numActions; ++a) {
+            regretTable_.addRegret(infoSet.key, validActions[a], infoSet.regrets[a]);
+            if (infoSet.reach > 0.0 && infoSet.strategy[a] > 0.0) {
+                strategyTable_.addToStrategySum(infoSet.key, validActions[a], infoSet.reach * infoSet.strategy[a]);
+            }
+        }
+    }
+}
+
+void CFRSolver::publicTreeTerminal(const GameState& state, const Ranges& reach, Ranges& values) const {
+    bool active[NUM_PLAYERS];
+    int numActive = 0;
+    for (size_t p = 0; p < NUM_PLAYERS; ++p) {
+        active[p] = !state.getPlayerState(static_cast<Position>(p)).folded;
+        numActive += active[p];
+    }
+    
+    // A fold pays the same for every combo; showdowns are scored here, so the
+    // state's own deal is never evaluated
+    std::unordered_map<Position, double> foldPayoffs;
+    if (numActive <= 1) {
+        foldPayoffs = state.getPayoffs();
+    }
+    const double pot = state.getPot();
+    
+    std::vector<double> shares(publicShowdown_.size());
+    std::vector<double> masses(publicShowdown_.size());
+    for (size_t p = 0; p < NUM_PLAYERS; ++p) {
+        const double* opponentReach[RangeShowdown::MAX_OPPONENTS];
+        bool contending[RangeShowdown::MAX_OPPONENTS];
+        int numOpponents = 0;
+        for (size_t o = 0; o < NUM_PLAYERS; ++o) {
+            if (o == p) continue;
+            opponentReach[numOpponents] = reach[o].data();
+            contending[numOpponents++] = active[o];
+        }
+        
+        // Opponent holdings are weighted by reach and exclude cards this
+        // combo holds, including those of folded opponents
+        publicShowdown_.evaluate(opponentReach, contending, shares.data(), masses.data());
+        
+        double* out = values[p].data();
+        // Chips put in over the whole hand, not just this street
+        double bet = STARTING_STACK - state.getPlayerState(static_cast<Position>(p)).stack;
+        if (numActive <= 1 || !active[p]) {
+            double payoff = numActive <= 1 ? foldPayoffs[static_cast<Position>(p)] : -bet;
+            for (size_t i = 0; i < masses.size(); ++i) {
+                out[i] = payoff * masses[i];
+            }
+            continue;
+        }
+        
+        // Showdown on the full board: -bet + pot share, as in GameState::getPayoffs
+        for (size_t i = 0; i < masses.size(); ++i) {
+            out[i] = pot * shares[i] - bet * masses[i];
+        }
+    }
+}
+
 std::vector<Action> CFRSolver::getAbstractedActions(const GameState& state) const {
     // Get valid actions for the current game state
     std::vector<Action> validActions = state.getValidActions();
@@ -542,16 +1036,233 @@ std::string CFRSolver::getAbstractedInfoSet(const GameState& state, Position pos
     
     // Otherwise, apply hand abstraction
     const PlayerState& player = state.getPlayerState(position);
-    int handBucket = handAbstraction_->getBucket(player.holeCards, state.getCommunityCards());
+    int handBucket;
+    {
+        ScopedPhase phase(Phase::BUCKET);
+        handBucket = handAbstraction_->getBucket(player.holeCards, state.getCommunityCards());
+    }
+    
+    return makeInfoSetKey(position, state.getBettingRound(), handBucket,
+                          state.getActionHistory().toString());
+}
+
+std::string CFRSolver::traversalInfoSet(const GameState& state, Position position) const {
+    // Same key as getAbstractedInfoSet, with the bucket looked up by street;
+    // SHOWDOWN plays on the river board
+    const size_t round = std::min<size_t>(static_cast<size_t>(state.getBettingRound()), 3);
+    int handBucket = dealBuckets_[static_cast<size_t>(position)][round];
+    return makeInfoSetKey(position, state.getBettingRound(), handBucket,
+                          state.getActionHistory().toString());
+}
+
+std::string CFRSolver::makeInfoSetKey(Position position, BettingRound round, int handBucket,
+                                      const std::string& actionHistory) {
+    Metrics::increment(Counter::KEYS_BUILT);
     
     // Format: <position>|<round>|<hand_bucket>|<action_history>
-    std::ostringstream oss;
-    oss << positionToString(position) << "|" 
-        << bettingRoundToString(state.getBettingRound()) << "|" 
-        << handBucket << "|"
-        << state.getActionHistory().toString();
+    std::string key = positionToString(position);
+    key += '|';
+    key += bettingRoundToString(round);
+    key += '|';
+    key += std::to_string(handBucket);
+    key += '|';
+    key += actionHistory;
+    return key;
+}
+
+double CFRSolver::estimateExploitability(int sampleCount, uint64_t seed) {
+    if (sampleCount <= 0) {
+        throw std::invalid_argument("Exploitability sample count must be positive");
+    }
+    TRACE_SCOPE("estimate_exploitability");
     
-    return oss.str();
+    // Chance outcomes come from their own stream so training randomness is untouched
+    Xoshiro256 rng = Xoshiro256::forStream(seed, 0, 0);
+    
+    std::vector<DealOutcome> deals(sampleCount);
+    std::vector<DealBuckets> buckets(sampleCount);
+    for (int d = 0; d < sampleCount; ++d) {
+        Deck deck;
+        deals[d] = deck.drawOutcome(rng);
+        buckets[d] = DealPipeline::computeBuckets(*handAbstraction_, deals[d]);
+    }
+    
+    auto root = initialState_->clone();
+    root->reset(deals[0]);
+    root->dealHoleCards();
+    
+    // NashConv: sum over players of (best-response value - value under the average strategy)
+    std::vector<double> reach(sampleCount, 1.0);
+    std::vector<double> brValues;
+    std::vector<double> policyValues;
+    double nashConv = 0.0;
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        bestResponse(*root, static_cast<Position>(p), deals, buckets, reach, brValues, policyValues, 0);
+        for (int d = 0; d < sampleCount; ++d) {
+            nashConv += (brValues[d] - policyValues[d]) / sampleCount;
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        lastExploitability_ = nashConv;
+    }
+    
+    return nashConv;
+}
+
+void CFRSolver::bestResponse(const GameState& state, Position responder,
+                             const std::vector<DealOutcome>& deals, const std::vector<DealBuckets>& buckets,
+                             const std::vector<double>& opponentReach,
+                             std::vector<double>& brValues, std::vector<double>& policyValues,
+                             int depth) const {
+    const size_t numDeals = deals.size();
+    brValues.assign(numDeals, 0.0);
+    policyValues.assign(numDeals, 0.0);
+    
+    if (depth > MAX_RECURSION_DEPTH) {
+        LOG_WARNING("Maximum recursion depth exceeded in bestResponse");
+        return;
+    }
+    
+    if (state.isTerminal()) {
+        int activePlayers = 0;
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            if (!state.getPlayerState(static_cast<Position>(p)).folded) {
+                activePlayers++;
+            }
+        }
+        
+        // Fold: the payoff does not depend on the cards
+        if (activePlayers <= 1) {
+            double payoff = state.getPayoffs()[responder];
+            std::fill(brValues.begin(), brValues.end(), payoff);
+            std::fill(policyValues.begin(), policyValues.end(), payoff);
+            return;
+        }
+        
+        GameState showdown = state;
+        for (size_t d = 0; d < numDeals; ++d) {
+            // Unreachable deals contribute nothing
+            if (opponentReach[d] <= 0.0) {
+                continue;
+            }
+            showdown.setDeal(deals[d]);
+            double payoff = showdown.getPayoffs()[responder];
+            brValues[d] = payoff;
+            policyValues[d] = payoff;
+        }
+        return;
+    }
+    
+    Position currentPosition = state.getCurrentPosition();
+    std::vector<Action> validActions = getAbstractedActions(state);
+    if (validActions.empty()) {
+        return;
+    }
+    if (validActions.size() > MAX_ACTIONS) {
+        throw std::runtime_error("Too many abstracted actions in bestResponse");
+    }
+    const size_t numActions = validActions.size();
+    const size_t round = std::min<size_t>(static_cast<size_t>(state.getBettingRound()), 3);
+    const size_t player = static_cast<size_t>(currentPosition);
+    
+    // Average strategy of the acting player for each deal, [deal][action].
+    // Deals sharing a bucket share the info set, so look each bucket up once.
+    std::vector<double> strategy(numDeals * numActions);
+    std::unordered_map<int, size_t> firstDealInBucket;
+    const std::string history = state.getActionHistory().toString();
+    for (size_t d = 0; d < numDeals; ++d) {
+        int bucket = buckets[d][player][round];
+        auto [it, inserted] = firstDealInBucket.emplace(bucket, d);
+        if (inserted) {
+            strategyTable_.getAverageStrategy(
+                makeInfoSetKey(currentPosition, state.getBettingRound(), bucket, history),
+                validActions, &strategy[d * numActions]);
+        } else {
+            std::copy_n(&strategy[it->second * numActions], numActions, &strategy[d * numActions]);
+        }
+    }
+    
+    // Recurse on every action with the opponents' reach updated per deal
+    std::vector<std::vector<double>> childBr(numActions);
+    std::vector<std::vector<double>> childPolicy(numActions);
+    std::vector<bool> applied(numActions, false);
+    std::vector<double> childReach(numDeals);
+    
+    for (size_t a = 0; a < numActions; ++a) {
+        bool reachable = false;
+        for (size_t d = 0; d < numDeals; ++d) {
+            childReach[d] = currentPosition == responder
+                ? opponentReach[d]
+                : opponentReach[d] * strategy[d * numActions + a];
+            reachable = reachable || childReach[d] > 0.0;
+        }
+        
+        childBr[a].assign(numDeals, 0.0);
+        childPolicy[a].assign(numDeals, 0.0);
+        if (!reachable) {
+            continue;
+        }
+        
+        auto nextState = state.clone();
+        bool roundOver = false;
+        try {
+            roundOver = nextState->applyAction(validActions[a]);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Error applying action: " + std::string(e.what()));
+            continue;
+        }
+        if (roundOver && !nextState->isTerminal()) {
+            nextState->startNextBettingRound();
+        }
+        
+        bestResponse(*nextState, responder, deals, buckets, childReach, childBr[a], childPolicy[a], depth + 1);
+        applied[a] = true;
+    }
+    
+    for (size_t d = 0; d < numDeals; ++d) {
+        for (size_t a = 0; a < numActions; ++a) {
+            policyValues[d] += strategy[d * numActions + a] * childPolicy[a][d];
+        }
+    }
+    
+    if (currentPosition != responder) {
+        for (size_t d = 0; d < numDeals; ++d) {
+            for (size_t a = 0; a < numActions; ++a) {
+                brValues[d] += strategy[d * numActions + a] * childBr[a][d];
+            }
+        }
+        return;
+    }
+    
+    // The responder picks one action per own info set (bucket): the one with the
+    // highest reach-weighted value summed over the deals in that info set
+    std::unordered_map<int, std::array<double, MAX_ACTIONS>> actionTotals;
+    for (size_t d = 0; d < numDeals; ++d) {
+        auto& totals = actionTotals.try_emplace(buckets[d][player][round]).first->second;
+        for (size_t a = 0; a < numActions; ++a) {
+            totals[a] += opponentReach[d] * childBr[a][d];
+        }
+    }
+    
+    std::unordered_map<int, size_t> bestAction;
+    for (const auto& [bucket, totals] : actionTotals) {
+        size_t best = numActions;
+        for (size_t a = 0; a < numActions; ++a) {
+            if (applied[a] && (best == numActions || totals[a] > totals[best])) {
+                best = a;
+            }
+        }
+        bestAction[bucket] = best;
+    }
+    
+    for (size_t d = 0; d < numDeals; ++d) {
+        size_t best = bestAction[buckets[d][player][round]];
+        if (best < numActions) {
+            brValues[d] = childBr[best][d];
+        }
+    }
 }
 
 // In src/cfr/CFRSolver.cpp
@@ -0,0 +1,539 @@
+#include "cfr/Checkpoint.hpp"
+#include "cfr/RegretTable.hpp"
+#include "cfr/StrategyTable.hpp"
+#include "utils/Logger.hpp"
+#include "utils/Trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+constexpr char MAGIC[8] = {'P', 'K', 'R', 'C', 'K', 'P', 'T', '\0'};
+
+enum class CheckpointTable : uint32_t {
+    REGRETS = 0,
+    STRATEGY = 1
+};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t handAbstraction;
+    uint32_t betAbstraction;
+    uint32_t numChunks;
+    uint64_t iteration;
+    uint64_t seed;
+    uint64_t nodesVisited;
+    double trainingMillis;
+    uint64_t directoryOffset;
+    uint64_t directoryChecksum;
+    uint64_t headerChecksum;    // Over all preceding fields
+};
+static_assert(sizeof(FileHeader) == 80, "Checkpoint header layout changed");
+
+struct ChunkInfo {
+    uint32_t table;             // CheckpointTable
+    uint32_t valuesPerSlot;
+    uint64_t offset;
+    uint64_t bytes;
+    uint64_t entries;
+    uint64_t checksum;
+};
+static_assert(sizeof(ChunkInfo) == 40, "Checkpoint directory layout changed");
+
+// One chunk of one table to export
+struct CheckpointJob {
+    uint32_t table;             // CheckpointTable
+    size_t chunk;
+    size_t numChunks;
+};
+
+struct ChunkPrefix {
+    uint32_t numEntries;
+    uint32_t numSlots;
+    uint32_t valuesPerSlot;
+    uint32_t keyPoolBytes;
+};
+
+// Write/read the whole range at offset, retrying short transfers
+bool writeAt(int fd, const void* data, size_t size, uint64_t offset) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = pwrite(fd, bytes, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+    return true;
+}
+
+bool readAt(int fd, void* data, size_t size, uint64_t offset) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t got = pread(fd, bytes, size, static_cast<off_t>(offset));
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (got == 0) {
+            return false;   // Truncated file
+        }
+        bytes += got;
+        size -= static_cast<size_t>(got);
+        offset += static_cast<uint64_t>(got);
+    }
+    return true;
+}
+
+unsigned resolveThreads(unsigned numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return numThreads;
+}
+
+// Run worker(thread) on numThreads threads (inline when there is only one)
+template <typename Worker>
+void runWorkers(unsigned numThreads, Worker worker) {
+    if (numThreads == 1) {
+        worker(0u);
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (unsigned t = 0; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+CheckpointMetadata metadataFromHeader(const FileHeader& header) {
+    CheckpointMetadata metadata;
+    metadata.handAbstraction = header.handAbstraction;
+    metadata.betAbstraction = header.betAbstraction;
+    metadata.iteration = header.iteration;
+    metadata.seed = header.seed;
+    metadata.nodesVisited = header.nodesVisited;
+    metadata.trainingMillis = header.trainingMillis;
+    return metadata;
+}
+
+bool readHeader(int fd, const std::string& filename, FileHeader& header) {
+    if (!readAt(fd, &header, sizeof(header), 0)) {
+        LOG_ERROR("Checkpoint too short: " + filename);
+        return false;
+    }
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        LOG_ERROR("Not a checkpoint file: " + filename);
+        return false;
+    }
+    if (header.version != Checkpoint::VERSION) {
+        LOG_ERROR("Unsupported checkpoint version " + std::to_string(header.version) + ": " + filename);
+        return false;
+    }
+    if (Checkpoint::checksum(&header, offsetof(FileHeader, headerChecksum)) != header.headerChecksum) {
+        LOG_ERROR("Checkpoint header checksum mismatch: " + filename);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// CheckpointChunk implementation
+
+CheckpointChunk::CheckpointChunk(uint32_t valuesPerSlot) : valuesPerSlot_(valuesPerSlot) {
+    if (valuesPerSlot == 0 || valuesPerSlot > 8) {
+        throw std::invalid_argument("Checkpoint values per slot must be in [1, 8]");
+    }
+}
+
+void CheckpointChunk::addEntry(const std::string& key) {
+    if (key.size() > UINT16_MAX) {
+        throw std::runtime_error("Info-set key too long for checkpoint: " + key.substr(0, 64) + "...");
+    }
+    entries_.push_back({static_cast<uint32_t>(keyPool_.size()), static_cast<uint16_t>(key.size()), 0});
+    keyPool_ += key;
+}
+
+void CheckpointChunk::addSlot(const Action& action, const double* values, uint8_t present) {
+    EntryRecord& entry = entries_.back();
+    if (entry.numSlots == UINT16_MAX) {
+        throw std::runtime_error("Too many actions in one checkpoint entry");
+    }
+    entry.numSlots++;
+
+    SlotRecord slot{};
+    slot.amount = action.getAmount();
+    slot.type = static_cast<uint8_t>(action.getType());
+    slot.present = present;
+    slots_.push_back(slot);
+
+    for (uint32_t i = 0; i < valuesPerSlot_; ++i) {
+        values_.push_back((present >> i) & 1 ? values[i] : 0.0);
+    }
+}
+
+void CheckpointChunk::encode(std::vector<char>& out) const {
+    ChunkPrefix prefix{static_cast<uint32_t>(entries_.size()), static_cast<uint32_t>(slots_.size()),
+                       valuesPerSlot_, static_cast<uint32_t>(keyPool_.size())};
+
+    size_t entryBytes = entries_.size() * sizeof(EntryRecord);
+    size_t slotBytes = slots_.size() * sizeof(SlotRecord);
+    size_t valueBytes = values_.size() * sizeof(double);
+    out.resize(sizeof(prefix) + entryBytes + slotBytes + valueBytes + keyPool_.size());
+
+    char* cursor = out.data();
+    auto append = [&cursor](const void* source, size_t bytes) {
+        if (bytes > 0) {
+            std::memcpy(cursor, source, bytes);
+            cursor += bytes;
+        }
+    };
+    append(&prefix, sizeof(prefix));
+    append(entries_.data(), entryBytes);
+    append(slots_.data(), slotBytes);
+    append(values_.data(), valueBytes);
+    append(keyPool_.data(), keyPool_.size());
+}
+
+bool CheckpointChunk::decode(const char* data, size_t size) {
+    ChunkPrefix prefix;
+    if (size < sizeof(prefix)) {
+        return false;
+    }
+    std::memcpy(&prefix, data, sizeof(prefix));
+    if (prefix.valuesPerSlot != valuesPerSlot_) {
+        return false;
+    }
+
+    size_t entryBytes = static_cast<size_t>(prefix.numEntries) * sizeof(EntryRecord);
+    size_t slotBytes = static_cast<size_t>(prefix.numSlots) * sizeof(SlotRecord);
+    size_t valueBytes = static_cast<size_t>(prefix.numSlots) * valuesPerSlot_ * sizeof(double);
+    if (sizeof(prefix) + entryBytes + slotBytes + valueBytes + prefix.keyPoolBytes != size) {
+        return false;
+    }
+
+    const char* cursor = data + sizeof(prefix);
+    auto take = [&cursor](void* target, size_t bytes) {
+        if (bytes > 0) {
+            std::memcpy(target, cursor, bytes);
+            cursor += bytes;
+        }
+    };
+    entries_.resize(prefix.numEntries);
+    take(entries_.data(), entryBytes);
+    slots_.resize(prefix.numSlots);
+    take(slots_.data(), slotBytes);
+    values_.resize(static_cast<size_t>(prefix.numSlots) * valuesPerSlot_);
+    take(values_.data(), valueBytes);
+    keyPool_.assign(cursor, prefix.keyPoolBytes);
+
+    // Records must stay inside the key pool and slot array
+    size_t totalSlots = 0;
+    for (const auto& entry : entries_) {
+        if (static_cast<size_t>(entry.keyOffset) + entry.keyLength > keyPool_.size()) {
+            return false;
+        }
+        totalSlots += entry.numSlots;
+    }
+    return totalSlots == slots_.size();
+}
+
+// Checkpoint implementation
+
+namespace {
+
+// Split each table into bucket-range chunks, at least one per thread
+std::vector<CheckpointJob> planJobs(const RegretTable& regrets, const StrategyTable& strategies,
+                                 unsigned numThreads) {
+    std::vector<CheckpointJob> jobs;
+    auto addJobs = [&](uint32_t table, size_t entries) {
+        size_t numChunks = std::max<size_t>(numThreads, (entries + Checkpoint::ENTRIES_PER_CHUNK - 1) / Checkpoint::ENTRIES_PER_CHUNK);
+        for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+            jobs.push_back({table, chunk, numChunks});
+        }
+    };
+    addJobs(static_cast<uint32_t>(CheckpointTable::REGRETS), regrets.size());
+    addJobs(static_cast<uint32_t>(CheckpointTable::STRATEGY), strategies.size());
+    return jobs;
+}
+
+// Export and encode one job into buffer
+CheckpointSnapshot::Chunk encodeJob(const CheckpointJob& job, const RegretTable& regrets,
+                                    const StrategyTable& strategies, std::vector<char>& buffer) {
+    bool isRegrets = job.table == static_cast<uint32_t>(CheckpointTable::REGRETS);
+    CheckpointChunk chunk(isRegrets ? 1 : 2);
+    if (isRegrets) {
+        regrets.exportChunk(job.chunk, job.numChunks, chunk);
+    } else {
+        strategies.exportChunk(job.chunk, job.numChunks, chunk);
+    }
+    chunk.encode(buffer);
+
+    return {job.table, chunk.valuesPerSlot(), chunk.numEntries(), Checkpoint::checksum(buffer.data(), buffer.size()), {}};
+}
+
+// Write the directory and header after the chunks, sync, and move the file into place
+bool finishFile(int fd, const std::string& tempFile, const std::string& filename,
+                const CheckpointMetadata& metadata, const std::vector<ChunkInfo>& directory,
+                uint64_t directoryOffset, bool chunksWritten) {
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = Checkpoint::VERSION;
+    header.handAbstraction = metadata.handAbstraction;
+    header.betAbstraction = metadata.betAbstraction;
+    header.numChunks = static_cast<uint32_t>(directory.size());
+    header.iteration = metadata.iteration;
+    header.seed = metadata.seed;
+    header.nodesVisited = metadata.nodesVisited;
+    header.trainingMillis = metadata.trainingMillis;
+    header.directoryOffset = directoryOffset;
+    header.directoryChecksum = Checkpoint::checksum(directory.data(), directory.size() * sizeof(ChunkInfo));
+    header.headerChecksum = Checkpoint::checksum(&header, offsetof(FileHeader, headerChecksum));
+
+    bool ok = chunksWritten &&
+              writeAt(fd, directory.data(), directory.size() * sizeof(ChunkInfo), header.directoryOffset) &&
+              writeAt(fd, &header, sizeof(header), 0) &&
+              fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+
+    // Only a complete file replaces the previous checkpoint
+    if (!ok || std::rename(tempFile.c_str(), filename.c_str()) != 0) {
+        LOG_ERROR("Failed to write checkpoint: " + filename);
+        std::remove(tempFile.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+uint64_t Checkpoint::checksum(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ size;
+
+    // OPTIMIZATION: Mix 8 bytes per step so verification keeps up with disk reads
+    auto mix = [](uint64_t value) {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDULL;
+        value ^= value >> 33;
+        return value;
+    };
+
+    size_t words = size / 8;
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i * 8, 8);
+        hash = (hash ^ mix(word)) * 0x9FB21C651E98DF25ULL;
+        hash ^= hash >> 29;
+    }
+
+    uint64_t tail = 0;
+    if (size % 8 != 0) {
+        std::memcpy(&tail, bytes + words * 8, size % 8);
+    }
+    hash = (hash ^ mix(tail)) * 0x9FB21C651E98DF25ULL;
+
+    return mix(hash);
+}
+
+bool Checkpoint::save(const std::string& filename, const CheckpointMetadata& metadata,
+                      const RegretTable& regrets, const StrategyTable& strategies,
+                      unsigned numThreads) {
+    TRACE_SCOPE("checkpoint_save");
+    numThreads = resolveThreads(numThreads);
+    std::vector<CheckpointJob> jobs = planJobs(regrets, strategies, numThreads);
+
+    std::string tempFile = filename + ".tmp";
+    int fd = open(tempFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG_ERROR("Failed to open checkpoint file: " + tempFile);
+        return false;
+    }
+
+    // Chunks stream straight to disk, so memory stays at one chunk per thread
+    std::vector<ChunkInfo> directory(jobs.size());
+    std::atomic<size_t> nextJob{0};
+    std::atomic<uint64_t> nextOffset{sizeof(FileHeader)};
+    std::atomic<bool> failed{false};
+
+    runWorkers(std::min<unsigned>(numThreads, static_cast<unsigned>(jobs.size())), [&](unsigned) {
+        std::vector<char> buffer;
+        for (size_t i = nextJob.fetch_add(1); i < jobs.size() && !failed.load(); i = nextJob.fetch_add(1)) {
+            CheckpointSnapshot::Chunk chunk = encodeJob(jobs[i], regrets, strategies, buffer);
+
+            // Claim space after everything written so far
+            uint64_t offset = nextOffset.fetch_add(buffer.size());
+            directory[i] = {chunk.table, chunk.valuesPerSlot, offset, buffer.size(), chunk.entries, chunk.checksum};
+            if (!writeAt(fd, buffer.data(), buffer.size(), offset)) {
+                failed.store(true);
+            }
+        }
+    });
+
+    return finishFile(fd, tempFile, filename, metadata, directory, nextOffset.load(), !failed.load());
+}
+
+CheckpointSnapshot Checkpoint::capture(const CheckpointMetadata& metadata, const RegretTable& regrets,
+                                       const StrategyTable& strategies, unsigned numThreads) {
+    TRACE_SCOPE("checkpoint_capture");
+    numThreads = resolveThreads(numThreads);
+    std::vector<CheckpointJob> jobs = planJobs(regrets, strategies, numThreads);
+
+    CheckpointSnapshot snapshot;
+    snapshot.metadata = metadata;
+    snapshot.chunks.resize(jobs.size());
+
+    std::atomic<size_t> nextJob{0};
+    runWorkers(std::min<unsigned>(numThreads, static_cast<unsigned>(jobs.size())), [&](unsigned) {
+        for (size_t i = nextJob.fetch_add(1); i < jobs.size(); i = nextJob.fetch_add(1)) {
+            std::vector<char> buffer;
+            snapshot.chunks[i] = encodeJob(jobs[i], regrets, strategies, buffer);
+            snapshot.chunks[i].bytes = std::move(buffer);
+        }
+    });
+
+    return snapshot;
+}
+
+bool Checkpoint::write(const std::string& filename, const CheckpointSnapshot& snapshot) {
+    TRACE_SCOPE("checkpoint_write");
+
+    std::string tempFile = filename + ".tmp";
+    int fd = open(tempFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG_ERROR("Failed to open checkpoint file: " + tempFile);
+        return false;
+    }
+
+    // Sequential writes; this runs off the training thread
+    std::vector<ChunkInfo> directory;
+    directory.reserve(snapshot.chunks.size());
+    uint64_t offset = sizeof(FileHeader);
+    bool ok = true;
+    for (const auto& chunk : snapshot.chunks) {
+        directory.push_back({chunk.table, chunk.valuesPerSlot, offset, chunk.bytes.size(), chunk.entries,
+                             chunk.checksum});
+        ok = ok && writeAt(fd, chunk.bytes.data(), chunk.bytes.size(), offset);
+        offset += chunk.bytes.size();
+    }
+
+    return finishFile(fd, tempFile, filename, snapshot.metadata, directory, offset, ok);
+}
+
+bool Checkpoint::readMetadata(const std::string& filename, CheckpointMetadata& metadata) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("Failed to open checkpoint file: " + filename);
+        return false;
+    }
+
+    FileHeader header;
+    bool ok = readHeader(fd, filename, header);
+    close(fd);
+    if (!ok) {
+        return false;
+    }
+
+    metadata = metadataFromHeader(header);
+    return true;
+}
+
+bool Checkpoint::load(const std::string& filename, CheckpointMetadata& metadata,
+                      RegretTable& regrets, StrategyTable& strategies,
+                      unsigned numThreads) {
+    TRACE_SCOPE("checkpoint_load");
+    numThreads = resolveThreads(numThreads);
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("Failed to open checkpoint file: " + filename);
+        return false;
+    }
+
+    FileHeader header;
+    if (!readHeader(fd, filename, header)) {
+        close(fd);
+        return false;
+    }
+
+    std::vector<ChunkInfo> directory(header.numChunks);
+    if (!readAt(fd, directory.data(), directory.size() * sizeof(ChunkInfo), header.directoryOffset) ||
+        checksum(directory.data(), directory.size() * sizeof(ChunkInfo)) != header.directoryChecksum) {
+        LOG_ERROR("Checkpoint directory is damaged: " + filename);
+        close(fd);
+        return false;
+    }
+
+    // Size the tables once so parallel imports do not rehash repeatedly
+    size_t regretEntries = 0;
+    size_t strategyEntries = 0;
+    for (const auto& info : directory) {
+        (info.table == static_cast<uint32_t>(CheckpointTable::REGRETS) ? regretEntries : strategyEntries) += info.entries;
+    }
+    regrets.clear();
+    strategies.clear();
+    regrets.reserve(regretEntries);
+    strategies.reserve(strategyEntries);
+
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<bool> failed{false};
+
+    // Reading, verifying and decoding run in parallel; each import takes the table's write lock
+    runWorkers(std::min<unsigned>(numThreads, std::max<unsigned>(1, header.numChunks)), [&](unsigned) {
+        std::vector<char> buffer;
+        for (size_t i = nextChunk.fetch_add(1); i < directory.size() && !failed.load(); i = nextChunk.fetch_add(1)) {
+            const ChunkInfo& info = directory[i];
+            bool isRegrets = info.table == static_cast<uint32_t>(CheckpointTable::REGRETS);
+            uint32_t valuesPerSlot = isRegrets ? 1 : 2;
+            buffer.resize(info.bytes);
+
+            CheckpointChunk chunk(valuesPerSlot);
+            if (info.table > static_cast<uint32_t>(CheckpointTable::STRATEGY) ||
+                info.valuesPerSlot != valuesPerSlot ||
+                !readAt(fd, buffer.data(), buffer.size(), info.offset) ||
+                checksum(buffer.data(), buffer.size()) != info.checksum ||
+                !chunk.decode(buffer.data(), buffer.size())) {
+                LOG_ERROR("Checkpoint chunk " + std::to_string(i) + " is damaged: " + filename);
+                failed.store(true);
+                break;
+            }
+
+            if (isRegrets) {
+                regrets.importChunk(chunk);
+            } else {
+                strategies.importChunk(chunk);
+            }
+        }
+    });
+    close(fd);
+
+    if (failed.load()) {
+        regrets.clear();
+        strategies.clear();
+        return false;
+    }
+
+    metadata = metadataFromHeader(header);
+    return true;
+}
+
+} // namespace poker
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "cfr/DealPipeline.hpp"
+#include "utils/Metrics.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace poker {
+
+DealPipeline::DealPipeline(std::shared_ptr<HandAbstraction> handAbstraction, uint64_t masterSeed,
+                           uint64_t firstIteration, uint64_t count, size_t depth, bool withRanges)
+    : handAbstraction_(std::move(handAbstraction)),
+      masterSeed_(masterSeed),
+      firstIteration_(firstIteration),
+      count_(count),
+      depth_(depth),
+      withRanges_(withRanges) {
+    if (!handAbstraction_) {
+        throw std::invalid_argument("Deal pipeline needs a hand abstraction");
+    }
+    if (depth > 0 && count > 0) {
+        queue_ = std::make_unique<MpscRingBuffer<PreparedDeal>>(depth);
+        producer_ = std::thread(&DealPipeline::produce, this);
+    }
+}
+
+DealPipeline::~DealPipeline() {
+    if (producer_.joinable()) {
+        stopRequested_.store(true, std::memory_order_release);
+        notify();
+        producer_.join();
+    }
+}
+
+DealPipeline::DealBuckets DealPipeline::computeBuckets(const HandAbstraction& handAbstraction,
+                                                       const DealOutcome& deal) {
+    const int boardCardsByRound[4] = {0, 3, 4, 5};
+    DealBuckets buckets{};
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        auto holeCards = Deck::toCardSet(deal.holeMask(static_cast<Position>(p)));
+        for (int round = 0; round < 4; ++round) {
+            buckets[p][round] = handAbstraction.getBucket(
+                holeCards, Deck::toCardSet(deal.boardMask(boardCardsByRound[round])));
+        }
+    }
+    return buckets;
+}
+
+DealPipeline::RangeBuckets DealPipeline::computeRangeBuckets(const HandAbstraction& handAbstraction,
+                                                         const DealOutcome& deal,
+                                                         const RangeShowdown& showdown) {
+    const int boardCardsByRound[4] = {0, 3, 4, 5};
+    const std::vector<CardMask>& hands = showdown.hands();
+    RangeBuckets buckets;
+    for (int round = 0; round < 4; ++round) {
+        auto board = Deck::toCardSet(deal.boardMask(boardCardsByRound[round]));
+        buckets[round].resize(hands.size());
+        for (size_t i = 0; i < hands.size(); ++i) {
+            buckets[round][i] = handAbstraction.getBucketUncached(Deck::toCardSet(hands[i]), board);
+        }
+    }
+    return buckets;
+}
+
+void DealPipeline::next(PreparedDeal& prepared) {
+    if (consumed_ == count_) {
+        throw std::logic_error("Deal pipeline has no iterations left");
+    }
+    uint64_t iteration = firstIteration_ + consumed_++;
+
+    if (!producer_.joinable()) {
+        prepare(iteration, prepared);
+        return;
+    }
+
+    // OPTIMIZATION: While the producer is ahead an entry is one lock-free pop;
+    // the trainer only sleeps when the producer has fallen behind
+    if (!queue_->tryPop(prepared)) {
+        Metrics::increment(Counter::DEAL_STALLS);
+        bool ready = false;
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCondition_.wait(lock, [&] {
+            ready = queue_->tryPop(prepared);
+            return ready || producerError_;
+        });
+        if (!ready) {
+            std::rethrow_exception(producerError_);
+        }
+    }
+    notify();
+}
+
+void DealPipeline::prepare(uint64_t iteration, PreparedDeal& prepared) const {
+    ScopedPhase phase(Phase::BUCKET);
+    prepared.iteration = iteration;
+    prepared.stream = Xoshiro256::forStream(masterSeed_, iteration, 0);
+    // Same draw as GameState::reset() on the iteration's stream
+    Deck deck;
+    prepared.deal = deck.drawOutcome(prepared.stream);
+    prepared.buckets = computeBuckets(*handAbstraction_, prepared.deal);
+    if (withRanges_) {
+        prepared.showdown.setBoard(prepared.deal.boardMask(BOARD_SIZE));
+        prepared.rangeBuckets = computeRangeBuckets(*handAbstraction_, prepared.deal, prepared.showdown);
+    }
+}
+
+void DealPipeline::produce() {
+    try {
+        for (uint64_t i = 0; i < count_; ++i) {
+            PreparedDeal prepared;
+            prepare(firstIteration_ + i, prepared);
+            if (!queue_->tryPush(std::move(prepared))) {
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                wakeCondition_.wait(lock, [&] {
+                    return stopRequested_.load(std::memory_order_acquire) || queue_->tryPush(std::move(prepared));
+                });
+            }
+            if (stopRequested_.load(std::memory_order_acquire)) {
+                return;
+            }
+            notify();
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        producerError_ = std::current_exception();
+        wakeCondition_.notify_all();
+    }
+}
+
+void DealPipeline::notify() {
+    // Taking the lock orders this wakeup after a waiter's failed check
+    { std::lock_guard<std::mutex> lock(wakeMutex_); }
+    wakeCondition_.notify_all();
+}
+
+} // namespace poker
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "cfr/RegretTable.hpp"
+#include "cfr/Checkpoint.hpp"
 #include "utils/Serialization.hpp"
+#include "utils/Metrics.hpp"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
@@ -12,20 +14,42 @@ RegretTable::RegretTable() {
 }
 
 void RegretTable::addRegret(const std::string& infoSet, const Action& action, double regret) {
+    Metrics::increment(Counter::REGRET_WRITES);
+    
     // Write lock for thread safety
     std::unique_lock<std::shared_mutex> lock(mutex_);
     
+    // OPTIMIZATION: One outer lookup for the whole update
+    auto [it, inserted] = regrets_.try_emplace(infoSet);
+    Entry& entry = it->second;
+    size_t mapBytesBefore = TableMemory::actionMapBytes(entry.regrets);
+    
     // Add the regret to the existing value
-    regrets_[infoSet][action] += regret;
+    double& value = entry.regrets[action];
+    value += regret;
     
     // CFR+ modification: ensure regrets are non-negative
     // This helps with convergence speed
-    if (regrets_[infoSet][action] < 0) {
-        regrets_[infoSet][action] = 0;
+    if (value < 0) {
+        value = 0;
+    }
+    
+    entry.meta.touch(epoch_.load(std::memory_order_relaxed));
+    entry.meta.visits.fetch_add(1, std::memory_order_relaxed);
+    
+    // Account for the new node / rehash of the action map (and the entry itself)
+    size_t added = TableMemory::actionMapBytes(entry.regrets) - mapBytesBefore;
+    if (inserted) {
+        added += TableMemory::entryNodeBytes<InfoSetRegretMap>(it->first);
+    }
+    if (added != 0) {
+        entryBytes_.fetch_add(added, std::memory_order_relaxed);
     }
 }
 
 double RegretTable::getRegret(const std::string& infoSet, const Action& action) const {
+    Metrics::increment(Counter::REGRET_READS);
+    
     // Read lock for thread safety
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
@@ -36,7 +60,8 @@ double RegretTable::getRegret(const std::string& infoSet, const Action& action)
     }
     
     // Check if the action exists in this info set
-    const auto& actionRegrets = infoSetIt->second;
+    const auto& actionRegrets = infoSetIt->second.regrets;
+    infoSetIt->second.meta.touch(epoch_.load(std::memory_order_relaxed));
     auto actionIt = actionRegrets.find(action);
     if (actionIt == actionRegrets.end()) {
         return 0.0;
@@ -56,7 +81,29 @@ RegretTable::getRegrets(const std::string& infoSet) const {
         return {};
     }
     
-    return it->second;
+    it->second.meta.touch(epoch_.load(std::memory_order_relaxed));
+    return it->second.regrets;
+}
+
+void RegretTable::getRegrets(const std::string& infoSet, const std::vector<Action>& actions,
+                             double* out) const {
+    Metrics::increment(Counter::REGRET_READS);
+    
+    // Read lock for thread safety
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    auto it = regrets_.find(infoSet);
+    if (it == regrets_.end()) {
+        std::fill(out, out + actions.size(), 0.0);
+        return;
+    }
+    
+    it->second.meta.touch(epoch_.load(std::memory_order_relaxed));
+    const auto& actionRegrets = it->second.regrets;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        auto actionIt = actionRegrets.find(actions[i]);
+        out[i] = actionIt != actionRegrets.end() ? actionIt->second : 0.0;
+    }
 }
 
 bool RegretTable::hasInfoSet(const std::string& infoSet) const {
@@ -71,6 +118,8 @@ void RegretTable::clear() {
     std::unique_lock<std::shared_mutex> lock(mutex_);
     
     regrets_.clear();
+    entryBytes_.store(0, std::memory_order_relaxed);
+    clockHand_ = 0;
 }
 
 size_t RegretTable::size() const {
@@ -85,7 +134,8 @@ bool RegretTable::saveToFile(const std::string& filename) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
     // Use the Serialization utility to save the regrets
-    return Serialization::saveToFile<double, ActionHash>(regrets_, filename);
+    return Serialization::saveToFile(regrets_, filename,
+                                     [](const Entry& entry) -> const ActionRegretMap& { return entry.regrets; });
 }
 
 bool RegretTable::loadFromFile(const std::string& filename) {
@@ -93,7 +143,18 @@ bool RegretTable::loadFromFile(const std::string& filename) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
     
     // Use the Serialization utility to load the regrets
-    return Serialization::loadFromFile<double, ActionHash>(regrets_, filename);
+    regrets_.clear();
+    bool loaded = Serialization::loadFromFile<double, ActionHash>(
+        regrets_, filename, [](Entry& entry, ActionRegretMap&& regrets) { entry.regrets = std::move(regrets); });
+    
+    size_t total = 0;
+    for (const auto& [infoSet, entry] : regrets_) {
+        total += entryBytes(infoSet, entry);
+    }
+    entryBytes_.store(total, std::memory_order_relaxed);
+    clockHand_ = 0;
+    
+    return loaded;
 }
 
 std::vector<std::string> RegretTable::getAllInfoSets() const {
@@ -118,7 +179,8 @@ void RegretTable::prune(double threshold) {
     std::vector<std::string> infoSetsToRemove;
     
     // Find info sets where all regrets are below threshold
-    for (const auto& [infoSet, actionRegrets] : regrets_) {
+    for (const auto& [infoSet, entry] : regrets_) {
+        const auto& actionRegrets = entry.regrets;
         bool allSmall = true;
         double maxRegret = 0.0;
         
@@ -138,8 +200,108 @@ void RegretTable::prune(double threshold) {
     
     // Remove the identified info sets
     for (const auto& infoSet : infoSetsToRemove) {
-        regrets_.erase(infoSet);
+        auto it = regrets_.find(infoSet);
+        entryBytes_.fetch_sub(entryBytes(it->first, it->second), std::memory_order_relaxed);
+        regrets_.erase(it);
+    }
+}
+
+size_t RegretTable::entryBytes(const std::string& infoSet, const Entry& entry) {
+    return TableMemory::entryNodeBytes<InfoSetRegretMap>(infoSet) + TableMemory::actionMapBytes(entry.regrets);
+}
+
+size_t RegretTable::memoryBytes() const {
+    // Read lock for thread safety
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    return entryBytes_.load(std::memory_order_relaxed) + TableMemory::bucketArrayBytes(regrets_);
+}
+
+TableFootprint RegretTable::footprint() const {
+    // Read lock for thread safety
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    TableFootprint footprint;
+    footprint.name = "regrets";
+    for (const auto& [infoSet, entry] : regrets_) {
+        TableMemory::addEntryNode<InfoSetRegretMap>(footprint, infoSet);
+        TableMemory::addActionMap(footprint, entry.regrets);
     }
+    TableMemory::addBucketArray(footprint, regrets_);
+    
+    return footprint;
+}
+
+TableFootprint RegretTable::estimateEntry(size_t keyLength, size_t numActions) {
+    // Build a representative entry so node and bucket sizes match the real layout
+    Entry entry;
+    for (size_t i = 0; i < numActions; ++i) {
+        entry.regrets[Action::raise(static_cast<double>(i + 1))] = 0.0;
+    }
+    
+    TableFootprint footprint;
+    footprint.name = "regrets";
+    TableMemory::addEntryNode<InfoSetRegretMap>(footprint, std::string(keyLength, ' '));
+    TableMemory::addActionMap(footprint, entry.regrets);
+    
+    return footprint;
+}
+
+void RegretTable::exportChunk(size_t chunk, size_t numChunks, CheckpointChunk& out) const {
+    // Read lock for thread safety (several chunks may export concurrently)
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    size_t bucketCount = regrets_.bucket_count();
+    size_t first = bucketCount * chunk / numChunks;
+    size_t last = bucketCount * (chunk + 1) / numChunks;
+    for (size_t bucket = first; bucket < last; ++bucket) {
+        for (auto it = regrets_.begin(bucket); it != regrets_.end(bucket); ++it) {
+            out.addEntry(it->first);
+            for (const auto& [action, regret] : it->second.regrets) {
+                out.addSlot(action, &regret, 1);
+            }
+        }
+    }
+}
+
+void RegretTable::importChunk(const CheckpointChunk& chunk) {
+    // Write lock for thread safety
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    
+    chunk.forEachEntry([this](std::string key, const CheckpointChunk::SlotRecord* slots,
+                              const double* values, size_t numSlots) {
+        auto [it, inserted] = regrets_.try_emplace(std::move(key));
+        if (!inserted) {
+            entryBytes_.fetch_sub(entryBytes(it->first, it->second), std::memory_order_relaxed);
+        }
+        
+        Entry& entry = it->second;
+        entry.regrets.clear();
+        entry.regrets.reserve(numSlots);
+        for (size_t i = 0; i < numSlots; ++i) {
+            entry.regrets[CheckpointChunk::slotAction(slots[i])] = values[i];
+        }
+        entryBytes_.fetch_add(entryBytes(it->first, entry), std::memory_order_relaxed);
+    });
+}
+
+void RegretTable::reserve(size_t entries) {
+    // Write lock for thread safety
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    
+    regrets_.reserve(entries);
+}
+
+size_t RegretTable::evict(size_t bytesToFree, size_t maxBuckets) {
+    // Write lock for thread safety (held for at most maxBuckets buckets)
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    
+    size_t evicted = 0;
+    size_t freed = TableMemory::clockEvict(regrets_, clockHand_, bytesToFree, maxBuckets, entryBytes, evicted);
+    entryBytes_.fetch_sub(freed, std::memory_order_relaxed);
+    Metrics::increment(Counter::EVICTIONS, evicted);
+    
+    return freed;
 }
 
 // ActionHash implementation
@@ -1,5 +1,7 @@
 #include "cfr/StrategyTable.hpp"
+#include "cfr/Checkpoint.hpp"
 #include "utils/Serialization.hpp"
+#include "utils/Metrics.hpp"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
@@ -11,12 +13,33 @@ StrategyTable::StrategyTable() {
     // Nothing to initialize
 }
 
-void StrategyTable::setStrategy(const std::string& infoSet, const Action& action, double probability) {
+template <typename Update>
+void StrategyTable::updateEntry(const std::string& infoSet, Update update) {
     // Write lock for thread safety
     std::unique_lock<std::shared_mutex> lock(mutex_);
     
+    // OPTIMIZATION: One outer lookup for the whole update
+    auto [it, inserted] = strategies_.try_emplace(infoSet);
+    Entry& entry = it->second;
+    size_t bytesBefore = inserted ? 0 : entryBytes(it->first, entry);
+    
+    update(entry);
+    
+    entry.meta.touch(epoch_.load(std::memory_order_relaxed));
+    entry.meta.visits.fetch_add(1, std::memory_order_relaxed);
+    
+    // Account for new nodes / rehashes of the action maps (and the entry itself)
+    size_t added = entryBytes(it->first, entry) - bytesBefore;
+    if (added != 0) {
+        entryBytes_.fetch_add(added, std::memory_order_relaxed);
+    }
+}
+
+void StrategyTable::setStrategy(const std::string& infoSet, const Action& action, double probability) {
+    Metrics::increment(Counter::STRATEGY_WRITES);
+    
     // Set the strategy probability
-    currentStrategy_[infoSet][action] = probability;
+    updateEntry(infoSet, [&](Entry& entry) { entry.current[action] = probability; });
 }
 
 double StrategyTable::getStrategy(const std::string& infoSet, const Action& action) const {
@@ -24,13 +47,14 @@ double StrategyTable::getStrategy(const std::string& infoSet, const Action& acti
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
     // Check if the info set exists
-    auto infoSetIt = currentStrategy_.find(infoSet);
-    if (infoSetIt == currentStrategy_.end()) {
+    auto infoSetIt = strategies_.find(infoSet);
+    if (infoSetIt == strategies_.end()) {
         return 0.0;
     }
     
     // Check if the action exists in this info set
-    const auto& actionStrategies = infoSetIt->second;
+    infoSetIt->second.meta.touch(epoch_.load(std::memory_order_relaxed));
+    const auto& actionStrategies = infoSetIt->second.current;
     auto actionIt = actionStrategies.find(action);
     if (actionIt == actionStrategies.end()) {
         return 0.0;
@@ -45,20 +69,20 @@ StrategyTable::getStrategies(const std::string& infoSet) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
     // Check if the info set exists
-    auto it = currentStrategy_.find(infoSet);
-    if (it == currentStrategy_.end()) {
+    auto it = strategies_.find(infoSet);
+    if (it == strategies_.end()) {
         return {};
     }
     
-    return it->second;
+    it->second.meta.touch(epoch_.load(std::memory_order_relaxed));
+    return it->second.current;
 }
 
 void StrategyTable::addToStrategySum(const std::string& infoSet, const Action& action, double probability) {
-    // Write lock for thread safety
-    std::unique_lock<std::shared_mutex> lock(mutex_);
+    Metrics::increment(Counter::STRATEGY_WRITES);
     
     // Add the probability to the strategy sum
-    strategySum_[infoSet][action] += probability;
+    updateEntry(infoSet, [&](Entry& entry) { entry.sum[action] += probability; });
 }
 
 double StrategyTable::getAverageStrategy(const std::string& infoSet, const Action& action) const {
@@ -66,13 +90,14 @@ double StrategyTable::getAverageStrategy(const std::string& infoSet, const Actio
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
     // Check if the info set exists in strategy sum
-    auto infoSetIt = strategySum_.find(infoSet);
-    if (infoSetIt == strategySum_.end()) {
+    auto infoSetIt = strategies_.find(infoSet);
+    if (infoSetIt == strategies_.end()) {
         return 0.0;
     }
     
     // Check if the action exists in this info set
-    const auto& actionSums = infoSetIt->second;
+    infoSetIt->second.meta.touch(epoch_.load(std::memory_order_relaxed));
+    const auto& actionSums = infoSetIt->second.sum;
     auto actionIt = actionSums.find(action);
     if (actionIt == actionSums.end()) {
         return 0.0;
@@ -99,12 +124,13 @@ StrategyTable::getAverageStrategies(const std::string& infoSet) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
     // Check if the info set exists in strategy sum
-    auto infoSetIt = strategySum_.find(infoSet);
-    if (infoSetIt == strategySum_.end()) {
+    auto infoSetIt = strategies_.find(infoSet);
+    if (infoSetIt == strategies_.end() || infoSetIt->second.sum.empty()) {
         return {};
     }
     
-    const auto& actionSums = infoSetIt->second;
+    infoSetIt->second.meta.touch(epoch_.load(std::memory_order_relaxed));
+    const auto& actionSums = infoSetIt->second.sum;
     
     // Calculate the sum of all probabilities for this info set
     double sum = 0.0;
@@ -131,26 +157,62 @@ StrategyTable::getAverageStrategies(const std::string& infoSet) const {
     return averageStrategies;
 }
 
+bool StrategyTable::getAverageStrategy(const std::string& infoSet, const std::vector<Action>& actions,
+                                       double* out) const {
+    if (actions.empty()) {
+        return false;
+    }
+    Metrics::increment(Counter::STRATEGY_READS);
+    
+    // Read lock for thread safety
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    double sum = 0.0;
+    auto it = strategies_.find(infoSet);
+    bool visited = it != strategies_.end() && !it->second.sum.empty();
+    if (visited) {
+        it->second.meta.touch(epoch_.load(std::memory_order_relaxed));
+        const auto& actionSums = it->second.sum;
+        for (size_t i = 0; i < actions.size(); ++i) {
+            auto actionIt = actionSums.find(actions[i]);
+            out[i] = actionIt != actionSums.end() && actionIt->second > 0.0 ? actionIt->second : 0.0;
+            sum += out[i];
+        }
+    }
+    
+    if (sum > 0.0) {
+        for (size_t i = 0; i < actions.size(); ++i) {
+            out[i] /= sum;
+        }
+    } else {
+        std::fill(out, out + actions.size(), 1.0 / actions.size());
+    }
+    
+    return visited;
+}
+
 bool StrategyTable::hasInfoSet(const std::string& infoSet) const {
     // Read lock for thread safety
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
-    return currentStrategy_.find(infoSet) != currentStrategy_.end();
+    auto it = strategies_.find(infoSet);
+    return it != strategies_.end() && !it->second.current.empty();
 }
 
 void StrategyTable::clear() {
     // Write lock for thread safety
     std::unique_lock<std::shared_mutex> lock(mutex_);
     
-    currentStrategy_.clear();
-    strategySum_.clear();
+    strategies_.clear();
+    entryBytes_.store(0, std::memory_order_relaxed);
+    clockHand_ = 0;
 }
 
 size_t StrategyTable::size() const {
     // Read lock for thread safety
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
-    return currentStrategy_.size();
+    return strategies_.size();
 }
 
 bool StrategyTable::saveToFile(const std::string& filename) const {
@@ -161,8 +223,10 @@ bool StrategyTable::saveToFile(const std::string& filename) const {
     std::string currentStrategyFile = filename + ".current";
     std::string strategySumFile = filename + ".sum";
     
-    bool currentSaved = Serialization::saveToFile<double, ActionHash>(currentStrategy_, currentStrategyFile);
-    bool sumSaved = Serialization::saveToFile<double, ActionHash>(strategySum_, strategySumFile);
+    bool currentSaved = Serialization::saveToFile(strategies_, currentStrategyFile,
+                                                  [](const Entry& entry) -> const ActionStrategyMap& { return entry.current; });
+    bool sumSaved = Serialization::saveToFile(strategies_, strategySumFile,
+                                              [](const Entry& entry) -> const ActionStrategyMap& { return entry.sum; });
     
     return currentSaved && sumSaved;
 }
@@ -175,8 +239,19 @@ bool StrategyTable::loadFromFile(const std::string& filename) {
     std::string currentStrategyFile = filename + ".current";
     std::string strategySumFile = filename + ".sum";
     
-    bool currentLoaded = Serialization::loadFromFile<double, ActionHash>(currentStrategy_, currentStrategyFile);
-    bool sumLoaded = Serialization::loadFromFile<double, ActionHash>(strategySum_, strategySumFile);
+    // Both files fill the same entries
+    strategies_.clear();
+    bool currentLoaded = Serialization::loadFromFile<double, ActionHash>(
+        strategies_, currentStrategyFile, [](Entry& entry, ActionStrategyMap&& map) { entry.current = std::move(map); });
+    bool sumLoaded = Serialization::loadFromFile<double, ActionHash>(
+        strategies_, strategySumFile, [](Entry& entry, ActionStrategyMap&& map) { entry.sum = std::move(map); });
+    
+    size_t total = 0;
+    for (const auto& [infoSet, entry] : strategies_) {
+        total += entryBytes(infoSet, entry);
+    }
+    entryBytes_.store(total, std::memory_order_relaxed);
+    clockHand_ = 0;
     
     return currentLoaded && sumLoaded;
 }
@@ -186,15 +261,139 @@ std::vector<std::string> StrategyTable::getAllInfoSets() const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
     std::vector<std::string> infoSets;
-    infoSets.reserve(currentStrategy_.size());
+    infoSets.reserve(strategies_.size());
     
-    for (const auto& pair : currentStrategy_) {
+    for (const auto& pair : strategies_) {
         infoSets.push_back(pair.first);
     }
     
     return infoSets;
 }
 
+size_t StrategyTable::entryBytes(const std::string& infoSet, const Entry& entry) {
+    return TableMemory::entryNodeBytes<InfoSetStrategyMap>(infoSet) +
+           TableMemory::actionMapBytes(entry.current) + TableMemory::actionMapBytes(entry.sum);
+}
+
+size_t StrategyTable::memoryBytes() const {
+    // Read lock for thread safety
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    return entryBytes_.load(std::memory_order_relaxed) + TableMemory::bucketArrayBytes(strategies_);
+}
+
+StrategyTable::Footprint StrategyTable::footprint() const {
+    // Read lock for thread safety
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    Footprint footprint;
+    footprint.current.name = "strategy.current";
+    footprint.sum.name = "strategy.sum";
+    for (const auto& [infoSet, entry] : strategies_) {
+        TableMemory::addEntryNode<InfoSetStrategyMap>(footprint.current, infoSet);
+        TableMemory::addActionMap(footprint.current, entry.current);
+        TableMemory::addActionMap(footprint.sum, entry.sum);
+        if (!entry.sum.empty()) {
+            footprint.sum.entries++;
+        }
+    }
+    TableMemory::addBucketArray(footprint.current, strategies_);
+    
+    return footprint;
+}
+
+TableFootprint StrategyTable::estimateEntry(size_t keyLength, size_t numActions) {
+    // Build a representative entry so node and bucket sizes match the real layout
+    Entry entry;
+    for (size_t i = 0; i < numActions; ++i) {
+        Action action = Action::raise(static_cast<double>(i + 1));
+        entry.current[action] = 0.0;
+        entry.sum[action] = 0.0;
+    }
+    
+    TableFootprint footprint;
+    footprint.name = "strategy";
+    TableMemory::addEntryNode<InfoSetStrategyMap>(footprint, std::string(keyLength, ' '));
+    TableMemory::addActionMap(footprint, entry.current);
+    TableMemory::addActionMap(footprint, entry.sum);
+    
+    return footprint;
+}
+
+void StrategyTable::exportChunk(size_t chunk, size_t numChunks, CheckpointChunk& out) const {
+    // Read lock for thread safety (several chunks may export concurrently)
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    size_t bucketCount = strategies_.bucket_count();
+    size_t first = bucketCount * chunk / numChunks;
+    size_t last = bucketCount * (chunk + 1) / numChunks;
+    for (size_t bucket = first; bucket < last; ++bucket) {
+        for (auto it = strategies_.begin(bucket); it != strategies_.end(bucket); ++it) {
+            const Entry& entry = it->second;
+            out.addEntry(it->first);
+            
+            // One slot per action in either map
+            for (const auto& [action, probability] : entry.current) {
+                auto sumIt = entry.sum.find(action);
+                double values[2] = {probability, sumIt != entry.sum.end() ? sumIt->second : 0.0};
+                out.addSlot(action, values, sumIt != entry.sum.end() ? 3 : 1);
+            }
+            for (const auto& [action, sum] : entry.sum) {
+                if (entry.current.find(action) == entry.current.end()) {
+                    double values[2] = {0.0, sum};
+                    out.addSlot(action, values, 2);
+                }
+            }
+        }
+    }
+}
+
+void StrategyTable::importChunk(const CheckpointChunk& chunk) {
+    // Write lock for thread safety
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    
+    chunk.forEachEntry([this](std::string key, const CheckpointChunk::SlotRecord* slots,
+                              const double* values, size_t numSlots) {
+        auto [it, inserted] = strategies_.try_emplace(std::move(key));
+        if (!inserted) {
+            entryBytes_.fetch_sub(entryBytes(it->first, it->second), std::memory_order_relaxed);
+        }
+        
+        Entry& entry = it->second;
+        entry.current.clear();
+        entry.sum.clear();
+        for (size_t i = 0; i < numSlots; ++i) {
+            Action action = CheckpointChunk::slotAction(slots[i]);
+            if (slots[i].present & 1) {
+                entry.current[action] = values[2 * i];
+            }
+            if (slots[i].present & 2) {
+                entry.sum[action] = values[2 * i + 1];
+            }
+        }
+        entryBytes_.fetch_add(entryBytes(it->first, entry), std::memory_order_relaxed);
+    });
+}
+
+void StrategyTable::reserve(size_t entries) {
+    // Write lock for thread safety
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    
+    strategies_.reserve(entries);
+}
+
+size_t StrategyTable::evict(size_t bytesToFree, size_t maxBuckets) {
+    // Write lock for thread safety (held for at most maxBuckets buckets)
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    
+    size_t evicted = 0;
+    size_t freed = TableMemory::clockEvict(strategies_, clockHand_, bytesToFree, maxBuckets, entryBytes, evicted);
+    entryBytes_.fetch_sub(freed, std::memory_order_relaxed);
+    Metrics::increment(Counter::EVICTIONS, evicted);
+    
+    return freed;
+}
+
 // ActionHash implementation
 std::size_t StrategyTable::ActionHash::operator()(const Action& action) const {
     // Combine the action type and amount into a single hash value
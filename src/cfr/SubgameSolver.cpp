@@ -0,0 +1,444 @@
+#include "cfr/SubgameSolver.hpp"
+#include "cfr/CFRSolver.hpp"
+#include "game/Deck.hpp"
+#include "utils/ActionSampler.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace poker {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int BOARD_CARDS_BY_ROUND[4] = {0, 3, 4, 5};
+
+size_t roundIndex(BettingRound round) {
+    return std::min<size_t>(static_cast<size_t>(round), 3);
+}
+
+// Apply an action and open the next street if the round closed; true if it did
+bool advance(GameState& state, const Action& action) {
+    bool roundOver = state.applyAction(action);
+    if (roundOver && !state.isTerminal()) {
+        state.startNextBettingRound();
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+SubgameSolver::SubgameSolver(const StrategyTable& blueprint,
+                             std::shared_ptr<HandAbstraction> handAbstraction,
+                             std::shared_ptr<BetAbstraction> blueprintBets,
+                             std::shared_ptr<BetAbstraction> subgameBets)
+    : SubgameSolver(blueprint, std::move(handAbstraction), std::move(blueprintBets), std::move(subgameBets),
+                    Options()) {}
+
+SubgameSolver::SubgameSolver(const StrategyTable& blueprint,
+                             std::shared_ptr<HandAbstraction> handAbstraction,
+                             std::shared_ptr<BetAbstraction> blueprintBets,
+                             std::shared_ptr<BetAbstraction> subgameBets,
+                             Options options)
+    : blueprint_(blueprint),
+      handAbstraction_(std::move(handAbstraction)),
+      blueprintBets_(std::move(blueprintBets)),
+      subgameBets_(std::move(subgameBets)),
+      options_(options) {
+    if (!handAbstraction_ || !blueprintBets_ || !subgameBets_) {
+        throw std::invalid_argument("Subgame solver needs hand and bet abstractions");
+    }
+    if (options_.numDeals <= 0 || options_.rolloutsPerLeaf <= 0 || options_.maxNodes == 0 ||
+        options_.maxIterations <= 0 || options_.lookaheadRounds < 0 || options_.timeBudgetMs < 0.0) {
+        throw std::invalid_argument("Invalid subgame solver options");
+    }
+}
+
+SubgameSolver::Result SubgameSolver::solve(const GameState& state) {
+    auto start = Clock::now();
+    auto budget = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(options_.timeBudgetMs));
+    auto deadline = start + budget;
+    setupDeadline_ = start + budget / 2;
+
+    if (state.isTerminal()) {
+        throw std::invalid_argument("Cannot re-solve a terminal state");
+    }
+
+    nodes_.clear();
+    numLeaves_ = 0;
+    sampleBeliefs(state);
+    buildTree(state.clone(), rootHistory_, options_.lookaheadRounds);
+
+    // Chance sampling: one deal per iteration, drawn by belief weight
+    AliasTable dealSampler(beliefWeights_.data(), beliefWeights_.size());
+    Xoshiro256 rng = Xoshiro256::forStream(options_.seed, 0, 0);
+
+    int iterations = 0;
+    do {
+        size_t deal = dealSampler.sample(rng);
+        Values reach;
+        reach.fill(1.0);
+
+        // Linear averaging: iteration t contributes with weight t
+        traverse(0, deal, reach, static_cast<double>(iterations + 1));
+        ++iterations;
+    } while (iterations < options_.maxIterations && Clock::now() < deadline);
+
+    Result result;
+    const Node& root = nodes_[0];
+    result.actions = root.actions;
+    result.probabilities.assign(root.actions.size(), 1.0 / root.actions.size());
+
+    // Every deal holds the acting player's real hand, so any deal gives its bucket
+    int bucket = dealBuckets_[0][static_cast<size_t>(root.player)][root.round];
+    auto it = root.infoSets.find(bucket);
+    if (it != root.infoSets.end()) {
+        const auto& sums = it->second.strategySum;
+        double total = std::accumulate(sums.begin(), sums.end(), 0.0);
+        if (total > 0.0) {
+            for (size_t a = 0; a < sums.size(); ++a) {
+                result.probabilities[a] = sums[a] / total;
+            }
+        }
+    }
+
+    result.iterations = iterations;
+    result.deals = static_cast<int>(deals_.size());
+    result.nodes = nodes_.size();
+    result.leaves = numLeaves_;
+    result.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    LOG_DEBUG("Subgame solved: " + std::to_string(iterations) + " iterations, " +
+              std::to_string(result.nodes) + " nodes, " + std::to_string(result.elapsedMs) + " ms");
+    return result;
+}
+
+void SubgameSolver::sampleBeliefs(const GameState& state) {
+    const Position hero = state.getCurrentPosition();
+    const DealOutcome& actual = state.getDeal();
+    const int revealed = BOARD_CARDS_BY_ROUND[roundIndex(state.getBettingRound())];
+    const CardMask known = actual.holeMask(hero) | actual.boardMask(revealed);
+
+    // Opponent hole cards and the unrevealed board are redrawn per deal
+    Xoshiro256 rng = Xoshiro256::forStream(options_.seed, 0, 1);
+    size_t numDeals = static_cast<size_t>(options_.numDeals);
+    deals_.assign(numDeals, actual);
+    dealBuckets_.resize(numDeals);
+    for (size_t d = 0; d < numDeals; ++d) {
+        // Out of setup time: solve over the deals drawn so far
+        if (d >= static_cast<size_t>(MIN_DEALS) && Clock::now() >= setupDeadline_) {
+            LOG_DEBUG("Subgame setup deadline: " + std::to_string(d) + " of " + std::to_string(numDeals) + " deals");
+            numDeals = d;
+            deals_.resize(numDeals);
+            dealBuckets_.resize(numDeals);
+            break;
+        }
+
+        DealOutcome& deal = deals_[d];
+        uint8_t cards[HOLE_CARDS_PER_PLAYER * NUM_PLAYERS + BOARD_SIZE];
+        int needed = HOLE_CARDS_PER_PLAYER * (NUM_PLAYERS - 1) + (BOARD_SIZE - revealed);
+        Deck deck(known);
+        deck.draw(cards, needed, rng);
+
+        int next = 0;
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            if (static_cast<Position>(p) == hero) continue;
+            for (auto& card : deal.holeCards[static_cast<size_t>(p)]) {
+                card = cards[next++];
+            }
+        }
+        for (int i = revealed; i < BOARD_SIZE; ++i) {
+            deal.board[i] = cards[next++];
+        }
+
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            auto holeCards = Deck::toCardSet(deal.holeMask(static_cast<Position>(p)));
+            for (int round = 0; round < 4; ++round) {
+                dealBuckets_[d][p][round] = handAbstraction_->getBucket(
+                    holeCards, Deck::toCardSet(deal.boardMask(BOARD_CARDS_BY_ROUND[round])));
+            }
+        }
+    }
+
+    // Replay the hand to recover every opponent decision: acting position,
+    // street, blueprint history so far, blueprint actions and the one taken.
+    // The hero's own actions weigh every deal equally and are skipped.
+    struct Observed {
+        Position position;
+        BettingRound round;
+        std::string history;
+        std::vector<Action> actions;
+        size_t taken;
+    };
+    std::vector<Observed> observed;
+
+    GameState replay;
+    replay.reset(actual);
+    replay.dealHoleCards();
+    rootHistory_.clear();
+    for (const auto& [position, action] : state.getActionHistory().getActions()) {
+        if (replay.isTerminal()) {
+            break;
+        }
+        std::vector<Action> actions = blueprintActions(replay);
+        size_t taken = nearestAction(actions, action);
+        if (position != hero && taken < actions.size()) {
+            observed.push_back({position, replay.getBettingRound(), rootHistory_.toString(), actions, taken});
+        }
+
+        rootHistory_.addAction(position, taken < actions.size() ? actions[taken] : action);
+        if (advance(replay, action)) {
+            rootHistory_.startNewRound();
+        }
+    }
+
+    // Belief weight of a deal: product of the blueprint's probabilities of the
+    // observed actions. Deals sharing a bucket share the lookup.
+    beliefWeights_.assign(numDeals, 1.0);
+    std::vector<double> policy;
+    for (const auto& step : observed) {
+        std::unordered_map<int, double> takenProbability;
+        policy.resize(step.actions.size());
+        for (size_t d = 0; d < numDeals; ++d) {
+            int bucket = dealBuckets_[d][static_cast<size_t>(step.position)][roundIndex(step.round)];
+            auto [it, inserted] = takenProbability.emplace(bucket, 0.0);
+            if (inserted) {
+                blueprintPolicy(step.position, step.round, bucket, step.history, step.actions, policy.data());
+                it->second = policy[step.taken];
+            }
+            beliefWeights_[d] *= it->second;
+        }
+    }
+
+    // The blueprint never takes this line with any sampled hand; fall back
+    // to uniform beliefs rather than solving nothing
+    if (std::all_of(beliefWeights_.begin(), beliefWeights_.end(), [](double w) { return w <= 0.0; })) {
+        LOG_DEBUG("Observed line has no blueprint support; using uniform beliefs");
+        std::fill(beliefWeights_.begin(), beliefWeights_.end(), 1.0);
+    }
+}
+
+size_t SubgameSolver::buildTree(std::unique_ptr<GameState> state, const ActionHistory& history, int roundsLeft) {
+    if (state->isTerminal()) {
+        return addValueNode(NodeKind::TERMINAL, std::move(state), history);
+    }
+    // Past the node cap or the setup deadline the blueprint takes over (the
+    // root is always a decision)
+    if (!nodes_.empty() && (nodes_.size() >= options_.maxNodes || Clock::now() >= setupDeadline_)) {
+        return addValueNode(NodeKind::LEAF, std::move(state), history);
+    }
+
+    size_t index = nodes_.size();
+    nodes_.emplace_back();
+    {
+        Node& node = nodes_[index];
+        node.player = state->getCurrentPosition();
+        node.round = roundIndex(state->getBettingRound());
+        node.actions = subgameBets_->getAbstractedActions(
+            state->getValidActions(), state->getPot(),
+            state->getPlayerState(node.player).stack, state->getBettingRound());
+        if (node.actions.empty() || node.actions.size() > MAX_ACTIONS) {
+            throw std::runtime_error("Subgame decision has " + std::to_string(node.actions.size()) + " actions");
+        }
+    }
+
+    // nodes_ grows while children are built; index it afresh each time
+    const std::vector<Action> actions = nodes_[index].actions;
+    const std::vector<Action> translations = blueprintActions(*state);
+    std::vector<size_t> children;
+    for (const Action& action : actions) {
+        size_t nearest = nearestAction(translations, action);
+        ActionHistory childHistory = history;
+        childHistory.addAction(nodes_[index].player, nearest < translations.size() ? translations[nearest] : action);
+
+        auto child = state->clone();
+        if (advance(*child, action)) {
+            childHistory.startNewRound();
+            if (roundsLeft == 0) {
+                children.push_back(addValueNode(NodeKind::LEAF, std::move(child), childHistory));
+                continue;
+            }
+            children.push_back(buildTree(std::move(child), childHistory, roundsLeft - 1));
+        } else {
+            children.push_back(buildTree(std::move(child), childHistory, roundsLeft));
+        }
+    }
+    nodes_[index].children = std::move(children);
+    return index;
+}
+
+size_t SubgameSolver::addValueNode(NodeKind kind, std::unique_ptr<GameState> state, const ActionHistory& history) {
+    Node node;
+    node.kind = kind;
+    node.state = std::move(state);
+    node.history = history;
+    node.values.resize(deals_.size());
+    node.valueReady.assign(deals_.size(), 0);
+    nodes_.push_back(std::move(node));
+    numLeaves_ += kind == NodeKind::LEAF;
+    return nodes_.size() - 1;
+}
+
+SubgameSolver::Values SubgameSolver::traverse(size_t nodeIndex, size_t deal, const Values& reach, double weight) {
+    Node& node = nodes_[nodeIndex];
+    if (node.kind != NodeKind::DECISION) {
+        return nodeValues(nodeIndex, deal);
+    }
+
+    const size_t player = static_cast<size_t>(node.player);
+    const size_t numActions = node.actions.size();
+    InfoSet& infoSet = node.infoSets[dealBuckets_[deal][player][node.round]];
+    if (infoSet.regrets.empty()) {
+        infoSet.regrets.assign(numActions, 0.0);
+        infoSet.strategySum.assign(numActions, 0.0);
+    }
+
+    // Regret matching+ (regrets are floored at zero on update)
+    double strategy[MAX_ACTIONS];
+    double regretSum = std::accumulate(infoSet.regrets.begin(), infoSet.regrets.end(), 0.0);
+    for (size_t a = 0; a < numActions; ++a) {
+        strategy[a] = regretSum > 0.0 ? infoSet.regrets[a] / regretSum : 1.0 / numActions;
+    }
+
+    Values utility{};
+    Values childValues[MAX_ACTIONS];
+    for (size_t a = 0; a < numActions; ++a) {
+        Values childReach = reach;
+        childReach[player] *= strategy[a];
+        childValues[a] = traverse(node.children[a], deal, childReach, weight);
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            utility[p] += strategy[a] * childValues[a][p];
+        }
+    }
+
+    double counterfactualReach = 1.0;
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        if (static_cast<size_t>(p) != player) {
+            counterfactualReach *= reach[p];
+        }
+    }
+    for (size_t a = 0; a < numActions; ++a) {
+        double regret = counterfactualReach * (childValues[a][player] - utility[player]);
+        infoSet.regrets[a] = std::max(0.0, infoSet.regrets[a] + regret);
+        infoSet.strategySum[a] += weight * reach[player] * strategy[a];
+    }
+    return utility;
+}
+
+const SubgameSolver::Values& SubgameSolver::nodeValues(size_t nodeIndex, size_t deal) {
+    Node& node = nodes_[nodeIndex];
+    if (node.valueReady[deal]) {
+        return node.values[deal];
+    }
+
+    Values values{};
+    if (node.kind == NodeKind::TERMINAL) {
+        GameState showdown = *node.state;
+        showdown.setDeal(deals_[deal]);
+        auto payoffs = showdown.getPayoffs();
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            values[p] = payoffs[static_cast<Position>(p)];
+        }
+    } else {
+        // Rollouts of one (leaf, deal) pair replay the same stream
+        Xoshiro256 rng = Xoshiro256::forStream(options_.seed, nodeIndex + 1, deal);
+        for (int r = 0; r < options_.rolloutsPerLeaf; ++r) {
+            Values sample = rollout(node, deal, rng);
+            for (int p = 0; p < NUM_PLAYERS; ++p) {
+                values[p] += sample[p] / options_.rolloutsPerLeaf;
+            }
+        }
+    }
+
+    node.values[deal] = values;
+    node.valueReady[deal] = 1;
+    return node.values[deal];
+}
+
+SubgameSolver::Values SubgameSolver::rollout(const Node& leaf, size_t deal, Xoshiro256& rng) const {
+    GameState state = *leaf.state;
+    state.setDeal(deals_[deal]);
+    ActionHistory history = leaf.history;
+
+    // A hand cannot outlast a few dozen decisions; the cap only guards
+    // against a state that never turns terminal
+    const int maxDecisions = 100;
+    double policy[MAX_ACTIONS];
+    for (int step = 0; step < maxDecisions && !state.isTerminal(); ++step) {
+        Position position = state.getCurrentPosition();
+        std::vector<Action> actions = blueprintActions(state);
+        if (actions.empty() || actions.size() > MAX_ACTIONS) {
+            break;
+        }
+
+        BettingRound round = state.getBettingRound();
+        int bucket = dealBuckets_[deal][static_cast<size_t>(position)][roundIndex(round)];
+        blueprintPolicy(position, round, bucket, history.toString(), actions, policy);
+        const Action& action = actions[sampleIndex(policy, actions.size(), rng.nextDouble())];
+
+        history.addAction(position, action);
+        if (advance(state, action)) {
+            history.startNewRound();
+        }
+    }
+
+    Values values{};
+    if (state.isTerminal()) {
+        auto payoffs = state.getPayoffs();
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            values[p] = payoffs[static_cast<Position>(p)];
+        }
+    }
+    return values;
+}
+
+std::vector<Action> SubgameSolver::blueprintActions(const GameState& state) const {
+    Position position = state.getCurrentPosition();
+    return blueprintBets_->getAbstractedActions(state.getValidActions(), state.getPot(),
+                                                state.getPlayerState(position).stack, state.getBettingRound());
+}
+
+void SubgameSolver::blueprintPolicy(Position position, BettingRound round, int bucket, const std::string& history,
+                                    const std::vector<Action>& actions, double* out) const {
+    std::fill(out, out + actions.size(), 0.0);
+    double total = 0.0;
+    for (const auto& [stored, probability] : blueprint_.getAverageStrategies(
+             CFRSolver::makeInfoSetKey(position, round, bucket, history))) {
+        size_t index = nearestAction(actions, stored);
+        if (index < actions.size()) {
+            out[index] += probability;
+            total += probability;
+        }
+    }
+
+    if (total > 0.0) {
+        for (size_t a = 0; a < actions.size(); ++a) {
+            out[a] /= total;
+        }
+    } else {
+        std::fill(out, out + actions.size(), 1.0 / actions.size());
+    }
+}
+
+size_t SubgameSolver::nearestAction(const std::vector<Action>& actions, const Action& action) {
+    size_t best = actions.size();
+    double bestDistance = 0.0;
+    for (size_t a = 0; a < actions.size(); ++a) {
+        if (actions[a].getType() != action.getType()) {
+            continue;
+        }
+        double distance = std::abs(actions[a].getAmount() - action.getAmount());
+        if (best == actions.size() || distance < bestDistance) {
+            best = a;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+} // namespace poker
\ No newline at end of file
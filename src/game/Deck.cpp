@@ -0,0 +1,47 @@
+#include "game/Deck.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace poker {
+
+void Deck::draw(uint8_t* out, int count, Xoshiro256& rng) {
+    // Gather the remaining cards (at most 52 bytes on the stack)
+    uint8_t cards[DECK_SIZE];
+    int numCards = 0;
+    for (CardMask mask = remaining_; mask != 0; mask &= mask - 1) {
+        cards[numCards++] = static_cast<uint8_t>(__builtin_ctzll(mask));
+    }
+
+    if (count > numCards) {
+        throw std::invalid_argument("Not enough cards left in the deck");
+    }
+
+    // Partial Fisher-Yates: only the first count positions are shuffled
+    for (int i = 0; i < count; ++i) {
+        int j = i + static_cast<int>(rng.nextBounded(static_cast<uint32_t>(numCards - i)));
+        std::swap(cards[i], cards[j]);
+        out[i] = cards[i];
+        remaining_ &= ~cardBit(cards[i]);
+    }
+}
+
+DealOutcome Deck::drawOutcome(Xoshiro256& rng) {
+    constexpr int numHoleCards = NUM_PLAYERS * HOLE_CARDS_PER_PLAYER;
+
+    uint8_t cards[numHoleCards + BOARD_SIZE];
+    draw(cards, numHoleCards + BOARD_SIZE, rng);
+
+    DealOutcome outcome;
+    for (int player = 0; player < NUM_PLAYERS; ++player) {
+        for (int i = 0; i < HOLE_CARDS_PER_PLAYER; ++i) {
+            outcome.holeCards[player][i] = cards[player * HOLE_CARDS_PER_PLAYER + i];
+        }
+    }
+    for (int i = 0; i < BOARD_SIZE; ++i) {
+        outcome.board[i] = cards[numHoleCards + i];
+    }
+
+    return outcome;
+}
+
+} // namespace poker
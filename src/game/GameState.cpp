@@ -1,9 +1,11 @@
 #include <game/GameState.hpp>
+#include <game/PreflopEquity.hpp>
+#include <game/Showdown.hpp>
 #include <utils/Logger.hpp>
+#include <utils/Metrics.hpp>
+#include <utils/Random.hpp>
 #include <algorithm>
-#include <random>
 #include <sstream>
-#include <chrono>
 #include <stdexcept>
 #include <pokerstove/peval/HoldemHandEvaluator.h>
 #include <pokerstove/peval/CardSet.h>
@@ -19,10 +21,6 @@ GameState::GameState()
       pot_(0.0),
       handEvaluator_(std::make_shared<HandEvaluator>()) {
     
-    // Initialize random number generator with time-based seed
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    rng_.seed(seed);
-    
     // Initialize the game
     reset();
 }
@@ -30,13 +28,12 @@ GameState::GameState()
 GameState::GameState(const GameState& other)
     : players_(other.players_),
       communityCards_(other.communityCards_),
-      deck_(other.deck_),
+      deal_(other.deal_),
       currentPosition_(other.currentPosition_),
       lastAggressor_(other.lastAggressor_),
       bettingRound_(other.bettingRound_),
       pot_(other.pot_),
       actionHistory_(other.actionHistory_),
-      rng_(other.rng_),
       handEvaluator_(other.handEvaluator_) {
 }
 
@@ -44,13 +41,12 @@ GameState& GameState::operator=(const GameState& other) {
     if (this != &other) {
         players_ = other.players_;
         communityCards_ = other.communityCards_;
-        deck_ = other.deck_;
+        deal_ = other.deal_;
         currentPosition_ = other.currentPosition_;
         lastAggressor_ = other.lastAggressor_;
         bettingRound_ = other.bettingRound_;
         pot_ = other.pot_;
         actionHistory_ = other.actionHistory_;
-        rng_ = other.rng_;
         handEvaluator_ = other.handEvaluator_;
     }
     return *this;
@@ -59,6 +55,14 @@ GameState& GameState::operator=(const GameState& other) {
 GameState::~GameState() = default;
 
 void GameState::reset() {
+    resetDeck();
+    reset(deal_);
+}
+
+void GameState::reset(const DealOutcome& deal) {
+    deal_ = deal;
+    communityCards_.clear();
+    
     // Reset player states
     for (auto& player : players_) {
         player.stack = STARTING_STACK;
@@ -67,8 +71,6 @@ void GameState::reset() {
         player.holeCards.clear();
     }
     
-    resetDeck();
-    
     currentPosition_ = Position::BTN;
     lastAggressor_ = Position::SB;
     bettingRound_ = BettingRound::PREFLOP;
@@ -80,27 +82,43 @@ void GameState::reset() {
     applyBlinds();
 }
 
+void GameState::setDeal(const DealOutcome& deal) {
+    deal_ = deal;
+    dealHoleCards();
+    
+    switch (bettingRound_) {
+        case BettingRound::PREFLOP:
+            communityCards_.clear();
+            break;
+        case BettingRound::FLOP:
+            dealFlop();
+            break;
+        case BettingRound::TURN:
+            dealTurn();
+            break;
+        default:
+            dealRiver();
+            break;
+    }
+}
+
 void GameState::dealHoleCards() {
-    for (auto& player : players_) {
-        for (int i = 0; i < 2; ++i) {
-            player.holeCards.insert(deck_.deal(1));
-        }
+    for (size_t i = 0; i < players_.size(); ++i) {
+        players_[i].holeCards = Deck::toCardSet(deal_.holeMask(static_cast<Position>(i)));
     }
 }
 
 void GameState::dealFlop() {
-    // Deal the flop (3 cards)
-    for (int i = 0; i < 3; ++i) {
-        communityCards_.insert(deck_.deal(1));
-    }
+    // Reveal the flop (3 cards)
+    communityCards_ = Deck::toCardSet(deal_.boardMask(3));
 }
 
 void GameState::dealTurn() {
-    communityCards_.insert(deck_.deal(1));
+    communityCards_ = Deck::toCardSet(deal_.boardMask(4));
 }
 
 void GameState::dealRiver() {
-    communityCards_.insert(deck_.deal(1));
+    communityCards_ = Deck::toCardSet(deal_.boardMask(5));
 }
 //#implement
 void GameState::showdown() {
@@ -203,6 +221,11 @@ bool GameState::isTerminal() const {
         return true;
     }
     
+    // All-ins are settled over every runout without dealing the streets
+    if (allInEquities(nullptr)) {
+        return true;
+    }
+    
     // If we've completed the river round, game is terminal
     if (bettingRound_ == BettingRound::RIVER) {
         // Check if all active players have the same bet
@@ -319,11 +342,12 @@ std::vector<Action> GameState::getValidActions() const {
 
 std::unordered_map<Position, double> GameState::getPayoffs() const {
 
-    // Initialize payoffs with negative bets
+    // Initialize payoffs with everything each player put in this hand;
+    // currentBet only holds the current street's chips
     std::unordered_map<Position, double> payoffs;
     for (size_t i = 0; i < players_.size(); ++i) {
         Position pos = static_cast<Position>(i);
-        payoffs[pos] = -players_[i].currentBet;
+        payoffs[pos] = players_[i].stack - STARTING_STACK;
     }
 
     // Identify active players
@@ -340,6 +364,17 @@ std::unordered_map<Position, double> GameState::getPayoffs() const {
         return payoffs;
     }
 
+    // OPTIMIZATION: All-ins pay the exact pot share over every runout
+    // instead of one sampled board
+    std::array<double, NUM_PLAYERS> equities;
+    if (allInEquities(&equities)) {
+        Metrics::increment(Counter::ALLIN_EVALS);
+        for (Position pos : activePlayers) {
+            payoffs[pos] += equities[static_cast<size_t>(pos)] * pot_;
+        }
+        return payoffs;
+    }
+
     // Multiple active players: evaluate hands with PokerStove
     std::vector<std::pair<Position, pokerstove::PokerHandEvaluation>> handStrengths;
     for (Position pos : activePlayers) {
@@ -372,7 +407,56 @@ std::unordered_map<Position, double> GameState::getPayoffs() const {
     return payoffs;
 }
 
+bool GameState::allInEquities(std::array<double, NUM_PLAYERS>* equities) const {
+    // River showdowns already score the full board
+    if (bettingRound_ != BettingRound::PREFLOP && bettingRound_ != BettingRound::FLOP &&
+        bettingRound_ != BettingRound::TURN) {
+        return false;
+    }
+
+    double highestBet = getHighestBet();
+    CardMask hands[NUM_PLAYERS];
+    size_t positions[NUM_PLAYERS];
+    int numHands = 0;
+    int withChips = 0;
+    for (size_t i = 0; i < players_.size(); ++i) {
+        const PlayerState& player = players_[i];
+        if (player.folded) {
+            continue;
+        }
+        if (player.stack > 0.0 && (++withChips > 1 || player.currentBet < highestBet)) {
+            return false;   // Someone can still bet or has to call
+        }
+        hands[numHands] = deal_.holeMask(static_cast<Position>(i));
+        positions[numHands++] = i;
+    }
+    if (numHands < 2) {
+        return false;
+    }
+
+    // Preflop has over a million runouts per matchup: only the precomputed table is
+    // fast enough, otherwise the flop is dealt and enumerated from there
+    double shares[NUM_PLAYERS];
+    if (bettingRound_ == BettingRound::PREFLOP) {
+        if (!PreflopEquityTable::getInstance().lookup(hands, numHands, shares)) {
+            return false;
+        }
+    } else if (equities) {
+        int boardCards = bettingRound_ == BettingRound::FLOP ? 3 : 4;
+        Showdown::cachedEquities(hands, numHands, deal_.boardMask(boardCards), shares);
+    }
+
+    if (equities) {
+        equities->fill(0.0);
+        for (int h = 0; h < numHands; ++h) {
+            (*equities)[positions[h]] = shares[h];
+        }
+    }
+    return true;
+}
+
 std::unique_ptr<GameState> GameState::clone() const {
+    Metrics::increment(Counter::STATE_CLONES);
     return std::make_unique<GameState>(*this);
 }
 
@@ -412,9 +496,9 @@ std::string GameState::toString() const {
 }
 
 void GameState::resetDeck() {
-    communityCards_.clear();
-    deck_.reset();
-    deck_.shuffle();
+    // One partial shuffle draws every card the hand can use
+    Deck deck;
+    deal_ = deck.drawOutcome(Random::getInstance().getGenerator());
 }
 
 void GameState::applyBlinds() {
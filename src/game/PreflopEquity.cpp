@@ -0,0 +1,295 @@
+#include "game/PreflopEquity.hpp"
+#include "game/Showdown.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+constexpr char MAGIC[8] = {'P', 'K', 'R', 'E', 'Q', 'T', 'Y', '1'};
+constexpr uint32_t VERSION = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headsUpBoards;     // 0 = every board
+    uint32_t threeWayBoards;
+    uint32_t reserved;
+    uint64_t numEntries;
+    uint64_t keysOffset;
+    uint64_t recordsOffset;
+    uint64_t fileBytes;
+};
+static_assert(sizeof(FileHeader) == 56, "Equity table header layout changed");
+static_assert(sizeof(PreflopEquityTable::Record) == 12, "Equity record layout changed");
+
+// Cards use the pokerstove code: suit * 13 + rank
+constexpr int NUM_RANKS = 13;
+constexpr int NUM_SUITS = 4;
+
+// Hole-card pair <-> 0..1325 (11 bits)
+constexpr int HAND_BITS = 11;
+constexpr uint64_t HAND_MASK = (uint64_t(1) << HAND_BITS) - 1;
+
+uint32_t handIndex(CardMask hand) {
+    uint32_t high = 63 - __builtin_clzll(hand);
+    uint32_t low = __builtin_ctzll(hand);
+    return high * (high - 1) / 2 + low;
+}
+
+CardMask handOfIndex(uint32_t index) {
+    uint32_t high = 1;
+    while ((high + 1) * high / 2 <= index) {
+        ++high;
+    }
+    return cardBit(static_cast<uint8_t>(high)) | cardBit(static_cast<uint8_t>(index - high * (high - 1) / 2));
+}
+
+using SuitPermutation = std::array<uint8_t, NUM_SUITS>;
+
+const std::array<SuitPermutation, 24>& suitPermutations() {
+    static const std::array<SuitPermutation, 24> permutations = [] {
+        std::array<SuitPermutation, 24> all{};
+        SuitPermutation permutation = {0, 1, 2, 3};
+        size_t i = 0;
+        do {
+            all[i++] = permutation;
+        } while (std::next_permutation(permutation.begin(), permutation.end()));
+        return all;
+    }();
+    return permutations;
+}
+
+CardMask relabel(CardMask hand, const SuitPermutation& permutation) {
+    CardMask mapped = 0;
+    for (; hand != 0; hand &= hand - 1) {
+        int card = __builtin_ctzll(hand);
+        mapped |= cardBit(static_cast<uint8_t>(permutation[card / NUM_RANKS] * NUM_RANKS + card % NUM_RANKS));
+    }
+    return mapped;
+}
+
+} // namespace
+
+PreflopEquityTable& PreflopEquityTable::getInstance() {
+    static PreflopEquityTable instance;
+    return instance;
+}
+
+PreflopEquityTable::~PreflopEquityTable() {
+    unload();
+}
+
+bool PreflopEquityTable::load(const std::string& filename) {
+    unload();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("Failed to open equity table: " + filename);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+        LOG_ERROR("Equity table too short: " + filename);
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR("Failed to map equity table: " + filename);
+        return false;
+    }
+
+    // Binary search jumps around the file; skip readahead
+    madvise(mapping, size, MADV_RANDOM);
+
+    const char* data = static_cast<const char*>(mapping);
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.fileBytes != size || header.keysOffset % 8 != 0 || header.recordsOffset % 4 != 0 ||
+        header.keysOffset + header.numEntries * sizeof(uint64_t) > header.recordsOffset ||
+        header.recordsOffset + header.numEntries * sizeof(Record) > size) {
+        LOG_ERROR("Not a valid equity table: " + filename);
+        munmap(mapping, size);
+        return false;
+    }
+
+    data_ = data;
+    size_ = size;
+    keys_ = reinterpret_cast<const uint64_t*>(data + header.keysOffset);
+    records_ = reinterpret_cast<const Record*>(data + header.recordsOffset);
+    numEntries_ = static_cast<size_t>(header.numEntries);
+    headsUpBoards_ = header.headsUpBoards;
+    threeWayBoards_ = header.threeWayBoards;
+
+    LOG_INFO("Loaded " + std::to_string(numEntries_) + " preflop equities from " + filename);
+    return true;
+}
+
+void PreflopEquityTable::unload() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    keys_ = nullptr;
+    records_ = nullptr;
+    numEntries_ = 0;
+}
+
+bool PreflopEquityTable::lookup(const CardMask* hands, int numHands, double* equities) const {
+    if (!data_ || numHands < 2 || numHands > MAX_HANDS) {
+        return false;
+    }
+
+    int slots[MAX_HANDS];
+    uint64_t key = canonicalKey(hands, numHands, slots);
+    const uint64_t* end = keys_ + numEntries_;
+    const uint64_t* it = std::lower_bound(keys_, end, key);
+    if (it == end || *it != key) {
+        return false;
+    }
+
+    const Record& record = records_[it - keys_];
+    for (int h = 0; h < numHands; ++h) {
+        equities[h] = record.equity[slots[h]];
+    }
+    return true;
+}
+
+uint64_t PreflopEquityTable::canonicalKey(const CardMask* hands, int numHands, int* slots) {
+    if (numHands < 1 || numHands > MAX_HANDS) {
+        throw std::invalid_argument("Equity matchups have 1 to 3 hands");
+    }
+
+    uint64_t bestKey = ~uint64_t(0);
+    for (const auto& permutation : suitPermutations()) {
+        // (hand index, original position), sorted by index descending
+        std::array<std::pair<uint32_t, int>, MAX_HANDS> order{};
+        for (int h = 0; h < numHands; ++h) {
+            order[h] = {handIndex(relabel(hands[h], permutation)), h};
+        }
+        std::sort(order.begin(), order.begin() + numHands, std::greater<std::pair<uint32_t, int>>());
+
+        uint32_t indices[MAX_HANDS];
+        for (int h = 0; h < numHands; ++h) {
+            indices[h] = order[h].first;
+        }
+        uint64_t key = packKey(indices, numHands);
+        if (key < bestKey) {
+            bestKey = key;
+            for (int h = 0; h < numHands; ++h) {
+                slots[order[h].second] = h;
+            }
+        }
+    }
+    return bestKey;
+}
+
+uint64_t PreflopEquityTable::packKey(const uint32_t* handIndices, int numHands) {
+    uint64_t key = static_cast<uint64_t>(numHands) << (HAND_BITS * MAX_HANDS);
+    for (int h = 0; h < numHands; ++h) {
+        key |= static_cast<uint64_t>(handIndices[h]) << (HAND_BITS * (MAX_HANDS - 1 - h));
+    }
+    return key;
+}
+
+int PreflopEquityTable::handsOfKey(uint64_t key, CardMask* hands) {
+    int numHands = static_cast<int>(key >> (HAND_BITS * MAX_HANDS));
+    for (int h = 0; h < numHands; ++h) {
+        hands[h] = handOfIndex(static_cast<uint32_t>((key >> (HAND_BITS * (MAX_HANDS - 1 - h))) & HAND_MASK));
+    }
+    return numHands;
+}
+
+void PreflopEquityTable::computeEquities(const CardMask* hands, int numHands, uint32_t numBoards, uint64_t seed,
+                                         double* equities) {
+    if (numBoards == 0) {
+        Showdown::enumerateEquities(hands, numHands, 0, equities);
+        return;
+    }
+
+    CardMask dead = 0;
+    for (int h = 0; h < numHands; ++h) {
+        dead |= hands[h];
+    }
+
+    double totals[MAX_HANDS] = {};
+    Xoshiro256 rng(seed);
+    CardMask boards[Showdown::BLOCK_SIZE];
+    uint8_t board[BOARD_SIZE];
+    for (uint32_t start = 0; start < numBoards; start += Showdown::BLOCK_SIZE) {
+        size_t count = std::min<size_t>(Showdown::BLOCK_SIZE, numBoards - start);
+        for (size_t i = 0; i < count; ++i) {
+            Deck deck(dead);
+            deck.draw(board, BOARD_SIZE, rng);
+            boards[i] = 0;
+            for (uint8_t card : board) {
+                boards[i] |= cardBit(card);
+            }
+        }
+        Showdown::scoreBoards(hands, numHands, boards, count, totals);
+    }
+
+    for (int h = 0; h < numHands; ++h) {
+        equities[h] = totals[h] / numBoards;
+    }
+}
+
+bool PreflopEquityTable::write(const std::string& filename, const std::vector<uint64_t>& keys,
+                               const std::vector<Record>& records, uint32_t headsUpBoards,
+                               uint32_t threeWayBoards) {
+    if (keys.size() != records.size() || !std::is_sorted(keys.begin(), keys.end()) ||
+        std::adjacent_find(keys.begin(), keys.end()) != keys.end()) {
+        throw std::invalid_argument("Equity table keys must be sorted, unique and match the records");
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headsUpBoards = headsUpBoards;
+    header.threeWayBoards = threeWayBoards;
+    header.numEntries = keys.size();
+    header.keysOffset = sizeof(FileHeader);
+    header.recordsOffset = header.keysOffset + keys.size() * sizeof(uint64_t);
+    header.fileBytes = header.recordsOffset + records.size() * sizeof(Record);
+
+    // Written under a temporary name so readers never map a partial file
+    std::string tempFile = filename + ".tmp";
+    std::ofstream ofs(tempFile, std::ios::binary);
+    if (!ofs.is_open()) {
+        LOG_ERROR("Failed to open equity table: " + tempFile);
+        return false;
+    }
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char*>(keys.data()), keys.size() * sizeof(uint64_t));
+    ofs.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+    ofs.close();
+
+    if (!ofs || std::rename(tempFile.c_str(), filename.c_str()) != 0) {
+        LOG_ERROR("Failed to write equity table: " + filename);
+        std::remove(tempFile.c_str());
+        return false;
+    }
+
+    LOG_INFO("Wrote " + std::to_string(keys.size()) + " preflop equities (" + std::to_string(header.fileBytes) +
+             " bytes) to " + filename);
+    return true;
+}
+
+} // namespace poker
\ No newline at end of file
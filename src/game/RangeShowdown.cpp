@@ -0,0 +1,228 @@
+#include "game/RangeShowdown.hpp"
+#include "game/Showdown.hpp"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <stdexcept>
+
+namespace poker {
+
+namespace {
+
+constexpr int NUM_HAND_INDICES = DECK_SIZE * (DECK_SIZE - 1) / 2;
+
+// Strength classes relative to the combo being valued
+enum StrengthClass { BELOW, TIED, ABOVE, NUM_CLASSES };
+
+int pairIndex(int a, int b) {
+    if (a < b) std::swap(a, b);
+    return a * (a - 1) / 2 + b;
+}
+
+// Pair index of every two-card combination, [card][card]
+const std::array<uint16_t, DECK_SIZE * DECK_SIZE>& pairIndexTable() {
+    static const std::array<uint16_t, DECK_SIZE * DECK_SIZE> table = [] {
+        std::array<uint16_t, DECK_SIZE * DECK_SIZE> indices{};
+        for (int a = 0; a < DECK_SIZE; ++a) {
+            for (int b = 0; b < DECK_SIZE; ++b) {
+                indices[a * DECK_SIZE + b] = a == b ? 0 : static_cast<uint16_t>(pairIndex(a, b));
+            }
+        }
+        return indices;
+    }();
+    return table;
+}
+
+// Reach of a set of hands, in total and by card
+struct CardSums {
+    double total = 0.0;
+    double card[DECK_SIZE] = {};
+
+    void add(const std::array<uint8_t, 2>& cards, double weight) {
+        total += weight;
+        card[cards[0]] += weight;
+        card[cards[1]] += weight;
+    }
+
+    // Reach of the hands in the set that share no card with {a, b}; own is
+    // the weight of {a, b} itself if it is in the set (subtracted twice)
+    double disjointFrom(int a, int b, double own) const { return total - card[a] - card[b] + own; }
+};
+
+} // namespace
+
+void RangeShowdown::setBoard(CardMask board) {
+    if (__builtin_popcountll(board) != BOARD_SIZE) {
+        throw std::invalid_argument("Range showdowns need a complete board");
+    }
+    board_ = board;
+
+    hands_.clear();
+    strengths_.clear();
+    handIndex_.clear();
+    cards_.clear();
+    strengthByIndex_.assign(NUM_HAND_INDICES, INT_MIN);
+    for (uint8_t high = 1; high < DECK_SIZE; ++high) {
+        for (uint8_t low = 0; low < high; ++low) {
+            CardMask hand = cardBit(high) | cardBit(low);
+            if ((hand & board) == 0) {
+                int strength = Showdown::handStrength(hand | board);
+                hands_.push_back(hand);
+                strengths_.push_back(strength);
+                handIndex_.push_back(static_cast<uint16_t>(pairIndex(high, low)));
+                cards_.push_back({high, low});
+                strengthByIndex_[handIndex_.back()] = strength;
+            }
+        }
+    }
+
+    liveCards_.clear();
+    for (uint8_t card = 0; card < DECK_SIZE; ++card) {
+        if ((board & cardBit(card)) == 0) {
+            liveCards_.push_back(card);
+        }
+    }
+
+    order_.resize(hands_.size());
+    std::iota(order_.begin(), order_.end(), 0);
+    std::sort(order_.begin(), order_.end(),
+              [this](uint32_t a, uint32_t b) { return strengths_[a] < strengths_[b]; });
+
+    groupEnds_.clear();
+    for (uint32_t j = 1; j <= order_.size(); ++j) {
+        if (j == order_.size() || strengths_[order_[j]] != strengths_[order_[j - 1]]) {
+            groupEnds_.push_back(j);
+        }
+    }
+}
+
+void RangeShowdown::evaluate(const double* const* opponentReach, const bool* contending, double* shares,
+                             double* masses) const {
+    const auto& pairs = pairIndexTable();
+    const size_t numHands = hands_.size();
+
+    // Reach by pair index (0 for hands that touch the board)
+    std::vector<double> reach1(NUM_HAND_INDICES, 0.0);
+    std::vector<double> reach2(NUM_HAND_INDICES, 0.0);
+    CardSums all1, all2, allBoth;
+    for (size_t i = 0; i < numHands; ++i) {
+        double r1 = opponentReach[0][i];
+        double r2 = opponentReach[1][i];
+        reach1[handIndex_[i]] = r1;
+        reach2[handIndex_[i]] = r2;
+        all1.add(cards_[i], r1);
+        all2.add(cards_[i], r2);
+        allBoth.add(cards_[i], r1 * r2);
+    }
+
+    // Sums by strength class: BELOW accumulates over the sweep, TIED is the
+    // current group, ABOVE is the rest. "Both" weights a hand held by both
+    // opponents (r1 * r2), the inclusion-exclusion term for a shared hand.
+    CardSums sums1[NUM_CLASSES], sums2[NUM_CLASSES], sumsBoth[NUM_CLASSES];
+
+    uint32_t begin = 0;
+    for (uint32_t end : groupEnds_) {
+        sums1[TIED] = CardSums();
+        sums2[TIED] = CardSums();
+        sumsBoth[TIED] = CardSums();
+        for (uint32_t j = begin; j < end; ++j) {
+            uint32_t i = order_[j];
+            sums1[TIED].add(cards_[i], opponentReach[0][i]);
+            sums2[TIED].add(cards_[i], opponentReach[1][i]);
+            sumsBoth[TIED].add(cards_[i], opponentReach[0][i] * opponentReach[1][i]);
+        }
+        auto rest = [](const CardSums& all, const CardSums& below, const CardSums& tied) {
+            CardSums above;
+            above.total = all.total - below.total - tied.total;
+            for (int c = 0; c < DECK_SIZE; ++c) {
+                above.card[c] = all.card[c] - below.card[c] - tied.card[c];
+            }
+            return above;
+        };
+        sums1[ABOVE] = rest(all1, sums1[BELOW], sums1[TIED]);
+        sums2[ABOVE] = rest(all2, sums2[BELOW], sums2[TIED]);
+        sumsBoth[ABOVE] = rest(allBoth, sumsBoth[BELOW], sumsBoth[TIED]);
+
+        const int strength = strengths_[order_[begin]];
+        for (uint32_t j = begin; j < end; ++j) {
+            const uint32_t i = order_[j];
+            const int a = cards_[i][0];
+            const int b = cards_[i][1];
+            const double own1 = opponentReach[0][i];
+            const double own2 = opponentReach[1][i];
+
+            // held[X][Y]: reach of opponent holdings (h1 in class X, h2 in
+            // class Y) that share no card with this combo or each other.
+            // Expanding the disjointness constraints leaves, per class pair,
+            //   first2[Y] * first1[X] + both[X] (if X == Y) + sum_z w[X][z] * v[Y][z]
+            // where z runs over the other live cards.
+            double first1[NUM_CLASSES], first2[NUM_CLASSES], both[NUM_CLASSES];
+            for (int x = 0; x < NUM_CLASSES; ++x) {
+                bool ownClass = x == TIED;      // The combo itself is tied with itself
+                first1[x] = sums1[x].disjointFrom(a, b, ownClass ? own1 : 0.0);
+                first2[x] = sums2[x].disjointFrom(a, b, ownClass ? own2 : 0.0);
+                both[x] = sumsBoth[x].disjointFrom(a, b, ownClass ? own1 * own2 : 0.0);
+            }
+
+            // OPTIMIZATION: One pass over the live cards corrects all nine
+            // class pairs for hands sharing a card with this combo
+            double cross[NUM_CLASSES][NUM_CLASSES] = {};
+            for (uint8_t z : liveCards_) {
+                if (z == a || z == b) continue;
+                double w[NUM_CLASSES] = {sums1[BELOW].card[z], sums1[TIED].card[z], sums1[ABOVE].card[z]};
+                double v[NUM_CLASSES] = {-sums2[BELOW].card[z], -sums2[TIED].card[z], -sums2[ABOVE].card[z]};
+                for (int q : {pairs[a * DECK_SIZE + z], pairs[b * DECK_SIZE + z]}) {
+                    int other = strengthByIndex_[q];
+                    int cls = other < strength ? BELOW : (other == strength ? TIED : ABOVE);
+                    w[cls] -= reach1[q];
+                    v[cls] += reach2[q];
+                }
+                for (int x = 0; x < NUM_CLASSES; ++x) {
+                    for (int y = 0; y < NUM_CLASSES; ++y) {
+                        cross[x][y] += w[x] * v[y];
+                    }
+                }
+            }
+
+            double held[NUM_CLASSES][NUM_CLASSES];
+            double mass = 0.0;
+            for (int x = 0; x < NUM_CLASSES; ++x) {
+                for (int y = 0; y < NUM_CLASSES; ++y) {
+                    held[x][y] = first2[y] * first1[x] + (x == y ? both[x] : 0.0) + cross[x][y];
+                    mass += held[x][y];
+                }
+            }
+            masses[i] = mass;
+
+            // Win against every contender below, split with the tied ones;
+            // folded opponents only remove cards
+            double share = 0.0;
+            if (contending[0] && contending[1]) {
+                share = held[BELOW][BELOW] + 0.5 * (held[TIED][BELOW] + held[BELOW][TIED]) + held[TIED][TIED] / 3.0;
+            } else if (contending[0]) {
+                for (int y = 0; y < NUM_CLASSES; ++y) {
+                    share += held[BELOW][y] + 0.5 * held[TIED][y];
+                }
+            } else if (contending[1]) {
+                for (int x = 0; x < NUM_CLASSES; ++x) {
+                    share += held[x][BELOW] + 0.5 * held[x][TIED];
+                }
+            } else {
+                share = mass;
+            }
+            shares[i] = share;
+        }
+
+        for (int c = 0; c < DECK_SIZE; ++c) {
+            sums1[BELOW].card[c] += sums1[TIED].card[c];
+            sums2[BELOW].card[c] += sums2[TIED].card[c];
+            sumsBoth[BELOW].card[c] += sumsBoth[TIED].card[c];
+        }
+        sums1[BELOW].total += sums1[TIED].total;
+        sums2[BELOW].total += sums2[TIED].total;
+        sumsBoth[BELOW].total += sumsBoth[TIED].total;
+        begin = end;
+    }
+}
+
+} // namespace poker
\ No newline at end of file
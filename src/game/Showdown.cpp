@@ -0,0 +1,146 @@
+#include "game/Showdown.hpp"
+#include "utils/Metrics.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace poker {
+
+int Showdown::handStrength(CardMask cards) {
+    return Deck::toCardSet(cards).evaluateHigh().code();
+}
+
+void Showdown::scoreBoards(const CardMask* hands, int numHands, const CardMask* boards, size_t numBoards,
+                           double* totals) {
+    if (numHands < 1 || numHands > MAX_HANDS) {
+        throw std::invalid_argument("Showdowns have 1 to 3 hands");
+    }
+
+    int strengths[MAX_HANDS][BLOCK_SIZE];
+    int best[BLOCK_SIZE];
+    double share[BLOCK_SIZE];
+
+    for (size_t start = 0; start < numBoards; start += BLOCK_SIZE) {
+        size_t count = std::min(BLOCK_SIZE, numBoards - start);
+        for (int h = 0; h < numHands; ++h) {
+            for (size_t b = 0; b < count; ++b) {
+                strengths[h][b] = handStrength(hands[h] | boards[start + b]);
+            }
+        }
+
+        // OPTIMIZATION: Winners and splits are closed-form passes over the
+        // block with no per-board branches, so they vectorize
+        std::copy(strengths[0], strengths[0] + count, best);
+        for (int h = 1; h < numHands; ++h) {
+            for (size_t b = 0; b < count; ++b) {
+                best[b] = std::max(best[b], strengths[h][b]);
+            }
+        }
+        std::fill(share, share + count, 0.0);
+        for (int h = 0; h < numHands; ++h) {
+            for (size_t b = 0; b < count; ++b) {
+                share[b] += strengths[h][b] == best[b] ? 1.0 : 0.0;
+            }
+        }
+        for (size_t b = 0; b < count; ++b) {
+            share[b] = 1.0 / share[b];
+        }
+        for (int h = 0; h < numHands; ++h) {
+            double total = 0.0;
+            for (size_t b = 0; b < count; ++b) {
+                total += strengths[h][b] == best[b] ? share[b] : 0.0;
+            }
+            totals[h] += total;
+        }
+    }
+}
+
+void Showdown::enumerateEquities(const CardMask* hands, int numHands, CardMask board, double* equities) {
+    CardMask dead = board;
+    for (int h = 0; h < numHands; ++h) {
+        dead |= hands[h];
+    }
+    int missing = BOARD_SIZE - __builtin_popcountll(board);
+    if (missing < 0) {
+        throw std::invalid_argument("Board has more than 5 cards");
+    }
+
+    uint8_t cards[DECK_SIZE];
+    int numCards = 0;
+    for (CardMask mask = FULL_DECK_MASK & ~dead; mask != 0; mask &= mask - 1) {
+        cards[numCards++] = static_cast<uint8_t>(__builtin_ctzll(mask));
+    }
+
+    // Walk every missing-card combination in lexicographic order, scoring a
+    // block of boards at a time
+    double totals[MAX_HANDS] = {};
+    CardMask boards[BLOCK_SIZE];
+    size_t pending = 0;
+    size_t numBoards = 0;
+    int index[BOARD_SIZE];
+    for (int i = 0; i < missing; ++i) {
+        index[i] = i;
+    }
+    while (true) {
+        CardMask runout = board;
+        for (int i = 0; i < missing; ++i) {
+            runout |= cardBit(cards[index[i]]);
+        }
+        boards[pending++] = runout;
+        if (pending == BLOCK_SIZE) {
+            scoreBoards(hands, numHands, boards, pending, totals);
+            numBoards += pending;
+            pending = 0;
+        }
+
+        int i = missing - 1;
+        while (i >= 0 && index[i] == numCards - missing + i) {
+            --i;
+        }
+        if (i < 0) {
+            break;
+        }
+        ++index[i];
+        for (int j = i + 1; j < missing; ++j) {
+            index[j] = index[j - 1] + 1;
+        }
+    }
+    scoreBoards(hands, numHands, boards, pending, totals);
+    numBoards += pending;
+
+    for (int h = 0; h < numHands; ++h) {
+        equities[h] = totals[h] / static_cast<double>(numBoards);
+    }
+}
+
+void Showdown::cachedEquities(const CardMask* hands, int numHands, CardMask board, double* equities) {
+    struct Entry {
+        CardMask board = 0;
+        std::array<CardMask, MAX_HANDS> hands{};
+        int numHands = 0;       // 0 = empty
+        std::array<double, MAX_HANDS> equities{};
+    };
+    thread_local std::array<Entry, CACHE_SLOTS> cache;
+
+    uint64_t hash = board * 0x9E3779B97F4A7C15ULL;
+    for (int h = 0; h < numHands; ++h) {
+        hash = (hash ^ hands[h]) * 0xBF58476D1CE4E5B9ULL;
+    }
+    Entry& entry = cache[(hash >> 32) % CACHE_SLOTS];
+
+    bool hit = entry.numHands == numHands && entry.board == board;
+    for (int h = 0; hit && h < numHands; ++h) {
+        hit = entry.hands[h] == hands[h];
+    }
+    if (hit) {
+        Metrics::increment(Counter::ALLIN_CACHE_HITS);
+    } else {
+        enumerateEquities(hands, numHands, board, entry.equities.data());
+        entry.board = board;
+        entry.numHands = numHands;
+        std::copy(hands, hands + numHands, entry.hands.begin());
+    }
+    std::copy(entry.equities.begin(), entry.equities.begin() + numHands, equities);
+}
+
+} // namespace poker
\ No newline at end of file
@@ -0,0 +1,624 @@
+#include "runtime/MappedStrategy.hpp"
+#include "cfr/Checkpoint.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+constexpr char MAGIC[8] = {'P', 'K', 'R', 'S', 'T', 'R', 'A', 'T'};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t indexBits;
+    uint32_t encoding;          // MappedStrategy::Encoding
+    uint32_t reserved;
+    uint64_t numEntries;
+    uint64_t numActionSets;
+    uint64_t numActions;
+    uint64_t indexOffset;
+    uint64_t entriesOffset;
+    uint64_t actionSetsOffset;
+    uint64_t actionsOffset;
+    uint64_t valuesOffset;
+    uint64_t keysOffset;
+    uint64_t fileBytes;
+    uint64_t bodyChecksum;      // See bodyChecksum()
+    uint64_t headerChecksum;    // Over all preceding fields
+};
+static_assert(sizeof(FileHeader) == 120, "Strategy file header layout changed");
+static_assert(sizeof(MappedStrategy::EntryRecord) == 24, "Strategy entry layout changed");
+static_assert(sizeof(MappedStrategy::ActionSetRecord) == 8, "Strategy action set layout changed");
+static_assert(sizeof(MappedStrategy::ActionRecord) == 16, "Strategy action layout changed");
+
+uint64_t alignUp(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+
+// Smallest bit count giving at least one bucket per entry
+uint32_t indexBitsFor(size_t numEntries) {
+    uint32_t bits = 0;
+    while (bits < 31 && (size_t(1) << bits) < numEntries) {
+        ++bits;
+    }
+    return bits;
+}
+
+size_t bucketOf(uint64_t hash, uint32_t indexBits) {
+    return indexBits == 0 ? 0 : static_cast<size_t>(hash >> (64 - indexBits));
+}
+
+size_t valueWidth(MappedStrategy::Encoding encoding) {
+    switch (encoding) {
+        case MappedStrategy::Encoding::Q16: return 2;
+        case MappedStrategy::Encoding::Q8: return 1;
+        default: return 4;
+    }
+}
+
+// Largest fixed-point value (one full unit of probability)
+uint32_t valueScale(MappedStrategy::Encoding encoding) {
+    return encoding == MappedStrategy::Encoding::Q16 ? 65535u : 255u;
+}
+
+// Checksum of the sections (alignment padding excluded): the checksum of
+// their checksums, so the writer needs no contiguous copy of the file
+uint64_t bodyChecksum(const FileHeader& header, const char* data) {
+    const uint64_t bounds[][2] = {
+        {header.indexOffset, ((uint64_t(1) << header.indexBits) + 1) * sizeof(uint32_t)},
+        {header.entriesOffset, header.numEntries * sizeof(MappedStrategy::EntryRecord)},
+        {header.actionSetsOffset, header.numActionSets * sizeof(MappedStrategy::ActionSetRecord)},
+        {header.actionsOffset, header.numActions * sizeof(MappedStrategy::ActionRecord)},
+        {header.valuesOffset, header.keysOffset - header.valuesOffset},
+        {header.keysOffset, header.fileBytes - header.keysOffset},
+    };
+    uint64_t checksums[6];
+    for (size_t i = 0; i < 6; ++i) {
+        checksums[i] = Checkpoint::checksum(data + bounds[i][0], static_cast<size_t>(bounds[i][1]));
+    }
+    return Checkpoint::checksum(checksums, sizeof(checksums));
+}
+
+// Every offset and count a lookup follows stays inside its section; nullptr
+// if so, else the reason
+const char* validateRecords(const FileHeader& header, const char* data) {
+    const auto* index = reinterpret_cast<const uint32_t*>(data + header.indexOffset);
+    const auto* entries = reinterpret_cast<const MappedStrategy::EntryRecord*>(data + header.entriesOffset);
+    const auto* actionSets = reinterpret_cast<const MappedStrategy::ActionSetRecord*>(data + header.actionSetsOffset);
+    const auto* values = reinterpret_cast<const unsigned char*>(data + header.valuesOffset);
+    const uint64_t valueBytes = header.keysOffset - header.valuesOffset;
+    const uint64_t keyBytes = header.fileBytes - header.keysOffset;
+    const size_t width = valueWidth(static_cast<MappedStrategy::Encoding>(header.encoding));
+
+    const size_t buckets = size_t(1) << header.indexBits;
+    if (index[0] != 0 || index[buckets] != header.numEntries) {
+        return "Strategy file index does not cover the entries: ";
+    }
+    for (size_t b = 0; b < buckets; ++b) {
+        if (index[b] > index[b + 1]) {
+            return "Strategy file index out of order: ";
+        }
+    }
+
+    for (uint64_t s = 0; s < header.numActionSets; ++s) {
+        if (uint64_t(actionSets[s].firstAction) + actionSets[s].numActions > header.numActions) {
+            return "Strategy file action list out of range: ";
+        }
+    }
+
+    for (uint64_t e = 0; e < header.numEntries; ++e) {
+        const MappedStrategy::EntryRecord& entry = entries[e];
+        if (uint64_t(entry.keyOffset) + entry.keyLength > keyBytes) {
+            return "Strategy file key out of range: ";
+        }
+        if (entry.actionSet >= header.numActionSets || actionSets[entry.actionSet].numActions != entry.numActions) {
+            return "Strategy file entry has a bad action list: ";
+        }
+        uint64_t bitmapBytes = (entry.numActions + 7) / 8;
+        if (uint64_t(entry.valueOffset) + bitmapBytes > valueBytes) {
+            return "Strategy file values out of range: ";
+        }
+        uint64_t present = 0;
+        for (size_t i = 0; i < entry.numActions; ++i) {
+            present += (values[entry.valueOffset + i / 8] >> (i % 8)) & 1u;
+        }
+        if (uint64_t(entry.valueOffset) + bitmapBytes + present * width > valueBytes) {
+            return "Strategy file values out of range: ";
+        }
+    }
+    return nullptr;
+}
+
+// Round probabilities (summing to one) to integers summing to exactly scale,
+// giving the leftover units to the largest remainders
+std::vector<uint32_t> quantize(const std::vector<double>& probabilities, uint32_t scale) {
+    std::vector<uint32_t> quantized(probabilities.size());
+    std::vector<std::pair<double, size_t>> remainders;
+    uint32_t assigned = 0;
+    for (size_t i = 0; i < probabilities.size(); ++i) {
+        double scaled = probabilities[i] * scale;
+        quantized[i] = std::min(scale, static_cast<uint32_t>(scaled));
+        assigned += quantized[i];
+        remainders.push_back({scaled - quantized[i], i});
+    }
+    std::sort(remainders.begin(), remainders.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    for (size_t i = 0; assigned < scale && i < remainders.size(); ++i, ++assigned) {
+        quantized[remainders[i].second]++;
+    }
+    return quantized;
+}
+
+// Call fn(i, probability) for each of an entry's actions in order
+template <typename Fn>
+void forEachProbability(const char* values, const MappedStrategy::EntryRecord& entry,
+                        MappedStrategy::Encoding encoding, Fn fn) {
+    const unsigned char* bitmap = reinterpret_cast<const unsigned char*>(values + entry.valueOffset);
+    const char* value = values + entry.valueOffset + (entry.numActions + 7) / 8;
+
+    for (size_t i = 0; i < entry.numActions; ++i) {
+        if (!(bitmap[i / 8] & (1u << (i % 8)))) {
+            fn(i, 0.0);
+            continue;
+        }
+        // Values are packed without alignment
+        switch (encoding) {
+            case MappedStrategy::Encoding::FLOAT32: {
+                float probability;
+                std::memcpy(&probability, value, sizeof(probability));
+                fn(i, static_cast<double>(probability));
+                break;
+            }
+            case MappedStrategy::Encoding::Q16: {
+                uint16_t quantized;
+                std::memcpy(&quantized, value, sizeof(quantized));
+                fn(i, quantized / 65535.0);
+                break;
+            }
+            case MappedStrategy::Encoding::Q8:
+                fn(i, static_cast<unsigned char>(*value) / 255.0);
+                break;
+        }
+        value += valueWidth(encoding);
+    }
+}
+
+} // namespace
+
+MappedStrategy::~MappedStrategy() {
+    close();
+}
+
+MappedStrategy::MappedStrategy(MappedStrategy&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedStrategy& MappedStrategy::operator=(MappedStrategy&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        size_ = other.size_;
+        numEntries_ = other.numEntries_;
+        indexBits_ = other.indexBits_;
+        encoding_ = other.encoding_;
+        index_ = other.index_;
+        entries_ = other.entries_;
+        actionSets_ = other.actionSets_;
+        actions_ = other.actions_;
+        values_ = other.values_;
+        keys_ = other.keys_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.numEntries_ = 0;
+    }
+    return *this;
+}
+
+uint64_t MappedStrategy::hashKey(const char* data, size_t length) {
+    // FNV-1a with a final avalanche so the top bits index well
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001B3ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+std::string MappedStrategy::encodingToString(Encoding encoding) {
+    switch (encoding) {
+        case Encoding::FLOAT32: return "f32";
+        case Encoding::Q16: return "q16";
+        case Encoding::Q8: return "q8";
+        default: return "unknown";
+    }
+}
+
+bool MappedStrategy::encodingFromString(const std::string& str, Encoding& encoding) {
+    for (Encoding candidate : {Encoding::FLOAT32, Encoding::Q16, Encoding::Q8}) {
+        if (str == encodingToString(candidate)) {
+            encoding = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MappedStrategy::open(const std::string& filename) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("Failed to open strategy file: " + filename);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+        LOG_ERROR("Strategy file too short: " + filename);
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR("Failed to map strategy file: " + filename);
+        return false;
+    }
+
+    // Lookups jump around the file; skip readahead
+    madvise(mapping, size, MADV_RANDOM);
+
+    const char* data = static_cast<const char*>(mapping);
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const char* error = nullptr;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "Not a strategy file: ";
+    } else if (header.version != VERSION) {
+        error = "Unsupported strategy file version: ";
+    } else if (Checkpoint::checksum(&header, offsetof(FileHeader, headerChecksum)) != header.headerChecksum) {
+        error = "Strategy file header checksum mismatch: ";
+    } else if (header.fileBytes != size || header.indexBits > 31 ||
+               header.encoding > static_cast<uint32_t>(Encoding::Q8) ||
+               header.indexOffset + ((uint64_t(1) << header.indexBits) + 1) * sizeof(uint32_t) > header.entriesOffset ||
+               header.entriesOffset + header.numEntries * sizeof(EntryRecord) > header.actionSetsOffset ||
+               header.actionSetsOffset + header.numActionSets * sizeof(ActionSetRecord) > header.actionsOffset ||
+               header.actionsOffset + header.numActions * sizeof(ActionRecord) > header.valuesOffset ||
+               header.valuesOffset > header.keysOffset || header.keysOffset > size ||
+               ((header.indexOffset | header.entriesOffset | header.actionSetsOffset | header.actionsOffset) & 7) != 0) {
+        error = "Strategy file truncated or malformed: ";
+    } else if (bodyChecksum(header, data) != header.bodyChecksum) {
+        error = "Strategy file body checksum mismatch: ";
+    } else {
+        // Lookups follow the records' offsets without bounds checks
+        error = validateRecords(header, data);
+    }
+    if (error) {
+        LOG_ERROR(error + filename);
+        munmap(mapping, size);
+        return false;
+    }
+
+    data_ = data;
+    size_ = size;
+    numEntries_ = static_cast<size_t>(header.numEntries);
+    indexBits_ = header.indexBits;
+    encoding_ = static_cast<Encoding>(header.encoding);
+    index_ = reinterpret_cast<const uint32_t*>(data + header.indexOffset);
+    entries_ = reinterpret_cast<const EntryRecord*>(data + header.entriesOffset);
+    actionSets_ = reinterpret_cast<const ActionSetRecord*>(data + header.actionSetsOffset);
+    actions_ = reinterpret_cast<const ActionRecord*>(data + header.actionsOffset);
+    values_ = data + header.valuesOffset;
+    keys_ = data + header.keysOffset;
+    return true;
+}
+
+void MappedStrategy::close() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    numEntries_ = 0;
+}
+
+void MappedStrategy::prefault() const {
+    if (!data_) {
+        return;
+    }
+    madvise(const_cast<char*>(data_), size_, MADV_WILLNEED);
+
+    // One read per page maps it into this process
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    volatile char sink = 0;
+    for (size_t offset = 0; offset < size_; offset += pageSize) {
+        sink = sink + data_[offset];
+    }
+}
+
+const MappedStrategy::EntryRecord* MappedStrategy::find(const std::string& infoSet) const {
+    return find(infoSet.data(), infoSet.size(), hashKey(infoSet.data(), infoSet.size()));
+}
+
+const MappedStrategy::EntryRecord* MappedStrategy::find(const char* key, size_t length, uint64_t hash) const {
+    if (!data_) {
+        return nullptr;
+    }
+
+    size_t bucket = bucketOf(hash, indexBits_);
+
+    // OPTIMIZATION: Compare 64-bit hashes first; keys are only touched on a match
+    for (uint32_t i = index_[bucket]; i < index_[bucket + 1]; ++i) {
+        const EntryRecord& entry = entries_[i];
+        if (entry.hash == hash && entry.keyLength == length &&
+            std::memcmp(keys_ + entry.keyOffset, key, length) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void MappedStrategy::prefetchIndex(uint64_t hash) const {
+    if (data_) {
+        __builtin_prefetch(index_ + bucketOf(hash, indexBits_));
+    }
+}
+
+void MappedStrategy::prefetchEntry(uint64_t hash) const {
+    if (data_ && numEntries_ > 0) {
+        uint32_t first = index_[bucketOf(hash, indexBits_)];
+        if (first < numEntries_) {
+            __builtin_prefetch(entries_ + first);
+        }
+    }
+}
+
+void MappedStrategy::probabilities(const EntryRecord& entry, double* out) const {
+    forEachProbability(values_, entry, encoding_, [out](size_t i, double probability) {
+        out[i] = probability;
+    });
+}
+
+bool MappedStrategy::getAverageStrategy(const std::string& infoSet, const std::vector<Action>& actions,
+                                        double* out) const {
+    if (actions.empty()) {
+        return false;
+    }
+    const EntryRecord* entry = find(infoSet);
+    getAverageStrategy(entry, actions.data(), actions.size(), out);
+    return entry != nullptr;
+}
+
+void MappedStrategy::getAverageStrategy(const EntryRecord* entry, const Action* actions, size_t numActions,
+                                        double* out) const {
+    double sum = 0.0;
+    std::fill(out, out + numActions, 0.0);
+    if (entry) {
+        const ActionRecord* stored = this->actions(*entry);
+        forEachProbability(values_, *entry, encoding_, [&](size_t j, double probability) {
+            if (probability <= 0.0) {
+                return;
+            }
+            Action action = recordAction(stored[j]);
+            for (size_t i = 0; i < numActions; ++i) {
+                if (actions[i] == action) {
+                    out[i] = probability;
+                    sum += probability;
+                    break;
+                }
+            }
+        });
+    }
+
+    if (sum > 0.0) {
+        for (size_t i = 0; i < numActions; ++i) {
+            out[i] /= sum;
+        }
+    } else if (numActions > 0) {
+        double uniform = 1.0 / numActions;
+        std::fill(out, out + numActions, uniform);
+    }
+}
+
+std::unordered_map<Action, double, StrategyTable::ActionHash>
+MappedStrategy::getAverageStrategies(const std::string& infoSet) const {
+    std::unordered_map<Action, double, StrategyTable::ActionHash> result;
+    const EntryRecord* entry = find(infoSet);
+    if (entry) {
+        const ActionRecord* stored = actions(*entry);
+        forEachProbability(values_, *entry, encoding_, [&](size_t j, double probability) {
+            result[recordAction(stored[j])] = probability;
+        });
+    }
+    return result;
+}
+
+bool MappedStrategy::write(const std::string& filename, const StrategyTable& strategies, Encoding encoding) {
+    struct PendingEntry {
+        uint64_t hash;
+        std::string key;
+        std::vector<std::pair<Action, double>> actions;
+    };
+
+    std::vector<PendingEntry> pending;
+    for (auto& infoSet : strategies.getAllInfoSets()) {
+        auto averages = strategies.getAverageStrategies(infoSet);
+        if (averages.empty()) {
+            continue;
+        }
+        if (infoSet.size() > UINT16_MAX || averages.size() > UINT16_MAX) {
+            LOG_ERROR("Info set too large for strategy file: " + infoSet);
+            return false;
+        }
+
+        PendingEntry entry;
+        entry.hash = hashKey(infoSet.data(), infoSet.size());
+        entry.key = std::move(infoSet);
+        entry.actions.assign(averages.begin(), averages.end());
+
+        // Fixed action order lets entries share action lists and keeps exports
+        // of the same table byte-identical
+        std::sort(entry.actions.begin(), entry.actions.end(), [](const auto& a, const auto& b) {
+            return a.first.getType() != b.first.getType() ? a.first.getType() < b.first.getType()
+                                                          : a.first.getAmount() < b.first.getAmount();
+        });
+        pending.push_back(std::move(entry));
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingEntry& a, const PendingEntry& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.key < b.key;
+    });
+
+    // Lay out sections and fill the records
+    uint32_t indexBits = indexBitsFor(pending.size());
+    std::vector<uint32_t> index((size_t(1) << indexBits) + 1, 0);
+    std::vector<EntryRecord> entries;
+    std::vector<ActionSetRecord> actionSets;
+    std::vector<ActionRecord> actions;
+    std::map<std::vector<std::pair<uint8_t, double>>, uint32_t> actionSetIds;
+    std::vector<char> values;
+    std::string keys;
+    entries.reserve(pending.size());
+
+    size_t width = valueWidth(encoding);
+    std::vector<double> probabilities;
+    std::vector<std::pair<uint8_t, double>> actionList;
+
+    for (const auto& entry : pending) {
+        // Share the action list with earlier entries where possible
+        actionList.clear();
+        probabilities.clear();
+        for (const auto& pair : entry.actions) {
+            actionList.push_back({static_cast<uint8_t>(pair.first.getType()), pair.first.getAmount()});
+            probabilities.push_back(pair.second);
+        }
+        auto inserted = actionSetIds.emplace(actionList, static_cast<uint32_t>(actionSets.size()));
+        if (inserted.second) {
+            actionSets.push_back({static_cast<uint32_t>(actions.size()), static_cast<uint32_t>(actionList.size())});
+            for (const auto& action : actionList) {
+                ActionRecord record{};
+                record.amount = action.second;
+                record.type = action.first;
+                actions.push_back(record);
+            }
+        }
+
+        EntryRecord record{};
+        record.hash = entry.hash;
+        record.keyOffset = static_cast<uint32_t>(keys.size());
+        record.valueOffset = static_cast<uint32_t>(values.size());
+        record.actionSet = inserted.first->second;
+        record.keyLength = static_cast<uint16_t>(entry.key.size());
+        record.numActions = static_cast<uint16_t>(entry.actions.size());
+        entries.push_back(record);
+        keys += entry.key;
+        index[bucketOf(entry.hash, indexBits) + 1]++;
+
+        // Presence bitmap, then the values of present actions
+        size_t bitmapOffset = values.size();
+        values.resize(values.size() + (probabilities.size() + 7) / 8, 0);
+        std::vector<uint32_t> quantized;
+        if (encoding != Encoding::FLOAT32) {
+            quantized = quantize(probabilities, valueScale(encoding));
+        }
+        for (size_t i = 0; i < probabilities.size(); ++i) {
+            char bytes[4];
+            if (encoding == Encoding::FLOAT32) {
+                if (probabilities[i] <= 0.0) continue;
+                float probability = static_cast<float>(probabilities[i]);
+                std::memcpy(bytes, &probability, sizeof(probability));
+            } else if (quantized[i] == 0) {
+                continue;
+            } else if (encoding == Encoding::Q16) {
+                uint16_t value = static_cast<uint16_t>(quantized[i]);
+                std::memcpy(bytes, &value, sizeof(value));
+            } else {
+                bytes[0] = static_cast<char>(static_cast<uint8_t>(quantized[i]));
+            }
+            values[bitmapOffset + i / 8] |= static_cast<char>(1u << (i % 8));
+            values.insert(values.end(), bytes, bytes + width);
+        }
+    }
+    if (keys.size() > UINT32_MAX || values.size() > UINT32_MAX || actions.size() > UINT32_MAX) {
+        LOG_ERROR("Strategy too large for strategy file format");
+        return false;
+    }
+    for (size_t b = 1; b < index.size(); ++b) {
+        index[b] += index[b - 1];
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.indexBits = indexBits;
+    header.encoding = static_cast<uint32_t>(encoding);
+    header.numEntries = entries.size();
+    header.numActionSets = actionSets.size();
+    header.numActions = actions.size();
+    header.indexOffset = sizeof(FileHeader);
+    header.entriesOffset = alignUp(header.indexOffset + index.size() * sizeof(uint32_t));
+    header.actionSetsOffset = header.entriesOffset + entries.size() * sizeof(EntryRecord);
+    header.actionsOffset = header.actionSetsOffset + actionSets.size() * sizeof(ActionSetRecord);
+    header.valuesOffset = header.actionsOffset + actions.size() * sizeof(ActionRecord);
+    header.keysOffset = header.valuesOffset + values.size();
+    header.fileBytes = header.keysOffset + keys.size();
+    const uint64_t sectionChecksums[] = {
+        Checkpoint::checksum(index.data(), index.size() * sizeof(uint32_t)),
+        Checkpoint::checksum(entries.data(), entries.size() * sizeof(EntryRecord)),
+        Checkpoint::checksum(actionSets.data(), actionSets.size() * sizeof(ActionSetRecord)),
+        Checkpoint::checksum(actions.data(), actions.size() * sizeof(ActionRecord)),
+        Checkpoint::checksum(values.data(), values.size()),
+        Checkpoint::checksum(keys.data(), keys.size()),
+    };
+    header.bodyChecksum = Checkpoint::checksum(sectionChecksums, sizeof(sectionChecksums));
+    header.headerChecksum = Checkpoint::checksum(&header, offsetof(FileHeader, headerChecksum));
+
+    // Written under a temporary name so readers never map a partial file
+    std::string tempFile = filename + ".tmp";
+    std::ofstream ofs(tempFile, std::ios::binary);
+    if (!ofs.is_open()) {
+        LOG_ERROR("Failed to open strategy file: " + tempFile);
+        return false;
+    }
+
+    const char zeros[8] = {};
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(uint32_t));
+    ofs.write(zeros, header.entriesOffset - (header.indexOffset + index.size() * sizeof(uint32_t)));
+    ofs.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(EntryRecord));
+    ofs.write(reinterpret_cast<const char*>(actionSets.data()), actionSets.size() * sizeof(ActionSetRecord));
+    ofs.write(reinterpret_cast<const char*>(actions.data()), actions.size() * sizeof(ActionRecord));
+    ofs.write(values.data(), values.size());
+    ofs.write(keys.data(), keys.size());
+    ofs.close();
+
+    if (!ofs || std::rename(tempFile.c_str(), filename.c_str()) != 0) {
+        LOG_ERROR("Failed to write strategy file: " + filename);
+        std::remove(tempFile.c_str());
+        return false;
+    }
+
+    LOG_INFO("Exported " + std::to_string(entries.size()) + " info sets (" + encodingToString(encoding) + ", " +
+             std::to_string(actionSets.size()) + " action lists, " + std::to_string(header.fileBytes) +
+             " bytes) to " + filename);
+    return true;
+}
+
+} // namespace poker
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "runtime/StrategyProtocol.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+static_assert(sizeof(StrategyProtocol::FrameHeader) == 24, "Frame header layout changed");
+static_assert(sizeof(StrategyProtocol::DecisionRecord) == 24, "Decision record layout changed");
+
+size_t padTo(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+void append(std::vector<char>& out, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+// Cards a query can bucket: 2 hole cards and a 0, 3, 4 or 5 card board, all
+// distinct cards of the deck
+bool validCards(const StrategyProtocol::DecisionRecord& record) {
+    int boardCards = __builtin_popcountll(record.board);
+    return ((record.holeCards | record.board) & ~FULL_DECK_MASK) == 0 &&
+           (record.holeCards & record.board) == 0 &&
+           __builtin_popcountll(record.holeCards) == HOLE_CARDS_PER_PLAYER &&
+           (boardCards == 0 || (boardCards >= 3 && boardCards <= BOARD_SIZE));
+}
+
+// Reads from a body with bounds checks
+class BodyReader {
+public:
+    explicit BodyReader(const std::vector<char>& body) : body_(body) {}
+
+    bool read(void* out, size_t size) {
+        if (size > body_.size() - position_) {
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(out, body_.data() + position_, size);
+        }
+        position_ += size;
+        return true;
+    }
+
+    bool skipTo(size_t alignment) {
+        size_t next = padTo(position_, alignment);
+        if (next > body_.size()) {
+            return false;
+        }
+        position_ = next;
+        return true;
+    }
+
+    bool done() const { return position_ == body_.size(); }
+
+private:
+    const std::vector<char>& body_;
+    size_t position_ = 0;
+};
+
+} // namespace
+
+void StrategyProtocol::encodeRequest(uint32_t requestId, const StrategyQueryEngine::Decision* decisions,
+                                     size_t count, std::vector<char>& out) {
+    out.assign(sizeof(FrameHeader), 0);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& decision = decisions[i];
+        size_t historyLength = decision.history ? decision.history->size() : 0;
+        if (decision.numActions == 0 || decision.numActions > UINT8_MAX || historyLength > UINT16_MAX) {
+            throw std::invalid_argument("Decision does not fit the strategy protocol");
+        }
+
+        DecisionRecord record{};
+        record.holeCards = decision.holeCards;
+        record.board = decision.board;
+        record.position = static_cast<uint8_t>(decision.position);
+        record.numActions = static_cast<uint8_t>(decision.numActions);
+        record.historyLength = static_cast<uint16_t>(historyLength);
+        append(out, &record, sizeof(record));
+
+        for (size_t a = 0; a < decision.numActions; ++a) {
+            MappedStrategy::ActionRecord action{};
+            action.amount = decision.actions[a].getAmount();
+            action.type = static_cast<uint8_t>(decision.actions[a].getType());
+            append(out, &action, sizeof(action));
+        }
+
+        if (historyLength > 0) {
+            append(out, decision.history->data(), historyLength);
+        }
+        out.resize(padTo(out.size(), 8), 0);
+    }
+
+    FrameHeader header{};
+    header.magic = REQUEST_MAGIC;
+    header.version = VERSION;
+    header.numDecisions = static_cast<uint32_t>(count);
+    header.requestId = requestId;
+    header.bodyBytes = out.size() - sizeof(FrameHeader);
+    std::memcpy(out.data(), &header, sizeof(header));
+}
+
+void StrategyProtocol::encodeResponse(uint32_t requestId, Status status, const bool* found, size_t numDecisions,
+                                      const double* probabilities, size_t numProbabilities,
+                                      std::vector<char>& out) {
+    out.assign(sizeof(FrameHeader), 0);
+    if (status == Status::OK) {
+        for (size_t i = 0; i < numDecisions; ++i) {
+            out.push_back(found[i] ? 1 : 0);
+        }
+        out.resize(padTo(out.size(), 4), 0);
+        for (size_t i = 0; i < numProbabilities; ++i) {
+            float probability = static_cast<float>(probabilities[i]);
+            append(out, &probability, sizeof(probability));
+        }
+    } else {
+        numDecisions = 0;
+    }
+
+    FrameHeader header{};
+    header.magic = RESPONSE_MAGIC;
+    header.version = VERSION;
+    header.status = static_cast<uint16_t>(status);
+    header.numDecisions = static_cast<uint32_t>(numDecisions);
+    header.requestId = requestId;
+    header.bodyBytes = out.size() - sizeof(FrameHeader);
+    std::memcpy(out.data(), &header, sizeof(header));
+}
+
+bool StrategyProtocol::decodeRequest(const FrameHeader& header, const std::vector<char>& body, Request& request) {
+    if (header.numDecisions > MAX_DECISIONS) {
+        return false;
+    }
+
+    // Records first; pointers are fixed up once the vectors stop growing
+    std::vector<size_t> firstActions;
+    BodyReader reader(body);
+    request.requestId = header.requestId;
+    request.decisions.clear();
+    request.actions.clear();
+    request.histories.clear();
+
+    for (uint32_t i = 0; i < header.numDecisions; ++i) {
+        DecisionRecord record;
+        if (!reader.read(&record, sizeof(record)) || record.position >= NUM_PLAYERS || record.numActions == 0 ||
+            !validCards(record)) {
+            return false;
+        }
+
+        firstActions.push_back(request.actions.size());
+        for (uint8_t a = 0; a < record.numActions; ++a) {
+            MappedStrategy::ActionRecord action;
+            if (!reader.read(&action, sizeof(action))) {
+                return false;
+            }
+            request.actions.push_back(MappedStrategy::recordAction(action));
+        }
+
+        std::string history(record.historyLength, '\0');
+        if (!reader.read(&history[0], history.size()) || !reader.skipTo(8)) {
+            return false;
+        }
+        request.histories.push_back(std::move(history));
+
+        StrategyQueryEngine::Decision decision{};
+        decision.position = static_cast<Position>(record.position);
+        decision.holeCards = record.holeCards;
+        decision.board = record.board;
+        decision.numActions = record.numActions;
+        request.decisions.push_back(decision);
+    }
+    if (!reader.done()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < request.decisions.size(); ++i) {
+        request.decisions[i].actions = request.actions.data() + firstActions[i];
+        request.decisions[i].history = &request.histories[i];
+    }
+    return true;
+}
+
+bool StrategyProtocol::decodeResponse(const FrameHeader& header, const std::vector<char>& body,
+                                      Response& response) {
+    response.requestId = header.requestId;
+    response.status = static_cast<Status>(header.status);
+    response.found.assign(header.numDecisions, 0);
+    response.probabilities.clear();
+    if (response.status != Status::OK) {
+        return body.empty();
+    }
+
+    BodyReader reader(body);
+    if (!reader.read(response.found.data(), response.found.size()) || !reader.skipTo(4)) {
+        return false;
+    }
+    size_t remaining = body.size() - padTo(response.found.size(), 4);
+    if (remaining % sizeof(float) != 0) {
+        return false;
+    }
+    response.probabilities.resize(remaining / sizeof(float));
+    return reader.read(response.probabilities.data(), remaining) && reader.done();
+}
+
+bool StrategyProtocol::readFrame(int fd, uint32_t expectedMagic, FrameHeader& header, std::vector<char>& body) {
+    auto readAll = [fd](void* data, size_t size) {
+        char* bytes = static_cast<char*>(data);
+        while (size > 0) {
+            ssize_t got = recv(fd, bytes, size, 0);
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) return false;
+            bytes += got;
+            size -= static_cast<size_t>(got);
+        }
+        return true;
+    };
+
+    if (!readAll(&header, sizeof(header)) || header.magic != expectedMagic || header.version != VERSION ||
+        header.bodyBytes > MAX_BODY_BYTES) {
+        return false;
+    }
+    body.resize(static_cast<size_t>(header.bodyBytes));
+    return readAll(body.data(), body.size());
+}
+
+bool StrategyProtocol::writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        // MSG_NOSIGNAL: a vanished peer is an error, not SIGPIPE
+        ssize_t written = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace poker
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "runtime/StrategyQueryEngine.hpp"
+#include "cfr/CFRSolver.hpp"
+#include "utils/Logger.hpp"
+#include "utils/Metrics.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace poker {
+
+StrategyQueryEngine::StrategyQueryEngine(std::shared_ptr<const MappedStrategy> strategy,
+                                         std::shared_ptr<HandAbstraction> handAbstraction)
+    : strategy_(std::move(strategy)), handAbstraction_(std::move(handAbstraction)) {
+    auto current = strategy_.read();
+    if (!current || !current->isOpen()) {
+        throw std::invalid_argument("Query engine needs an open strategy");
+    }
+    if (!handAbstraction_) {
+        throw std::invalid_argument("Query engine needs a hand abstraction");
+    }
+}
+
+void StrategyQueryEngine::setStrategy(std::shared_ptr<const MappedStrategy> strategy) {
+    if (!strategy || !strategy->isOpen()) {
+        throw std::invalid_argument("Query engine needs an open strategy");
+    }
+    // The previous strategy is unmapped here, after its last reader left
+    strategy_.exchange(std::move(strategy));
+}
+
+bool StrategyQueryEngine::reload(const std::string& filename) {
+    auto strategy = std::make_shared<MappedStrategy>();
+    if (!strategy->open(filename)) {
+        return false;
+    }
+    strategy->prefault();
+
+    size_t numEntries = strategy->size();
+    setStrategy(std::move(strategy));
+    LOG_INFO("Reloaded strategy " + filename + " (" + std::to_string(numEntries) + " info sets, generation " +
+             std::to_string(getGeneration()) + ")");
+    return true;
+}
+
+BettingRound StrategyQueryEngine::roundForBoard(CardMask board) {
+    switch (__builtin_popcountll(board)) {
+        case 0: return BettingRound::PREFLOP;
+        case 3: return BettingRound::FLOP;
+        case 4: return BettingRound::TURN;
+        case 5: return BettingRound::RIVER;
+        default: throw std::invalid_argument("Board must have 0, 3, 4 or 5 cards");
+    }
+}
+
+std::string StrategyQueryEngine::infoSetKey(const HandAbstraction& handAbstraction, const Decision& decision) {
+    int bucket;
+    {
+        ScopedPhase phase(Phase::BUCKET);
+        bucket = handAbstraction.getBucket(Deck::toCardSet(decision.holeCards), Deck::toCardSet(decision.board));
+    }
+
+    // Must match CFRSolver::getAbstractedInfoSet byte for byte
+    return CFRSolver::makeInfoSetKey(decision.position, roundForBoard(decision.board), bucket,
+                                     decision.history ? *decision.history : std::string());
+}
+
+bool StrategyQueryEngine::query(const Decision& decision, double* out) const {
+    Metrics::increment(Counter::STRATEGY_READS);
+    std::string key = infoSetKey(decision);
+    auto strategy = strategy_.read();
+    const MappedStrategy::EntryRecord* entry = strategy->find(key);
+    strategy->getAverageStrategy(entry, decision.actions, decision.numActions, out);
+    return entry != nullptr;
+}
+
+size_t StrategyQueryEngine::queryBatch(const Decision* decisions, size_t count, double* out, bool* found) const {
+    struct PendingQuery {
+        std::string key;
+        uint64_t hash;
+    };
+
+    // OPTIMIZATION: Reuse key storage across batches on this thread
+    thread_local std::vector<PendingQuery> pending(BATCH_WINDOW);
+
+    // One version for the whole batch
+    auto strategy = strategy_.read();
+    size_t numFound = 0;
+    for (size_t start = 0; start < count; start += BATCH_WINDOW) {
+        size_t window = std::min(BATCH_WINDOW, count - start);
+
+        // Pass 1: keys and hashes; start loading index slots
+        for (size_t i = 0; i < window; ++i) {
+            PendingQuery& query = pending[i];
+            query.key = infoSetKey(decisions[start + i]);
+            query.hash = MappedStrategy::hashKey(query.key.data(), query.key.size());
+            strategy->prefetchIndex(query.hash);
+        }
+
+        // Pass 2: index slots are (mostly) cached now; start loading entries
+        for (size_t i = 0; i < window; ++i) {
+            strategy->prefetchEntry(pending[i].hash);
+        }
+
+        // Pass 3: resolve and decode
+        for (size_t i = 0; i < window; ++i) {
+            const Decision& decision = decisions[start + i];
+            const PendingQuery& query = pending[i];
+            const MappedStrategy::EntryRecord* entry = strategy->find(query.key.data(), query.key.size(), query.hash);
+            strategy->getAverageStrategy(entry, decision.actions, decision.numActions, out);
+            out += decision.numActions;
+
+            if (found) {
+                found[start + i] = entry != nullptr;
+            }
+            numFound += entry != nullptr;
+        }
+    }
+
+    Metrics::increment(Counter::STRATEGY_READS, count);
+    return numFound;
+}
+
+} // namespace poker
\ No newline at end of file
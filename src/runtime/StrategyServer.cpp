@@ -0,0 +1,268 @@
+#include "runtime/StrategyServer.hpp"
+#include "runtime/StrategyProtocol.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace poker {
+
+StrategyServer::StrategyServer(std::shared_ptr<StrategyQueryEngine> engine, unsigned numThreads)
+    : engine_(std::move(engine)), numThreads_(numThreads) {
+    if (!engine_) {
+        throw std::invalid_argument("Strategy server needs a query engine");
+    }
+    if (numThreads_ == 0) {
+        numThreads_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+StrategyServer::~StrategyServer() {
+    stop();
+}
+
+bool StrategyServer::start(const std::string& socketPath) {
+    if (running_.load()) {
+        return false;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        LOG_ERROR("Socket path too long: " + socketPath);
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        LOG_ERROR("Failed to create socket");
+        return false;
+    }
+
+    // A socket file left by a previous run would make bind fail
+    unlink(socketPath.c_str());
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd_, SOMAXCONN) != 0 || pipe2(wakePipe_, O_CLOEXEC | O_NONBLOCK) != 0) {
+        LOG_ERROR("Failed to listen on " + socketPath + ": " + std::strerror(errno));
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    socketPath_ = socketPath;
+    running_.store(true);
+    pollThread_ = std::thread(&StrategyServer::pollLoop, this);
+    for (unsigned t = 0; t < numThreads_; ++t) {
+        workers_.emplace_back(&StrategyServer::workerLoop, this);
+    }
+
+    LOG_INFO("Strategy server listening on " + socketPath + " with " + std::to_string(numThreads_) + " workers");
+    return true;
+}
+
+void StrategyServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    returnConnection(-1);
+    queueReady_.notify_all();
+    pollThread_.join();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    // Connections returned after the poll thread exited, and any still queued
+    int fd;
+    while (read(wakePipe_[0], &fd, sizeof(fd)) == sizeof(fd)) {
+        if (fd >= 0) close(fd);
+    }
+    for (int queued : readyConnections_) {
+        close(queued);
+    }
+    readyConnections_.clear();
+
+    close(wakePipe_[0]);
+    close(wakePipe_[1]);
+    close(listenFd_);
+    unlink(socketPath_.c_str());
+    listenFd_ = -1;
+
+    LOG_INFO("Strategy server stopped after " + std::to_string(requests_.load()) + " requests");
+}
+
+StrategyServer::Stats StrategyServer::getStats() const {
+    Stats stats;
+    stats.connections = connections_.load(std::memory_order_relaxed);
+    stats.requests = requests_.load(std::memory_order_relaxed);
+    stats.decisions = decisions_.load(std::memory_order_relaxed);
+    stats.errors = errors_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void StrategyServer::returnConnection(int fd) {
+    // Writes of one int to a pipe are atomic
+    for (;;) {
+        if (write(wakePipe_[1], &fd, sizeof(fd)) == sizeof(fd)) {
+            return;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            LOG_ERROR("Failed to wake the strategy server poll thread: " + std::string(std::strerror(errno)));
+            break;
+        }
+        // The pipe is full, so the poll thread already has wakeups pending; the
+        // shutdown sentinel is not needed then, and once stopping nobody may
+        // drain the pipe again
+        if (fd < 0 || !running_.load()) {
+            break;
+        }
+        pollfd writable{wakePipe_[1], POLLOUT, 0};
+        poll(&writable, 1, 100);
+    }
+
+    // A connection that cannot be handed back is closed rather than leaked
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+void StrategyServer::pollLoop() {
+    std::vector<int> idle;
+    std::vector<pollfd> fds;
+
+    while (running_.load()) {
+        fds.clear();
+        fds.push_back({wakePipe_[0], POLLIN, 0});
+        fds.push_back({listenFd_, POLLIN, 0});
+        for (int fd : idle) {
+            fds.push_back({fd, POLLIN, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR("Strategy server poll failed: " + std::string(std::strerror(errno)));
+            break;
+        }
+
+        // Connections coming back from workers
+        if (fds[0].revents & POLLIN) {
+            int fd;
+            while (read(wakePipe_[0], &fd, sizeof(fd)) == sizeof(fd)) {
+                if (fd >= 0) idle.push_back(fd);
+            }
+        }
+
+        if (fds[1].revents & POLLIN) {
+            int fd = accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) {
+                timeval timeout{RECEIVE_TIMEOUT_MS / 1000, (RECEIVE_TIMEOUT_MS % 1000) * 1000};
+                setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+                idle.push_back(fd);
+                connections_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Hand readable (or closed) connections to the workers
+        std::vector<int> ready;
+        for (size_t i = 2; i < fds.size(); ++i) {
+            if (fds[i].revents != 0) {
+                ready.push_back(fds[i].fd);
+            }
+        }
+        if (!ready.empty()) {
+            idle.erase(std::remove_if(idle.begin(), idle.end(), [&](int fd) {
+                return std::find(ready.begin(), ready.end(), fd) != ready.end();
+            }), idle.end());
+            {
+                std::lock_guard<std::mutex> lock(queueMutex_);
+                readyConnections_.insert(readyConnections_.end(), ready.begin(), ready.end());
+            }
+            queueReady_.notify_all();
+        }
+    }
+
+    for (int fd : idle) {
+        close(fd);
+    }
+}
+
+void StrategyServer::workerLoop() {
+    while (true) {
+        int fd;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueReady_.wait(lock, [this] { return !readyConnections_.empty() || !running_.load(); });
+            if (!running_.load()) {
+                return;
+            }
+            fd = readyConnections_.front();
+            readyConnections_.pop_front();
+        }
+
+        if (serveRequest(fd)) {
+            returnConnection(fd);
+        } else {
+            close(fd);
+        }
+    }
+}
+
+bool StrategyServer::serveRequest(int fd) {
+    // OPTIMIZATION: Per-worker buffers, reused across requests
+    thread_local std::vector<char> body;
+    thread_local std::vector<char> response;
+    thread_local StrategyProtocol::Request request;
+    thread_local std::vector<double> probabilities;
+    thread_local std::unique_ptr<bool[]> found(new bool[StrategyProtocol::MAX_DECISIONS]);
+
+    StrategyProtocol::FrameHeader header;
+    if (!StrategyProtocol::readFrame(fd, StrategyProtocol::REQUEST_MAGIC, header, body)) {
+        return false;   // Closed by the client, timed out or not speaking the protocol
+    }
+
+    if (!StrategyProtocol::decodeRequest(header, body, request)) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        StrategyProtocol::encodeResponse(header.requestId, StrategyProtocol::Status::BAD_REQUEST,
+                                         nullptr, 0, nullptr, 0, response);
+        StrategyProtocol::writeAll(fd, response.data(), response.size());
+        return false;
+    }
+
+    size_t numDecisions = request.decisions.size();
+    probabilities.resize(request.actions.size());
+    try {
+        engine_->queryBatch(request.decisions.data(), numDecisions, probabilities.data(), found.get());
+    } catch (const std::exception& e) {
+        // An exception must not leave the worker thread and take the server down
+        LOG_ERROR("Strategy query failed: " + std::string(e.what()));
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        StrategyProtocol::encodeResponse(header.requestId, StrategyProtocol::Status::SERVER_ERROR,
+                                         nullptr, 0, nullptr, 0, response);
+        StrategyProtocol::writeAll(fd, response.data(), response.size());
+        return false;
+    }
+
+    StrategyProtocol::encodeResponse(request.requestId, StrategyProtocol::Status::OK, found.get(), numDecisions,
+                                     probabilities.data(), probabilities.size(), response);
+    requests_.fetch_add(1, std::memory_order_relaxed);
+    decisions_.fetch_add(numDecisions, std::memory_order_relaxed);
+
+    if (!StrategyProtocol::writeAll(fd, response.data(), response.size())) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+} // namespace poker
\ No newline at end of file
@@ -6,6 +6,15 @@
 
 namespace poker {
 
+namespace {
+// Upper bound on records formatted per write in async mode
+constexpr size_t ASYNC_MAX_BATCH = 1024;
+// How long the writer sleeps when the queue is empty
+constexpr auto ASYNC_IDLE_WAIT = std::chrono::milliseconds(2);
+// Bounded retries for WARNING and above when the queue is full
+constexpr int ASYNC_PUSH_RETRIES = 64;
+}
+
 // Initialize the singleton instance
 Logger& Logger::getInstance() {
     static Logger instance;
@@ -19,6 +28,9 @@ Logger::Logger()
 }
 
 Logger::~Logger() {
+    // Drain any queued messages before closing the file
+    stopAsync();
+    
     // Close log file if open
     if (logFile_.is_open()) {
         logFile_.close();
@@ -72,7 +84,13 @@ void Logger::fatal(const std::string& message) {
 
 void Logger::log(Level level, const std::string& message) {
     // Skip logging if level is below minimum
-    if (level < minLevel_) {
+    if (!isEnabled(level)) {
+        return;
+    }
+    
+    // Asynchronous mode never touches the mutex or the disk on the caller's thread
+    if (async_.load(std::memory_order_acquire)) {
+        enqueue(level, message);
         return;
     }
     
@@ -80,7 +98,7 @@ void Logger::log(Level level, const std::string& message) {
     std::lock_guard<std::mutex> lock(mutex_);
     
     // Format the log message
-    std::string formattedMessage = formatLogMessage(level, message);
+    std::string formattedMessage = formatLogMessage(level, message, std::chrono::system_clock::now());
     
     // Log to console if enabled
     if (destination_ == Destination::CONSOLE || destination_ == Destination::BOTH) {
@@ -153,26 +171,217 @@ std::string Logger::levelToString(Level level) {
     }
 }
 
-std::string Logger::getTimestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
+void Logger::appendTimestamp(std::string& out, std::chrono::system_clock::time_point time) const {
+    auto now = time.time_since_epoch();
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(now);
+    int ms = static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - seconds).count());
+    
+    // The calendar part only changes once per second, so cache it per thread
+    // instead of calling localtime/put_time for every message
+    thread_local std::time_t cachedSecond = -1;
+    thread_local char cachedPrefix[32] = {0};
+    thread_local size_t cachedPrefixLength = 0;
+    
+    std::time_t second = static_cast<std::time_t>(seconds.count());
+    if (second != cachedSecond) {
+        std::tm localTime{};
+        localtime_r(&second, &localTime);
+        cachedPrefixLength = std::strftime(cachedPrefix, sizeof(cachedPrefix),
+                                           "%Y-%m-%d %H:%M:%S", &localTime);
+        cachedSecond = second;
+    }
+    
+    out.append(cachedPrefix, cachedPrefixLength);
+    out.push_back('.');
+    out.push_back(static_cast<char>('0' + ms / 100));
+    out.push_back(static_cast<char>('0' + (ms / 10) % 10));
+    out.push_back(static_cast<char>('0' + ms % 10));
+}
+
+std::string Logger::formatLogMessage(Level level, const std::string& message,
+                                     std::chrono::system_clock::time_point time) const {
+    static const std::string levelNames[] = {
+        "DEBUG", "INFO", "WARNING", "ERROR", "FATAL"
+    };
+    
+    std::string formatted;
+    formatted.reserve(message.size() + 40);
+    
+    formatted.push_back('[');
+    appendTimestamp(formatted, time);
+    formatted.append("] [");
+    formatted.append(levelNames[static_cast<size_t>(level)]);
+    formatted.append("] ");
+    formatted.append(message);
+    
+    return formatted;
+}
+
+void Logger::startAsync(size_t queueCapacity, std::chrono::milliseconds flushInterval) {
+    if (async_.load(std::memory_order_acquire)) {
+        return;
+    }
+    
+    // Not safe against concurrent log() calls; switch modes during setup/teardown
+    queue_ = std::make_unique<MpscRingBuffer<LogRecord>>(queueCapacity);
+    flushInterval_ = flushInterval;
+    stopRequested_.store(false, std::memory_order_relaxed);
+    writerThread_ = std::thread(&Logger::asyncWriterLoop, this);
+    
+    async_.store(true, std::memory_order_release);
+}
+
+void Logger::stopAsync() {
+    if (!async_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
     
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count();
+    // The writer drains the queue before exiting
+    stopRequested_.store(true, std::memory_order_release);
+    wakeCondition_.notify_one();
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+}
+
+void Logger::flush() {
+    if (async_.load(std::memory_order_acquire)) {
+        // Wait for the writer to catch up with everything enqueued so far
+        uint64_t target = enqueued_.load(std::memory_order_acquire);
+        while (written_.load(std::memory_order_acquire) < target) {
+            wakeCondition_.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
     
-    return ss.str();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (logFile_.is_open()) {
+        logFile_.flush();
+    }
+    std::cout.flush();
 }
 
-std::string Logger::formatLogMessage(Level level, const std::string& message) const {
-    std::stringstream ss;
-    ss << "[" << getTimestamp() << "] "
-       << "[" << levelToString(level) << "] "
-       << message;
+void Logger::enqueue(Level level, const std::string& message) {
+    LogRecord record{level, std::chrono::system_clock::now(), message};
+    
+    if (queue_->tryPush(std::move(record))) {
+        enqueued_.fetch_add(1, std::memory_order_release);
+        return;
+    }
     
-    return ss.str();
+    // Queue is full: drop low-severity output rather than stall the caller
+    if (level < Level::WARNING) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    // Warnings and errors get a short, bounded retry before being dropped
+    for (int attempt = 0; attempt < ASYNC_PUSH_RETRIES; ++attempt) {
+        std::this_thread::yield();
+        if (queue_->tryPush(std::move(record))) {
+            enqueued_.fetch_add(1, std::memory_order_release);
+            return;
+        }
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Logger::asyncWriterLoop() {
+    // Batches in arrival order: everything (for the file), and console
+    // output split by stream
+    std::string allLines, stdoutLines, stderrLines;
+    LogRecord record;
+    uint64_t reportedDrops = 0;
+    bool dirty = false;
+    auto lastFlush = std::chrono::steady_clock::now();
+    
+    for (;;) {
+        size_t batchSize = 0;
+        bool urgent = false;
+        
+        while (batchSize < ASYNC_MAX_BATCH && queue_->tryPop(record)) {
+            std::string line = formatLogMessage(record.level, record.message, record.time);
+            line.push_back('\n');
+            
+            allLines += line;
+            (record.level >= Level::ERROR ? stderrLines : stdoutLines) += line;
+            urgent = urgent || record.level >= Level::ERROR;
+            ++batchSize;
+        }
+        
+        // Report drops once per batch instead of once per message
+        uint64_t drops = dropped_.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            std::string line = formatLogMessage(
+                Level::WARNING,
+                "Logger dropped " + std::to_string(drops - reportedDrops) +
+                " messages (async queue full)",
+                std::chrono::system_clock::now());
+            line.push_back('\n');
+            allLines += line;
+            stdoutLines += line;
+            reportedDrops = drops;
+        }
+        
+        if (!allLines.empty()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            writeBatch(stdoutLines, stderrLines, allLines);
+            dirty = true;
+        }
+        
+        // Periodic flush; errors are flushed right away
+        auto now = std::chrono::steady_clock::now();
+        if (dirty && (urgent || now - lastFlush >= flushInterval_)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (logFile_.is_open()) {
+                logFile_.flush();
+            }
+            std::cout.flush();
+            dirty = false;
+            lastFlush = now;
+        }
+        
+        written_.fetch_add(batchSize, std::memory_order_release);
+        allLines.clear();
+        stdoutLines.clear();
+        stderrLines.clear();
+        
+        // More work is already waiting
+        if (batchSize == ASYNC_MAX_BATCH) {
+            continue;
+        }
+        
+        if (stopRequested_.load(std::memory_order_acquire) && queue_->sizeApprox() == 0) {
+            break;
+        }
+        
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCondition_.wait_for(lock, ASYNC_IDLE_WAIT);
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (logFile_.is_open()) {
+        logFile_.flush();
+    }
+    std::cout.flush();
+}
+
+void Logger::writeBatch(const std::string& consoleOut, const std::string& consoleErr,
+                        const std::string& fileOut) {
+    if (destination_ == Destination::CONSOLE || destination_ == Destination::BOTH) {
+        if (!consoleOut.empty()) {
+            std::cout.write(consoleOut.data(), static_cast<std::streamsize>(consoleOut.size()));
+        }
+        if (!consoleErr.empty()) {
+            std::cerr.write(consoleErr.data(), static_cast<std::streamsize>(consoleErr.size()));
+        }
+    }
+    
+    if ((destination_ == Destination::FILE || destination_ == Destination::BOTH)
+        && logFile_.is_open() && !fileOut.empty()) {
+        logFile_.write(fileOut.data(), static_cast<std::streamsize>(fileOut.size()));
+    }
 }
 
 // LogStream implementation
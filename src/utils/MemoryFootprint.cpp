@@ -0,0 +1,77 @@
+#include "utils/MemoryFootprint.hpp"
+#include <iomanip>
+#include <sstream>
+
+namespace poker {
+
+void TableFootprint::addAllocation(size_t bytes, size_t count) {
+    allocations += count;
+    allocatorOverhead += count * mallocOverhead(bytes);
+}
+
+TableFootprint& TableFootprint::operator+=(const TableFootprint& other) {
+    entries += other.entries;
+    actions += other.actions;
+    nodeBytes += other.nodeBytes;
+    keyBytes += other.keyBytes;
+    bucketBytes += other.bucketBytes;
+    allocations += other.allocations;
+    allocatorOverhead += other.allocatorOverhead;
+    return *this;
+}
+
+std::string TableFootprint::toString() const {
+    std::ostringstream oss;
+    oss << name << ": " << entries << " entries";
+    if (actions > 0) {
+        oss << ", " << std::fixed << std::setprecision(2) << avgActionsPerEntry() << " actions/entry";
+    }
+    oss << ", " << formatBytes(totalBytes()) << " (nodes " << formatBytes(nodeBytes)
+        << ", keys " << formatBytes(keyBytes) << ", buckets " << formatBytes(bucketBytes)
+        << ", allocator " << formatBytes(allocatorOverhead) << ")";
+    return oss.str();
+}
+
+std::string formatBytes(size_t bytes) {
+    static const char* units[] = {"B", "KB", "MB", "GB", "TB"};
+    double value = static_cast<double>(bytes);
+    int unit = 0;
+    while (value >= 1024.0 && unit < 4) {
+        value /= 1024.0;
+        unit++;
+    }
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(unit == 0 ? 0 : 1) << value << " " << units[unit];
+    return oss.str();
+}
+
+std::string formatFootprints(const std::vector<TableFootprint>& footprints) {
+    std::ostringstream oss;
+    oss << std::left << std::setw(18) << "table" << std::right
+        << std::setw(12) << "entries" << std::setw(10) << "act/ent"
+        << std::setw(12) << "nodes" << std::setw(12) << "keys" << std::setw(12) << "buckets"
+        << std::setw(12) << "allocator" << std::setw(12) << "total" << "\n";
+
+    TableFootprint total;
+    total.name = "total";
+
+    auto row = [&oss](const TableFootprint& fp) {
+        oss << std::left << std::setw(18) << fp.name << std::right
+            << std::setw(12) << fp.entries
+            << std::setw(10) << std::fixed << std::setprecision(2) << fp.avgActionsPerEntry()
+            << std::setw(12) << formatBytes(fp.nodeBytes) << std::setw(12) << formatBytes(fp.keyBytes)
+            << std::setw(12) << formatBytes(fp.bucketBytes) << std::setw(12) << formatBytes(fp.allocatorOverhead)
+            << std::setw(12) << formatBytes(fp.totalBytes()) << "\n";
+    };
+
+    for (const auto& footprint : footprints) {
+        row(footprint);
+        total += footprint;
+    }
+    row(total);
+
+    return oss.str();
+}
+
+} // namespace poker
@@ -0,0 +1,204 @@
+#include "utils/Metrics.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace poker {
+
+std::string counterToString(Counter counter) {
+    switch (counter) {
+        case Counter::NODES_VISITED: return "nodes_visited";
+        case Counter::TERMINAL_EVALS: return "terminal_evals";
+        case Counter::BUCKET_LOOKUPS: return "bucket_lookups";
+        case Counter::BUCKET_MISSES: return "bucket_misses";
+        case Counter::KEYS_BUILT: return "keys_built";
+        case Counter::REGRET_READS: return "regret_reads";
+        case Counter::REGRET_WRITES: return "regret_writes";
+        case Counter::STRATEGY_READS: return "strategy_reads";
+        case Counter::STRATEGY_WRITES: return "strategy_writes";
+        case Counter::STATE_CLONES: return "state_clones";
+        case Counter::EVICTIONS: return "evictions";
+        case Counter::ALLIN_EVALS: return "allin_evals";
+        case Counter::ALLIN_CACHE_HITS: return "allin_cache_hits";
+        case Counter::DEAL_STALLS: return "deal_stalls";
+        default: return "unknown";
+    }
+}
+
+std::string phaseToString(Phase phase) {
+    switch (phase) {
+        case Phase::DEAL: return "deal";
+        case Phase::TRAVERSAL: return "traversal";
+        case Phase::PRUNE: return "prune";
+        case Phase::CALLBACK: return "callback";
+        case Phase::CHECKPOINT: return "checkpoint";
+        case Phase::BUCKET: return "bucket";
+        case Phase::TERMINAL: return "terminal";
+        default: return "unknown";
+    }
+}
+
+std::string MetricsSnapshot::toJson() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+
+    oss << "{\n  \"counters\": {";
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        oss << (i == 0 ? "\n" : ",\n") << "    \"" << counterToString(static_cast<Counter>(i))
+            << "\": " << counters[i];
+    }
+    oss << "\n  },\n  \"phase_ms\": {";
+    for (size_t i = 0; i < PHASE_COUNT; ++i) {
+        oss << (i == 0 ? "\n" : ",\n") << "    \"" << phaseToString(static_cast<Phase>(i))
+            << "\": " << phaseNanos[i] / 1e6;
+    }
+    oss << "\n  },\n  \"iteration_latency_us\": {\n"
+        << "    \"count\": " << iterationsRecorded << ",\n"
+        << "    \"p50\": " << iterationP50Us << ",\n"
+        << "    \"p90\": " << iterationP90Us << ",\n"
+        << "    \"p99\": " << iterationP99Us << ",\n"
+        << "    \"max\": " << iterationMaxUs << "\n"
+        << "  }\n}\n";
+
+    return oss.str();
+}
+
+Metrics& Metrics::getInstance() {
+    static Metrics instance;
+    return instance;
+}
+
+Metrics::ThreadBlock* Metrics::acquireBlock() {
+    // Blocks are owned by the registry; exited threads leave theirs zeroed
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    if (!freeBlocks_.empty()) {
+        ThreadBlock* block = freeBlocks_.back();
+        freeBlocks_.pop_back();
+        return block;
+    }
+    blocks_.push_back(std::make_unique<ThreadBlock>());
+    return blocks_.back().get();
+}
+
+void Metrics::releaseBlock(ThreadBlock* block) {
+    // Fold and zero under the lock so a snapshot never counts the block twice
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    auto fold = [](std::atomic<uint64_t>& total, std::atomic<uint64_t>& value) {
+        bump(total, value.load(std::memory_order_relaxed));
+        value.store(0, std::memory_order_relaxed);
+    };
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        fold(retired_.counters[i], block->counters[i]);
+    }
+    for (size_t i = 0; i < PHASE_COUNT; ++i) {
+        fold(retired_.phaseNanos[i], block->phaseNanos[i]);
+    }
+    for (int i = 0; i < LatencyHistogram::NUM_BINS; ++i) {
+        fold(retired_.latencyBins[i], block->latencyBins[i]);
+    }
+    uint64_t maxNanos = block->latencyMax.exchange(0, std::memory_order_relaxed);
+    if (maxNanos > retired_.latencyMax.load(std::memory_order_relaxed)) {
+        retired_.latencyMax.store(maxNanos, std::memory_order_relaxed);
+    }
+    freeBlocks_.push_back(block);
+}
+
+size_t Metrics::getBlockCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    return blocks_.size();
+}
+
+void Metrics::recordIterationLatency(uint64_t nanos) {
+    ThreadBlock& block = threadBlock();
+    bump(block.latencyBins[LatencyHistogram::binIndex(nanos)], 1);
+    if (nanos > block.latencyMax.load(std::memory_order_relaxed)) {
+        block.latencyMax.store(nanos, std::memory_order_relaxed);
+    }
+}
+
+MetricsSnapshot Metrics::snapshot() const {
+    MetricsSnapshot result;
+    std::array<uint64_t, LatencyHistogram::NUM_BINS> bins{};
+    uint64_t maxNanos = 0;
+
+    auto add = [&](const ThreadBlock& block) {
+        for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+            result.counters[i] += block.counters[i].load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < PHASE_COUNT; ++i) {
+            result.phaseNanos[i] += block.phaseNanos[i].load(std::memory_order_relaxed);
+        }
+        for (int i = 0; i < LatencyHistogram::NUM_BINS; ++i) {
+            bins[i] += block.latencyBins[i].load(std::memory_order_relaxed);
+        }
+        maxNanos = std::max(maxNanos, block.latencyMax.load(std::memory_order_relaxed));
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        add(retired_);
+        for (const auto& block : blocks_) {
+            add(*block);
+        }
+    }
+
+    for (uint64_t count : bins) {
+        result.iterationsRecorded += count;
+    }
+    result.iterationMaxUs = maxNanos / 1e3;
+    if (result.iterationsRecorded == 0) {
+        return result;
+    }
+
+    // Percentiles report the middle of the bin holding the requested rank
+    auto percentile = [&](double fraction) {
+        uint64_t rank = static_cast<uint64_t>(fraction * (result.iterationsRecorded - 1)) + 1;
+        uint64_t cumulative = 0;
+        for (int i = 0; i < LatencyHistogram::NUM_BINS; ++i) {
+            cumulative += bins[i];
+            if (cumulative >= rank) {
+                double lower = static_cast<double>(LatencyHistogram::binLowerBound(i));
+                double upper = i + 1 < LatencyHistogram::NUM_BINS
+                    ? static_cast<double>(LatencyHistogram::binLowerBound(i + 1))
+                    : lower;
+                return std::min((lower + upper) / 2.0, static_cast<double>(maxNanos)) / 1e3;
+            }
+        }
+        return maxNanos / 1e3;
+    };
+
+    result.iterationP50Us = percentile(0.50);
+    result.iterationP90Us = percentile(0.90);
+    result.iterationP99Us = percentile(0.99);
+
+    return result;
+}
+
+void Metrics::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    auto clear = [](ThreadBlock& block) {
+        for (auto& value : block.counters) value.store(0, std::memory_order_relaxed);
+        for (auto& value : block.phaseNanos) value.store(0, std::memory_order_relaxed);
+        for (auto& value : block.latencyBins) value.store(0, std::memory_order_relaxed);
+        block.latencyMax.store(0, std::memory_order_relaxed);
+    };
+    clear(retired_);
+    for (auto& block : blocks_) {
+        clear(*block);
+    }
+}
+
+bool Metrics::writeJson(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open metrics file: " + filename);
+        return false;
+    }
+
+    file << snapshot().toJson();
+    return file.good();
+}
+
+} // namespace poker
\ No newline at end of file
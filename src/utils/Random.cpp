@@ -12,14 +12,32 @@ Random& Random::getInstance() {
 }
 
 Random::Random() {
-    // Initialize with time-based seed by default
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    generator_.seed(seed);
+    // Initialize with time-based seed by default; call seed() for reproducible runs
+    masterSeed_.store(static_cast<uint64_t>(
+        std::chrono::system_clock::now().time_since_epoch().count()));
 }
 
-void Random::seed(unsigned int seed) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    generator_.seed(seed);
+Xoshiro256& Random::threadGenerator() {
+    // Each thread gets its own stream the first time it draws
+    struct ThreadStream {
+        Xoshiro256 generator;
+        ThreadStream() {
+            Random& random = getInstance();
+            uint64_t threadIndex = random.nextThreadIndex_.fetch_add(1, std::memory_order_relaxed);
+            generator = Xoshiro256::forStream(random.getSeed(), 0, threadIndex);
+        }
+    };
+    thread_local ThreadStream stream;
+    return stream.generator;
+}
+
+void Random::seed(uint64_t seed) {
+    masterSeed_.store(seed, std::memory_order_relaxed);
+    threadGenerator() = Xoshiro256::forStream(seed, 0, 0);
+}
+
+void Random::beginStream(uint64_t iteration, uint64_t threadIndex) {
+    threadGenerator() = Xoshiro256::forStream(getSeed(), iteration, threadIndex);
 }
 
 int Random::getInt(int min, int max) {
@@ -27,9 +45,8 @@ int Random::getInt(int min, int max) {
         std::swap(min, max);
     }
     
-    std::lock_guard<std::mutex> lock(mutex_);
     std::uniform_int_distribution<int> dist(min, max);
-    return dist(generator_);
+    return dist(threadGenerator());
 }
 
 double Random::getDouble(double min, double max) {
@@ -37,9 +54,7 @@ double Random::getDouble(double min, double max) {
         std::swap(min, max);
     }
     
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::uniform_real_distribution<double> dist(min, max);
-    return dist(generator_);
+    return min + (max - min) * threadGenerator().nextDouble();
 }
 
 bool Random::getBool(double probability) {
@@ -47,18 +62,11 @@ bool Random::getBool(double probability) {
         throw std::invalid_argument("Probability must be between 0 and 1");
     }
     
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::bernoulli_distribution dist(probability);
-    return dist(generator_);
-}
-
-std::mt19937& Random::getGenerator() {
-    // Note: This is not thread-safe, use with caution
-    return generator_;
+    return threadGenerator().nextDouble() < probability;
 }
 
 // Non-specialized helper functions for Action
-Action sampleActionFromMap(const std::unordered_map<Action, double, std::hash<Action>>& distribution, std::mt19937& generator) {
+Action sampleActionFromMap(const std::unordered_map<Action, double, std::hash<Action>>& distribution, Xoshiro256& generator) {
     if (distribution.empty()) {
         throw std::invalid_argument("Cannot sample from empty distribution");
     }
@@ -102,7 +110,7 @@ Action sampleActionFromMap(const std::unordered_map<Action, double, std::hash<Ac
 }
 
 // Non-specialized helper functions for Action
-Action sampleActionUniform(const std::vector<Action>& elements, std::mt19937& generator) {
+Action sampleActionUniform(const std::vector<Action>& elements, Xoshiro256& generator) {
     if (elements.empty()) {
         throw std::invalid_argument("Cannot sample from empty vector");
     }
@@ -113,27 +121,23 @@ Action sampleActionUniform(const std::vector<Action>& elements, std::mt19937& ge
 
 // Specialization for RegretTable::ActionHash and StrategyTable::ActionHash
 Action Random::sample(const std::unordered_map<Action, double, RegretTable::ActionHash>& distribution) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     // Convert to a std::hash<Action> map for helper function
     std::unordered_map<Action, double, std::hash<Action>> standardMap;
     for (const auto& [action, prob] : distribution) {
         standardMap[action] = prob;
     }
     
-    return sampleActionFromMap(standardMap, generator_);
+    return sampleActionFromMap(standardMap, threadGenerator());
 }
 
 Action Random::sample(const std::unordered_map<Action, double, StrategyTable::ActionHash>& distribution) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     // Convert to a std::hash<Action> map for helper function
     std::unordered_map<Action, double, std::hash<Action>> standardMap;
     for (const auto& [action, prob] : distribution) {
         standardMap[action] = prob;
     }
     
-    return sampleActionFromMap(standardMap, generator_);
+    return sampleActionFromMap(standardMap, threadGenerator());
 }
 
 } // namespace poker
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "utils/Trace.hpp"
+#include "utils/Logger.hpp"
+#include <fstream>
+#include <iomanip>
+
+namespace poker {
+
+namespace {
+
+// Write text as the body of a JSON string literal
+void writeJsonString(std::ostream& out, const char* text) {
+    static const char hex[] = "0123456789abcdef";
+    for (const char* c = text; *c != '\0'; ++c) {
+        unsigned char ch = static_cast<unsigned char>(*c);
+        switch (ch) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (ch < 0x20) {
+                    out << "\\u00" << hex[ch >> 4] << hex[ch & 0xf];
+                } else {
+                    out << *c;
+                }
+        }
+    }
+}
+
+} // namespace
+
+Tracer& Tracer::getInstance() {
+    static Tracer instance;
+    return instance;
+}
+
+void Tracer::start(size_t eventsPerThread) {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+
+    eventsPerThread_ = eventsPerThread;
+    for (auto& buffer : buffers_) {
+        if (!buffer->live) {
+            // Exited thread: nothing left to keep
+            if (buffer->count.load(std::memory_order_relaxed) > 0 ||
+                buffer->dropped.load(std::memory_order_relaxed) > 0) {
+                recycleLocked(buffer.get());
+            }
+            continue;
+        }
+        if (buffer->capacity != eventsPerThread_) {
+            resizeLocked(buffer.get());
+        }
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+
+    epoch_ = std::chrono::steady_clock::now();
+    enabled_.store(true, std::memory_order_release);
+}
+
+void Tracer::stop() {
+    enabled_.store(false, std::memory_order_release);
+}
+
+Tracer::ThreadBuffer* Tracer::acquireBuffer() {
+    // The registry owns every buffer so spans outlive their thread
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    ThreadBuffer* buffer;
+    if (!freeBuffers_.empty()) {
+        buffer = freeBuffers_.back();
+        freeBuffers_.pop_back();
+    } else {
+        buffers_.push_back(std::make_unique<ThreadBuffer>());
+        buffer = buffers_.back().get();
+    }
+    if (buffer->capacity != eventsPerThread_) {
+        resizeLocked(buffer);
+    }
+    buffer->live = true;
+    buffer->threadId = ++nextThreadId_;
+    buffer->threadName = "thread " + std::to_string(buffer->threadId);
+    return buffer;
+}
+
+void Tracer::releaseBuffer(ThreadBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffer->live = false;
+    // Spans are kept until writeChromeTrace() or start() has dealt with them
+    if (buffer->count.load(std::memory_order_relaxed) == 0 &&
+        buffer->dropped.load(std::memory_order_relaxed) == 0) {
+        recycleLocked(buffer);
+    }
+}
+
+void Tracer::recycleLocked(ThreadBuffer* buffer) {
+    for (size_t i = 0; i < buffer->numChunks; ++i) {
+        buffer->chunks[i].reset();
+    }
+    buffer->count.store(0, std::memory_order_relaxed);
+    buffer->dropped.store(0, std::memory_order_relaxed);
+    freeBuffers_.push_back(buffer);
+}
+
+void Tracer::resizeLocked(ThreadBuffer* buffer) const {
+    buffer->numChunks = (eventsPerThread_ + CHUNK_EVENTS - 1) / CHUNK_EVENTS;
+    buffer->chunks = std::make_unique<std::unique_ptr<TraceEvent[]>[]>(buffer->numChunks);
+    buffer->capacity = eventsPerThread_;
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffer.threadName = name;
+}
+
+void Tracer::record(const char* name, std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::time_point end, int64_t arg) {
+    ThreadBuffer& buffer = threadBuffer();
+
+    // Only this thread writes count, so a relaxed load sees its own latest value
+    size_t index = buffer.count.load(std::memory_order_relaxed);
+    if (index >= buffer.capacity) {
+        buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto sinceEpoch = [this](std::chrono::steady_clock::time_point time) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time - epoch_).count();
+        return ns > 0 ? static_cast<uint64_t>(ns) : 0;
+    };
+
+    // OPTIMIZATION: Chunks are allocated on first use, so threads that record
+    // a handful of spans never pay for a full buffer
+    std::unique_ptr<TraceEvent[]>& chunk = buffer.chunks[index / CHUNK_EVENTS];
+    if (!chunk) {
+        chunk = std::make_unique<TraceEvent[]>(CHUNK_EVENTS);
+    }
+    TraceEvent& event = chunk[index % CHUNK_EVENTS];
+    event.name = name;
+    event.startNs = sinceEpoch(start);
+    event.durationNs = sinceEpoch(end) - event.startNs;
+    event.arg = arg;
+
+    // Publish the span to writeChromeTrace
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+size_t Tracer::getEventCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    size_t total = 0;
+    for (const auto& buffer : buffers_) {
+        total += buffer->count.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+uint64_t Tracer::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    uint64_t total = 0;
+    for (const auto& buffer : buffers_) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t Tracer::getBufferCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    return buffers_.size();
+}
+
+bool Tracer::writeChromeTrace(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open trace file: " + filename);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex_);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << std::fixed << std::setprecision(3);
+
+    bool first = true;
+    uint64_t dropped = 0;
+    for (const auto& buffer : buffers_) {
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        if (!buffer->live && count == 0 && buffer->dropped.load(std::memory_order_relaxed) == 0) {
+            continue;       // Free for reuse
+        }
+
+        // Thread name metadata
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+             << ",\"args\":{\"name\":\"";
+        writeJsonString(file, buffer->threadName.c_str());
+        file << "\"}}";
+        first = false;
+
+        // Spans published so far (safe to read while the thread keeps recording)
+        for (size_t i = 0; i < count; ++i) {
+            const TraceEvent& event = buffer->chunks[i / CHUNK_EVENTS][i % CHUNK_EVENTS];
+            file << ",\n{\"name\":\"";
+            writeJsonString(file, event.name);
+            file << "\",\"cat\":\"poker\",\"ph\":\"X\""
+                 << ",\"ts\":" << event.startNs / 1e3
+                 << ",\"dur\":" << event.durationNs / 1e3
+                 << ",\"pid\":1,\"tid\":" << buffer->threadId;
+            if (event.arg >= 0) {
+                file << ",\"args\":{\"arg\":" << event.arg << "}";
+            }
+            file << "}";
+        }
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+
+    file << "\n],\"otherData\":{\"dropped_events\":" << dropped << "}}\n";
+
+    // Spans of exited threads are written; their buffers can be reused
+    for (auto& buffer : buffers_) {
+        if (!buffer->live && (buffer->count.load(std::memory_order_relaxed) > 0 ||
+                              buffer->dropped.load(std::memory_order_relaxed) > 0)) {
+            recycleLocked(buffer.get());
+        }
+    }
+
+    if (dropped > 0) {
+        LOG_WARNING("Trace buffers overflowed; " + std::to_string(dropped) + " spans dropped");
+    }
+
+    return file.good();
+}
+
+} // namespace poker
\ No newline at end of file
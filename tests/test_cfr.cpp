@@ -0,0 +1,682 @@
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cfr/CFRSolver.hpp"
+#include "cfr/Checkpoint.hpp"
+#include "cfr/SubgameSolver.hpp"
+#include "cfr/DealPipeline.hpp"
+#include "cfr/RegretTable.hpp"
+#include "cfr/StrategyTable.hpp"
+#include "game/Action.hpp"
+#include "runtime/MappedStrategy.hpp"
+#include "runtime/StrategyProtocol.hpp"
+#include "runtime/StrategyQueryEngine.hpp"
+#include "utils/Logger.hpp"
+
+using namespace poker;
+
+// Simple testing framework
+#define TEST(name) void name()
+#define ASSERT(condition) assert(condition)
+#define ASSERT_EQ(a, b) assert((a) == (b))
+#define ASSERT_NE(a, b) assert((a) != (b))
+#define ASSERT_TRUE(a) assert(a)
+#define ASSERT_FALSE(a) assert(!(a))
+#define RUN_TEST(name) std::cout << "Running " << #name << "... "; name(); std::cout << "PASSED" << std::endl
+
+namespace {
+
+const std::string CHECKPOINT_FILE = "test_cfr_checkpoint.bin";
+
+// Fill tables with entries shaped like training output
+void fillTables(RegretTable& regrets, StrategyTable& strategies, int infoSets) {
+    for (int i = 0; i < infoSets; ++i) {
+        std::string infoSet = "BTN|FLOP|" + std::to_string(i % 200) + "|r" + std::to_string(i);
+        regrets.addRegret(infoSet, Action::fold(), 0.5 * i);
+        regrets.addRegret(infoSet, Action::call(2.0), 1.0 + i);
+        regrets.addRegret(infoSet, Action::raise(6.5), 2.0);
+
+        strategies.setStrategy(infoSet, Action::call(2.0), 0.75);
+        strategies.addToStrategySum(infoSet, Action::call(2.0), 3.0 * i);
+        // Only in the sum
+        strategies.addToStrategySum(infoSet, Action::raise(6.5), 1.0);
+    }
+}
+
+// Split an encoded frame into header and body
+void splitFrame(const std::vector<char>& frame, StrategyProtocol::FrameHeader& header, std::vector<char>& body) {
+    std::memcpy(&header, frame.data(), sizeof(header));
+    body.assign(frame.begin() + sizeof(header), frame.end());
+}
+
+// Checkpoint files a and b hold the same regret and strategy tables
+void assertSameTables(const std::string& a, const std::string& b) {
+    RegretTable regretsA, regretsB;
+    StrategyTable strategiesA, strategiesB;
+    CheckpointMetadata metadataA, metadataB;
+    ASSERT_TRUE(Checkpoint::load(a, metadataA, regretsA, strategiesA));
+    ASSERT_TRUE(Checkpoint::load(b, metadataB, regretsB, strategiesB));
+    ASSERT_EQ(metadataA.iteration, metadataB.iteration);
+
+    ASSERT_TRUE(regretsA.size() > 0);
+    ASSERT_EQ(regretsA.size(), regretsB.size());
+    ASSERT_EQ(strategiesA.size(), strategiesB.size());
+    for (const auto& infoSet : regretsA.getAllInfoSets()) {
+        ASSERT_TRUE(regretsA.getRegrets(infoSet) == regretsB.getRegrets(infoSet));
+    }
+    for (const auto& infoSet : strategiesA.getAllInfoSets()) {
+        ASSERT_TRUE(strategiesA.getStrategies(infoSet) == strategiesB.getStrategies(infoSet));
+        ASSERT_TRUE(strategiesA.getAverageStrategies(infoSet) == strategiesB.getAverageStrategies(infoSet));
+    }
+}
+
+// Check or call passiveActions times from deal, opening each street as the
+// previous one closes (as the solvers do)
+GameState passiveSpot(const DealOutcome& deal, int passiveActions) {
+    GameState state;
+    state.reset(deal);
+    state.dealHoleCards();
+    for (int i = 0; i < passiveActions; ++i) {
+        std::vector<Action> valid = state.getValidActions();
+        auto it = std::find_if(valid.begin(), valid.end(), [](const Action& action) {
+            return action.getType() == ActionType::CHECK || action.getType() == ActionType::CALL;
+        });
+        if (state.applyAction(*it) && !state.isTerminal()) {
+            state.startNextBettingRound();
+        }
+    }
+    return state;
+}
+
+GameState passiveSpot(uint64_t seed, int passiveActions) {
+    Xoshiro256 rng(seed);
+    Deck deck;
+    return passiveSpot(deck.drawOutcome(rng), passiveActions);
+}
+
+std::unique_ptr<CFRSolver> makeSolver() {
+    return std::make_unique<CFRSolver>(std::make_unique<GameState>(),
+                                       HandAbstraction::create(HandAbstraction::Level::STANDARD),
+                                       BetAbstraction::create(BetAbstraction::Level::STANDARD));
+}
+
+} // namespace
+
+// Tests for checkpoint save/load
+TEST(test_checkpoint_roundtrip) {
+    RegretTable regrets;
+    StrategyTable strategies;
+    fillTables(regrets, strategies, 5000);
+
+    CheckpointMetadata saved;
+    saved.handAbstraction = 2;
+    saved.betAbstraction = 1;
+    saved.iteration = 1234;
+    saved.seed = 99;
+    saved.nodesVisited = 123456789;
+    saved.trainingMillis = 4321.5;
+    ASSERT_TRUE(Checkpoint::save(CHECKPOINT_FILE, saved, regrets, strategies, 4));
+
+    RegretTable loadedRegrets;
+    StrategyTable loadedStrategies;
+    loadedRegrets.addRegret("stale", Action::fold(), 1.0);
+    CheckpointMetadata loaded;
+    ASSERT_TRUE(Checkpoint::load(CHECKPOINT_FILE, loaded, loadedRegrets, loadedStrategies, 3));
+
+    ASSERT_EQ(loaded.handAbstraction, 2u);
+    ASSERT_EQ(loaded.betAbstraction, 1u);
+    ASSERT_EQ(loaded.iteration, 1234u);
+    ASSERT_EQ(loaded.seed, 99u);
+    ASSERT_EQ(loaded.nodesVisited, 123456789u);
+    ASSERT_EQ(loaded.trainingMillis, 4321.5);
+
+    ASSERT_EQ(loadedRegrets.size(), regrets.size());
+    ASSERT_EQ(loadedStrategies.size(), strategies.size());
+    ASSERT_FALSE(loadedRegrets.hasInfoSet("stale"));
+    ASSERT_TRUE(loadedRegrets.memoryBytes() > 0);
+
+    for (const auto& infoSet : regrets.getAllInfoSets()) {
+        ASSERT_TRUE(loadedRegrets.getRegrets(infoSet) == regrets.getRegrets(infoSet));
+        ASSERT_TRUE(loadedStrategies.getStrategies(infoSet) == strategies.getStrategies(infoSet));
+        ASSERT_TRUE(loadedStrategies.getAverageStrategies(infoSet) == strategies.getAverageStrategies(infoSet));
+    }
+
+    std::remove(CHECKPOINT_FILE.c_str());
+}
+
+// A snapshot keeps the state it was captured from while the tables move on
+TEST(test_checkpoint_snapshot) {
+    RegretTable regrets;
+    StrategyTable strategies;
+    fillTables(regrets, strategies, 3000);
+
+    RegretTable expectedRegrets;
+    StrategyTable expectedStrategies;
+    fillTables(expectedRegrets, expectedStrategies, 3000);
+
+    CheckpointMetadata metadata;
+    metadata.iteration = 77;
+    CheckpointSnapshot snapshot = Checkpoint::capture(metadata, regrets, strategies, 4);
+    ASSERT_TRUE(snapshot.bytes() > 0);
+
+    // Training continues after the capture
+    regrets.addRegret("BTN|FLOP|0|r0", Action::fold(), 100.0);
+    strategies.addToStrategySum("BTN|TURN|1|new", Action::call(2.0), 1.0);
+
+    ASSERT_TRUE(Checkpoint::write(CHECKPOINT_FILE, snapshot));
+
+    RegretTable loadedRegrets;
+    StrategyTable loadedStrategies;
+    CheckpointMetadata loaded;
+    ASSERT_TRUE(Checkpoint::load(CHECKPOINT_FILE, loaded, loadedRegrets, loadedStrategies, 2));
+    ASSERT_EQ(loaded.iteration, 77u);
+    ASSERT_EQ(loadedStrategies.size(), expectedStrategies.size());
+    for (const auto& infoSet : expectedRegrets.getAllInfoSets()) {
+        ASSERT_TRUE(loadedRegrets.getRegrets(infoSet) == expectedRegrets.getRegrets(infoSet));
+        ASSERT_TRUE(loadedStrategies.getAverageStrategies(infoSet) == expectedStrategies.getAverageStrategies(infoSet));
+    }
+
+    std::remove(CHECKPOINT_FILE.c_str());
+}
+
+// A flipped byte must fail the load instead of restoring bad values
+TEST(test_checkpoint_corruption) {
+    RegretTable regrets;
+    StrategyTable strategies;
+    fillTables(regrets, strategies, 1000);
+
+    CheckpointMetadata metadata;
+    ASSERT_TRUE(Checkpoint::save(CHECKPOINT_FILE, metadata, regrets, strategies, 2));
+
+    {
+        std::fstream file(CHECKPOINT_FILE, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(200);
+        char byte = 0;
+        file.read(&byte, 1);
+        byte ^= 0x40;
+        file.seekp(200);
+        file.write(&byte, 1);
+    }
+
+    RegretTable loadedRegrets;
+    StrategyTable loadedStrategies;
+    ASSERT_FALSE(Checkpoint::load(CHECKPOINT_FILE, metadata, loadedRegrets, loadedStrategies, 2));
+    ASSERT_EQ(loadedRegrets.size(), 0u);
+    ASSERT_EQ(loadedStrategies.size(), 0u);
+
+    std::remove(CHECKPOINT_FILE.c_str());
+}
+
+// train(a), checkpoint, resume in a new solver, train(b) gives the same
+// tables as an uninterrupted train(a + b); the run crosses a pruning pass
+TEST(test_checkpoint_resume) {
+    const std::string resumedFile = "test_cfr_resumed.bin";
+    const std::string straightFile = "test_cfr_straight.bin";
+    const int first = 15;
+    const int second = 10;
+    const auto mode = CFRSolver::TraversalMode::MONTE_CARLO;
+
+    {
+        auto solver = makeSolver();
+        solver->setSeed(11);
+        // The checkpoint at iteration 15 goes through the background writer
+        solver->setCheckpointing(CHECKPOINT_FILE, first);
+        solver->train(first, mode);
+        ASSERT_TRUE(solver->waitForCheckpoint());
+    }
+    {
+        auto solver = makeSolver();
+        solver->setSeed(999);       // Replaced by the checkpoint's seed
+        ASSERT_TRUE(solver->loadCheckpoint(CHECKPOINT_FILE));
+        solver->train(second, mode);
+        ASSERT_TRUE(solver->saveCheckpoint(resumedFile));
+    }
+    {
+        auto solver = makeSolver();
+        solver->setSeed(11);
+        solver->train(first + second, mode);
+        ASSERT_TRUE(solver->saveCheckpoint(straightFile));
+    }
+    assertSameTables(resumedFile, straightFile);
+
+    std::remove(CHECKPOINT_FILE.c_str());
+    std::remove(resumedFile.c_str());
+    std::remove(straightFile.c_str());
+}
+
+// Mapped lookups match the table they were exported from, within the
+// precision of each encoding
+TEST(test_mapped_strategy) {
+    const std::string file = "test_cfr_strategy.rts";
+    RegretTable regrets;
+    StrategyTable strategies;
+    fillTables(regrets, strategies, 2000);
+    // Current strategy only: not exported
+    strategies.setStrategy("SB|PREFLOP|3|", Action::fold(), 1.0);
+
+    std::vector<Action> actions = {Action::fold(), Action::call(2.0), Action::raise(6.5)};
+    double expected[3];
+    double actual[3];
+    size_t previousBytes = 0;
+
+    for (auto encoding : {MappedStrategy::Encoding::FLOAT32, MappedStrategy::Encoding::Q16,
+                          MappedStrategy::Encoding::Q8}) {
+        ASSERT_TRUE(MappedStrategy::write(file, strategies, encoding));
+
+        MappedStrategy mapped;
+        ASSERT_TRUE(mapped.open(file));
+        ASSERT_TRUE(mapped.encoding() == encoding);
+        ASSERT_EQ(mapped.size(), 2000u);
+        ASSERT_TRUE(mapped.find("SB|PREFLOP|3|") == nullptr);
+        ASSERT_TRUE(mapped.find("missing") == nullptr);
+
+        // Narrower encodings give smaller files
+        if (previousBytes > 0) {
+            ASSERT_TRUE(mapped.mappedBytes() < previousBytes);
+        }
+        previousBytes = mapped.mappedBytes();
+
+        double tolerance = encoding == MappedStrategy::Encoding::FLOAT32 ? 1e-6
+                         : encoding == MappedStrategy::Encoding::Q16 ? 2.0 / 65535 : 2.0 / 255;
+        for (const auto& infoSet : strategies.getAllInfoSets()) {
+            bool visited = strategies.getAverageStrategy(infoSet, actions, expected);
+            ASSERT_EQ(mapped.getAverageStrategy(infoSet, actions, actual), visited);
+            double sum = 0.0;
+            for (int i = 0; i < 3; ++i) {
+                ASSERT_TRUE(std::abs(expected[i] - actual[i]) < tolerance);
+                sum += actual[i];
+            }
+            ASSERT_TRUE(std::abs(sum - 1.0) < 1e-9);
+        }
+
+        // Unknown info sets fall back to uniform
+        ASSERT_FALSE(mapped.getAverageStrategy("missing", actions, actual));
+        ASSERT_TRUE(std::abs(actual[0] - 1.0 / 3.0) < 1e-12);
+
+        // Moves keep the mapping valid
+        MappedStrategy moved = std::move(mapped);
+        ASSERT_FALSE(mapped.isOpen());
+        ASSERT_TRUE(moved.find("BTN|FLOP|5|r5") != nullptr);
+        ASSERT_EQ(moved.getAverageStrategies("BTN|FLOP|5|r5").size(), 2u);
+    }
+
+    // A flipped byte anywhere in the body, or a cut-off file, is rejected
+    std::ifstream input(file, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    for (size_t offset : {size_t(200), bytes.size() / 2, bytes.size() - 1}) {
+        std::string corrupt = bytes;
+        corrupt[offset] ^= 0x40;
+        std::ofstream(file, std::ios::binary | std::ios::trunc).write(corrupt.data(), corrupt.size());
+        MappedStrategy mapped;
+        ASSERT_FALSE(mapped.open(file));
+        ASSERT_FALSE(mapped.isOpen());
+    }
+    std::ofstream(file, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size() - 8);
+    MappedStrategy truncated;
+    ASSERT_FALSE(truncated.open(file));
+    std::ofstream(file, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+    ASSERT_TRUE(truncated.open(file));
+
+    std::remove(file.c_str());
+}
+
+// Prefetched deals match deals prepared inline, and both match drawing from
+// the start of each iteration's stream
+TEST(test_deal_pipeline) {
+    auto abstraction = HandAbstraction::create(HandAbstraction::Level::STANDARD);
+    const uint64_t seed = 7;
+    const uint64_t first = 100;
+    const uint64_t count = 50;
+
+    DealPipeline synchronous(abstraction, seed, first, count, 0);
+    DealPipeline prefetched(abstraction, seed, first, count, 4);
+    DealPipeline::PreparedDeal expected;
+    DealPipeline::PreparedDeal actual;
+    for (uint64_t i = 0; i < count; ++i) {
+        synchronous.next(expected);
+        prefetched.next(actual);
+        ASSERT_EQ(actual.iteration, first + i);
+        ASSERT_EQ(expected.iteration, first + i);
+        ASSERT_TRUE(actual.deal == expected.deal);
+        ASSERT_TRUE(actual.buckets == expected.buckets);
+        ASSERT_TRUE(actual.stream == expected.stream);
+
+        Xoshiro256 stream = Xoshiro256::forStream(seed, first + i, 0);
+        Deck deck;
+        ASSERT_TRUE(deck.drawOutcome(stream) == actual.deal);
+        ASSERT_TRUE(stream == actual.stream);
+    }
+
+    bool exhausted = false;
+    try {
+        prefetched.next(actual);
+    } catch (const std::logic_error&) {
+        exhausted = true;
+    }
+    ASSERT_TRUE(exhausted);
+    ASSERT_EQ(prefetched.nextIteration(), first + count);
+
+    // An unbounded pipeline carries on past any count; destroying it joins
+    // the producer
+    DealPipeline unbounded(abstraction, seed, first, DealPipeline::UNBOUNDED, 2);
+    for (uint64_t i = 0; i < 2 * count; ++i) {
+        unbounded.next(actual);
+    }
+    ASSERT_EQ(actual.iteration, first + 2 * count - 1);
+    ASSERT_EQ(unbounded.nextIteration(), first + 2 * count);
+
+    // With ranges on, every combo is bucketed on every street, and the dealt
+    // hands keep the buckets play-time lookups give them
+    DealPipeline ranged(abstraction, seed, first, 1, 0, true);
+    ranged.next(actual);
+    ASSERT_EQ(actual.showdown.board(), actual.deal.boardMask(BOARD_SIZE));
+    const std::vector<CardMask>& hands = actual.showdown.hands();
+    for (int round = 0; round < 4; ++round) {
+        ASSERT_EQ(actual.rangeBuckets[round].size(), hands.size());
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            auto hand = std::find(hands.begin(), hands.end(), actual.deal.holeMask(static_cast<Position>(p)));
+            ASSERT_TRUE(hand != hands.end());
+            ASSERT_EQ(actual.rangeBuckets[round][hand - hands.begin()], actual.buckets[p][round]);
+        }
+    }
+
+    // Stopping early joins the producer
+    DealPipeline abandoned(abstraction, seed, 0, 1000, 2);
+    abandoned.next(actual);
+}
+
+// Play-time keys match training keys byte for byte, and batched queries
+// (more than one window) agree with single queries
+TEST(test_query_engine_keys) {
+    const std::string file = "test_cfr_engine.rts";
+    const size_t numDecisions = 2 * StrategyQueryEngine::BATCH_WINDOW + 7;
+    auto handAbstraction = HandAbstraction::create(HandAbstraction::Level::STANDARD);
+    CFRSolver solver(std::make_unique<GameState>(), handAbstraction,
+                     BetAbstraction::create(BetAbstraction::Level::STANDARD));
+
+    // One spot per decision on every street, reached by checking and calling
+    std::vector<std::string> histories;
+    std::vector<std::vector<Action>> actions;
+    std::vector<StrategyQueryEngine::Decision> decisions;
+    histories.reserve(numDecisions);
+    actions.reserve(numDecisions);
+    const int boardCardsByRound[4] = {0, 3, 4, 5};
+    for (size_t d = 0; d < numDecisions; ++d) {
+        GameState state = passiveSpot(5 + d, static_cast<int>(d % 10));
+        const DealOutcome& deal = state.getDeal();
+        ASSERT_FALSE(state.isTerminal());
+
+        Position position = state.getCurrentPosition();
+        histories.push_back(state.getActionHistory().toString());
+        actions.push_back(solver.getAbstractedActions(state));
+        StrategyQueryEngine::Decision decision{
+            position, deal.holeMask(position),
+            deal.boardMask(boardCardsByRound[static_cast<int>(state.getBettingRound())]),
+            &histories.back(), actions.back().data(), actions.back().size()};
+        decisions.push_back(decision);
+
+        ASSERT_EQ(StrategyQueryEngine::infoSetKey(*handAbstraction, decision),
+                  solver.getAbstractedInfoSet(state, position));
+    }
+
+    // Strategy for two thirds of the spots
+    StrategyTable strategies;
+    for (size_t d = 0; d < numDecisions; d += 3) {
+        std::string key = StrategyQueryEngine::infoSetKey(*handAbstraction, decisions[d]);
+        for (size_t a = 0; a < actions[d].size(); ++a) {
+            strategies.addToStrategySum(key, actions[d][a], 1.0 + a + d);
+        }
+    }
+    for (size_t d = 1; d < numDecisions; d += 3) {
+        std::string key = StrategyQueryEngine::infoSetKey(*handAbstraction, decisions[d]);
+        strategies.addToStrategySum(key, actions[d][0], 2.0);
+    }
+    ASSERT_TRUE(MappedStrategy::write(file, strategies, MappedStrategy::Encoding::FLOAT32));
+    auto mapped = std::make_shared<MappedStrategy>();
+    ASSERT_TRUE(mapped->open(file));
+    StrategyQueryEngine engine(mapped, handAbstraction);
+
+    size_t totalActions = 0;
+    for (const auto& list : actions) {
+        totalActions += list.size();
+    }
+    std::vector<double> batched(totalActions);
+    std::unique_ptr<bool[]> found(new bool[numDecisions]);
+    size_t numFound = engine.queryBatch(decisions.data(), decisions.size(), batched.data(), found.get());
+    ASSERT_TRUE(numFound > 0 && numFound < numDecisions);
+
+    size_t offset = 0;
+    size_t singleFound = 0;
+    for (size_t d = 0; d < numDecisions; ++d) {
+        std::vector<double> single(actions[d].size());
+        bool hit = engine.query(decisions[d], single.data());
+        ASSERT_EQ(hit, found[d]);
+        singleFound += hit;
+        for (size_t a = 0; a < actions[d].size(); ++a) {
+            ASSERT_EQ(single[a], batched[offset + a]);
+        }
+        offset += actions[d].size();
+    }
+    ASSERT_EQ(singleFound, numFound);
+
+    std::remove(file.c_str());
+}
+
+// Requests and responses survive encoding unchanged
+TEST(test_protocol_roundtrip) {
+    std::vector<Action> actions = {Action::fold(), Action::call(2.0), Action::raise(6.5)};
+    std::vector<std::string> histories = {"", "BTN:call 2.0", "BTN:raise 6.5, SB:fold, BB:call 6.5 | BB:check"};
+    std::vector<StrategyQueryEngine::Decision> decisions = {
+        {Position::BTN, cardBit(0) | cardBit(51), 0, &histories[0], actions.data(), 3},
+        {Position::SB, cardBit(12) | cardBit(25), cardBit(1) | cardBit(2) | cardBit(3), &histories[1],
+         actions.data() + 1, 2},
+        {Position::BB, cardBit(40) | cardBit(41), cardBit(1) | cardBit(2) | cardBit(3) | cardBit(4) | cardBit(5),
+         &histories[2], actions.data(), 1},
+    };
+
+    std::vector<char> frame;
+    StrategyProtocol::encodeRequest(77, decisions.data(), decisions.size(), frame);
+    StrategyProtocol::FrameHeader header;
+    std::vector<char> body;
+    splitFrame(frame, header, body);
+    ASSERT_EQ(header.magic, StrategyProtocol::REQUEST_MAGIC);
+    ASSERT_EQ(header.numDecisions, 3u);
+    ASSERT_EQ(header.bodyBytes, body.size());
+
+    StrategyProtocol::Request request;
+    ASSERT_TRUE(StrategyProtocol::decodeRequest(header, body, request));
+    ASSERT_EQ(request.requestId, 77u);
+    ASSERT_EQ(request.decisions.size(), decisions.size());
+    for (size_t i = 0; i < decisions.size(); ++i) {
+        const auto& decoded = request.decisions[i];
+        ASSERT_TRUE(decoded.position == decisions[i].position);
+        ASSERT_EQ(decoded.holeCards, decisions[i].holeCards);
+        ASSERT_EQ(decoded.board, decisions[i].board);
+        ASSERT_EQ(*decoded.history, *decisions[i].history);
+        ASSERT_EQ(decoded.numActions, decisions[i].numActions);
+        for (size_t a = 0; a < decoded.numActions; ++a) {
+            ASSERT_TRUE(decoded.actions[a] == decisions[i].actions[a]);
+        }
+    }
+
+    bool found[3] = {true, false, true};
+    double probabilities[6] = {0.25, 0.5, 0.25, 0.5, 0.5, 1.0};
+    StrategyProtocol::encodeResponse(77, StrategyProtocol::Status::OK, found, 3, probabilities, 6, frame);
+    splitFrame(frame, header, body);
+    StrategyProtocol::Response response;
+    ASSERT_TRUE(StrategyProtocol::decodeResponse(header, body, response));
+    ASSERT_EQ(response.requestId, 77u);
+    ASSERT_TRUE(response.status == StrategyProtocol::Status::OK);
+    ASSERT_TRUE(response.found == std::vector<uint8_t>({1, 0, 1}));
+    ASSERT_EQ(response.probabilities.size(), 6u);
+    for (size_t i = 0; i < 6; ++i) {
+        ASSERT_EQ(response.probabilities[i], static_cast<float>(probabilities[i]));
+    }
+}
+
+// Requests the engine cannot answer are rejected when decoded
+TEST(test_protocol_malformed) {
+    Action action = Action::check();
+    std::string history;
+    const CardMask hole = cardBit(10) | cardBit(20);
+    const CardMask flop = cardBit(1) | cardBit(2) | cardBit(3);
+    auto decodes = [&](Position position, CardMask holeCards, CardMask board) {
+        StrategyQueryEngine::Decision decision{position, holeCards, board, &history, &action, 1};
+        std::vector<char> frame;
+        StrategyProtocol::encodeRequest(1, &decision, 1, frame);
+        StrategyProtocol::FrameHeader header;
+        std::vector<char> body;
+        splitFrame(frame, header, body);
+        StrategyProtocol::Request request;
+        return StrategyProtocol::decodeRequest(header, body, request);
+    };
+
+    ASSERT_TRUE(decodes(Position::BTN, hole, 0));
+    ASSERT_TRUE(decodes(Position::BTN, hole, flop));
+    ASSERT_FALSE(decodes(Position::BTN, hole, cardBit(1)));                               // 1-card board
+    ASSERT_FALSE(decodes(Position::BTN, hole, cardBit(1) | cardBit(2)));                  // 2-card board
+    ASSERT_FALSE(decodes(Position::BTN, hole, flop | cardBit(4) | cardBit(5) | cardBit(6)));  // 6 cards
+    ASSERT_FALSE(decodes(Position::BTN, cardBit(10), flop));                              // 1 hole card
+    ASSERT_FALSE(decodes(Position::BTN, hole | cardBit(30), flop));                       // 3 hole cards
+    ASSERT_FALSE(decodes(Position::BTN, cardBit(10) | (CardMask(1) << 52), flop));        // Past the deck
+    ASSERT_FALSE(decodes(Position::BTN, hole, cardBit(1) | cardBit(2) | (CardMask(1) << 63)));
+    ASSERT_FALSE(decodes(Position::BTN, cardBit(1) | cardBit(20), flop));                 // Overlaps the board
+    ASSERT_FALSE(decodes(static_cast<Position>(NUM_PLAYERS), hole, flop));
+
+    // Truncated body and a count that does not match it
+    StrategyQueryEngine::Decision decision{Position::BTN, hole, flop, &history, &action, 1};
+    std::vector<char> frame;
+    StrategyProtocol::encodeRequest(1, &decision, 1, frame);
+    StrategyProtocol::FrameHeader header;
+    std::vector<char> body;
+    splitFrame(frame, header, body);
+    StrategyProtocol::Request request;
+    std::vector<char> truncated(body.begin(), body.end() - 8);
+    ASSERT_FALSE(StrategyProtocol::decodeRequest(header, truncated, request));
+    header.numDecisions = 2;
+    ASSERT_FALSE(StrategyProtocol::decodeRequest(header, body, request));
+}
+
+// PUBLIC_TREE root values are zero-sum, and its tables hold the same keys as
+// VANILLA training and play-time lookups build
+TEST(test_public_tree_training) {
+    const uint64_t seed = 13;
+    const int iterations = 3;
+    auto solver = makeSolver();
+    solver->setSeed(seed);
+    for (int i = 0; i < iterations; ++i) {
+        solver->train(1, CFRSolver::TraversalMode::PUBLIC_TREE);
+        double total = 0.0;
+        double scale = 0.0;
+        for (double value : solver->getPublicTreeRootValues()) {
+            total += value;
+            scale += std::abs(value);
+        }
+        ASSERT_TRUE(scale > 0.0);
+        ASSERT_TRUE(std::abs(total) <= 1e-9 * scale);
+    }
+    ASSERT_TRUE(solver->getRegretTable().size() > 0);
+    ASSERT_TRUE(solver->getStrategyTable().size() > 0);
+
+    // Every combo is played on each iteration's board, so the dealt hands'
+    // keys are in both tables: preflop on every board, and on the flop for
+    // the first iteration (uniform strategies reach every node)
+    DealPipeline deals(HandAbstraction::create(HandAbstraction::Level::STANDARD), seed, 0, iterations, 0);
+    DealPipeline::PreparedDeal prepared;
+    for (int i = 0; i < iterations; ++i) {
+        deals.next(prepared);
+        for (int passive = 0; passive < (i == 0 ? 6 : 3); ++passive) {
+            GameState state = passiveSpot(prepared.deal, passive);
+            ASSERT_FALSE(state.isTerminal());
+            std::string key = solver->getAbstractedInfoSet(state, state.getCurrentPosition());
+            ASSERT_TRUE(solver->getRegretTable().hasInfoSet(key));
+            ASSERT_TRUE(solver->getStrategyTable().hasInfoSet(key));
+        }
+    }
+}
+
+// Re-solves are normalized, respect the node cap and repeat exactly for a
+// seed; a zero budget cuts setup short but still answers
+TEST(test_subgame_solver) {
+    StrategyTable blueprint;        // Empty: the blueprint plays uniformly
+    auto handAbstraction = HandAbstraction::create(HandAbstraction::Level::STANDARD);
+    auto bets = BetAbstraction::create(BetAbstraction::Level::STANDARD);
+    GameState flop = passiveSpot(21, 3);
+    ASSERT_TRUE(flop.getBettingRound() == BettingRound::FLOP);
+
+    SubgameSolver::Options options;
+    options.timeBudgetMs = 60000.0;     // The iteration cap ends the solve
+    options.maxIterations = 200;
+    options.numDeals = 32;
+    options.rolloutsPerLeaf = 1;
+    options.maxNodes = 40;
+    options.seed = 3;
+    SubgameSolver solver(blueprint, handAbstraction, bets, bets, options);
+    SubgameSolver::Result first = solver.solve(flop);
+
+    ASSERT_EQ(first.iterations, 200);
+    ASSERT_EQ(first.deals, 32);
+    ASSERT_FALSE(first.actions.empty());
+    ASSERT_EQ(first.probabilities.size(), first.actions.size());
+    double total = 0.0;
+    for (double probability : first.probabilities) {
+        ASSERT_TRUE(probability >= 0.0);
+        total += probability;
+    }
+    ASSERT_TRUE(std::abs(total - 1.0) < 1e-9);
+
+    // Turn decisions are blueprint leaves, and the cap prunes the flop tree
+    ASSERT_TRUE(first.leaves > 0);
+    ASSERT_TRUE(first.nodes > first.leaves);
+    SubgameSolver::Options uncapped = options;
+    uncapped.maxIterations = 1;
+    uncapped.maxNodes = 20000;
+    SubgameSolver::Result full = SubgameSolver(blueprint, handAbstraction, bets, bets, uncapped).solve(flop);
+    ASSERT_TRUE(first.nodes < full.nodes);
+
+    SubgameSolver::Result second = solver.solve(flop);
+    ASSERT_EQ(second.nodes, first.nodes);
+    ASSERT_EQ(second.leaves, first.leaves);
+    ASSERT_TRUE(second.actions == first.actions);
+    ASSERT_TRUE(second.probabilities == first.probabilities);
+
+    options.timeBudgetMs = 0.0;
+    SubgameSolver rushed(blueprint, handAbstraction, bets, bets, options);
+    SubgameSolver::Result quick = rushed.solve(flop);
+    ASSERT_EQ(quick.iterations, 1);
+    ASSERT_EQ(quick.deals, SubgameSolver::MIN_DEALS);
+    ASSERT_EQ(quick.nodes, 1 + quick.actions.size());      // Root and its children
+}
+
+int main() {
+    // Corruption test logs expected errors
+    Logger::getInstance().init(Logger::Level::FATAL);
+
+    std::cout << "Running cfr tests...\n";
+
+    RUN_TEST(test_checkpoint_roundtrip);
+    RUN_TEST(test_checkpoint_snapshot);
+    RUN_TEST(test_checkpoint_corruption);
+    RUN_TEST(test_checkpoint_resume);
+    RUN_TEST(test_mapped_strategy);
+    RUN_TEST(test_query_engine_keys);
+    RUN_TEST(test_protocol_roundtrip);
+    RUN_TEST(test_protocol_malformed);
+    RUN_TEST(test_public_tree_training);
+    RUN_TEST(test_subgame_solver);
+    RUN_TEST(test_deal_pipeline);
+
+    std::cout << "All tests passed!\n";
+    return 0;
+}
\ No newline at end of file
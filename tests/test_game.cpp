@@ -2,10 +2,16 @@
 #include <cassert>
 #include <vector>
 #include <string>
+#include <cmath>
+#include <algorithm>
 
 #include "game/GameState.hpp"
 #include "game/Action.hpp"
 #include "game/PokerDefs.hpp"
+#include "game/Deck.hpp"
+#include "game/PreflopEquity.hpp"
+#include "game/Showdown.hpp"
+#include "game/RangeShowdown.hpp"
 
 using namespace poker;
 
@@ -167,6 +173,176 @@ TEST(test_game_state) {
     ASSERT_EQ(stateClone->getCommunityCards().size(), 3);
 }
 
+// Payoffs charge the chips put in on every street, so a pot won on the
+// flop is zero-sum
+TEST(test_payoffs) {
+    GameState state;
+    state.dealHoleCards();
+    state.applyAction(Action::call(BIG_BLIND - SMALL_BLIND));  // SB
+    state.applyAction(Action::check());                        // BB
+    state.applyAction(Action::call(BIG_BLIND));                // BTN
+    state.startNextBettingRound();
+    state.applyAction(Action::fold());                         // SB
+    state.applyAction(Action::fold());                         // BB
+    ASSERT_TRUE(state.isTerminal());
+    
+    auto payoffs = state.getPayoffs();
+    ASSERT_EQ(payoffs[Position::SB], -BIG_BLIND);
+    ASSERT_EQ(payoffs[Position::BB], -BIG_BLIND);
+    ASSERT_EQ(payoffs[Position::BTN], 2 * BIG_BLIND);
+}
+
+// Tests for the bitmask Deck
+TEST(test_deck) {
+    Xoshiro256 rng(1234);
+    Deck deck;
+    DealOutcome outcome = deck.drawOutcome(rng);
+    
+    // Hole cards and board are 11 distinct cards removed from the deck
+    CardMask dealt = outcome.boardMask(BOARD_SIZE);
+    for (Position pos : {Position::SB, Position::BB, Position::BTN}) {
+        ASSERT_EQ(dealt & outcome.holeMask(pos), 0u);
+        dealt |= outcome.holeMask(pos);
+    }
+    ASSERT_EQ(__builtin_popcountll(dealt), 11);
+    ASSERT_EQ(deck.size(), DECK_SIZE - 11);
+    ASSERT_EQ(deck.remaining() & dealt, 0u);
+    
+    // Same stream, same deal
+    Xoshiro256 replay(1234);
+    Deck replayDeck;
+    ASSERT_TRUE(replayDeck.drawOutcome(replay) == outcome);
+    
+    // Dead cards are never drawn
+    Deck partial(dealt);
+    uint8_t cards[4];
+    partial.draw(cards, 4, rng);
+    for (uint8_t card : cards) {
+        ASSERT_EQ(dealt & cardBit(card), 0u);
+    }
+}
+
+// Tests for preflop matchup canonicalization
+TEST(test_preflop_canonical) {
+    // Suit index * 13 + rank index (rank 12 = ace)
+    auto card = [](int suit, int rank) { return cardBit(static_cast<uint8_t>(suit * 13 + rank)); };
+    CardMask aceKingSuited = card(3, 12) | card(3, 11);
+    CardMask deuces = card(0, 0) | card(1, 0);
+    int slots[PreflopEquityTable::MAX_HANDS];
+    int relabeledSlots[PreflopEquityTable::MAX_HANDS];
+    
+    // Relabeled suits and swapped seats give the same class
+    CardMask hands[] = {aceKingSuited, deuces};
+    CardMask relabeled[] = {card(2, 0) | card(3, 0), card(1, 12) | card(1, 11)};
+    uint64_t key = PreflopEquityTable::canonicalKey(hands, 2, slots);
+    ASSERT_EQ(PreflopEquityTable::canonicalKey(relabeled, 2, relabeledSlots), key);
+    ASSERT_NE(slots[0], slots[1]);
+    ASSERT_EQ(slots[0], relabeledSlots[1]);
+    ASSERT_EQ(slots[1], relabeledSlots[0]);
+    
+    // Which suit the deuces share with the ace-king matters
+    CardMask sharing[] = {aceKingSuited, card(3, 0) | card(1, 0)};
+    ASSERT_NE(PreflopEquityTable::canonicalKey(sharing, 2, slots), key);
+    
+    // The key decodes to hands of the same class
+    CardMask decoded[PreflopEquityTable::MAX_HANDS];
+    ASSERT_EQ(PreflopEquityTable::handsOfKey(key, decoded), 2);
+    ASSERT_EQ(PreflopEquityTable::canonicalKey(decoded, 2, slots), key);
+    ASSERT_EQ(slots[0], 0);
+    ASSERT_EQ(slots[1], 1);
+    
+    // Of the deuce pairings, {0,39} with {13,26} has the smallest packed key;
+    // hand index = high * (high - 1) / 2 + low
+    CardMask pairings[] = {cardBit(13) | cardBit(26), cardBit(0) | cardBit(39)};
+    const uint32_t indices[] = {39 * 38 / 2 + 0, 26 * 25 / 2 + 13};
+    ASSERT_EQ(PreflopEquityTable::canonicalKey(pairings, 2, slots), PreflopEquityTable::packKey(indices, 2));
+    
+    // 3-way keys are invariant under seat order too
+    CardMask threeWay[] = {aceKingSuited, deuces, card(2, 8) | card(2, 7)};
+    CardMask reordered[] = {threeWay[2], threeWay[0], threeWay[1]};
+    ASSERT_EQ(PreflopEquityTable::canonicalKey(threeWay, 3, slots),
+              PreflopEquityTable::canonicalKey(reordered, 3, relabeledSlots));
+    ASSERT_EQ(slots[0], relabeledSlots[1]);
+    ASSERT_EQ(slots[2], relabeledSlots[0]);
+}
+
+// Tests for all-in runout enumeration
+TEST(test_showdown) {
+    auto card = [](int suit, int rank) { return cardBit(static_cast<uint8_t>(suit * 13 + rank)); };
+    double equities[Showdown::MAX_HANDS];
+    
+    // Complete board: aces full beat seven-deuce
+    CardMask aces = card(3, 12) | card(2, 12);
+    CardMask sevenDeuce = card(0, 5) | card(1, 0);
+    CardMask river = card(1, 12) | card(0, 11) | card(0, 10) | card(1, 10) | card(2, 9);
+    CardMask headsUp[] = {aces, sevenDeuce};
+    Showdown::enumerateEquities(headsUp, 2, river, equities);
+    ASSERT_EQ(equities[0], 1.0);
+    ASSERT_EQ(equities[1], 0.0);
+    
+    // Same ranks in other suits with no flush possible always split
+    CardMask flop = card(0, 0) | card(1, 1) | card(0, 2);
+    CardMask mirrored[] = {card(3, 12) | card(3, 11), card(2, 12) | card(2, 11)};
+    Showdown::enumerateEquities(mirrored, 2, flop, equities);
+    ASSERT_EQ(equities[0], 0.5);
+    ASSERT_EQ(equities[1], 0.5);
+    
+    // Shares add up to the pot, cached or not
+    CardMask threeWay[] = {aces, sevenDeuce, card(3, 8) | card(3, 7)};
+    double cached[Showdown::MAX_HANDS];
+    Showdown::enumerateEquities(threeWay, 3, flop, equities);
+    Showdown::cachedEquities(threeWay, 3, flop, cached);
+    ASSERT_TRUE(std::abs(equities[0] + equities[1] + equities[2] - 1.0) < 1e-9);
+    for (int h = 0; h < 3; ++h) {
+        ASSERT_EQ(cached[h], equities[h]);
+    }
+}
+
+// Tests for range-vs-range showdowns with card removal
+TEST(test_range_showdown) {
+    RangeShowdown showdown;
+    showdown.setBoard(cardBit(1) | cardBit(7) | cardBit(20) | cardBit(33) | cardBit(45));
+    const size_t numHands = showdown.size();
+    const auto& hands = showdown.hands();
+    const auto& strengths = showdown.strengths();
+    ASSERT_EQ(numHands, 1081u);
+    
+    Xoshiro256 rng(99);
+    std::vector<double> reach1(numHands), reach2(numHands);
+    for (size_t i = 0; i < numHands; ++i) {
+        reach1[i] = rng.nextDouble();
+        reach2[i] = rng.nextDouble();
+    }
+    const double* opponents[] = {reach1.data(), reach2.data()};
+    std::vector<double> shares(numHands), masses(numHands);
+    
+    // Compare with pairing every opponent holding, both contending or one folded
+    for (bool secondContends : {true, false}) {
+        bool contending[] = {true, secondContends};
+        showdown.evaluate(opponents, contending, shares.data(), masses.data());
+        for (size_t i = 0; i < numHands; i += 271) {
+            double share = 0.0;
+            double mass = 0.0;
+            for (size_t a = 0; a < numHands; ++a) {
+                if (hands[a] & hands[i]) continue;
+                for (size_t b = 0; b < numHands; ++b) {
+                    if ((hands[b] & hands[i]) || (hands[b] & hands[a])) continue;
+                    double weight = reach1[a] * reach2[b];
+                    int best = std::max(strengths[i], strengths[a]);
+                    if (secondContends) best = std::max(best, strengths[b]);
+                    mass += weight;
+                    if (strengths[i] == best) {
+                        int tied = 1 + (strengths[a] == best) + (secondContends && strengths[b] == best);
+                        share += weight / tied;
+                    }
+                }
+            }
+            ASSERT_TRUE(std::abs(masses[i] - mass) < 1e-9 * mass);
+            ASSERT_TRUE(std::abs(shares[i] - share) < 1e-9 * mass);
+        }
+    }
+}
+
 int main() {
     std::cout << "Running game tests...\n";
     
@@ -176,6 +352,11 @@ int main() {
     RUN_TEST(test_action);
     RUN_TEST(test_action_history);
     RUN_TEST(test_game_state);
+    RUN_TEST(test_payoffs);
+    RUN_TEST(test_deck);
+    RUN_TEST(test_preflop_canonical);
+    RUN_TEST(test_showdown);
+    RUN_TEST(test_range_showdown);
     
     std::cout << "All tests passed!\n";
     return 0;
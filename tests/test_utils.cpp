@@ -0,0 +1,410 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "utils/Logger.hpp"
+#include "utils/Xoshiro.hpp"
+#include "utils/ActionSampler.hpp"
+#include "utils/RingBuffer.hpp"
+#include "utils/RcuPointer.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/Trace.hpp"
+#include "cfr/TableMemory.hpp"
+
+using namespace poker;
+
+// Simple testing framework
+#define TEST(name) void name()
+#define ASSERT(condition) assert(condition)
+#define ASSERT_EQ(a, b) assert((a) == (b))
+#define ASSERT_NE(a, b) assert((a) != (b))
+#define ASSERT_TRUE(a) assert(a)
+#define ASSERT_FALSE(a) assert(!(a))
+#define RUN_TEST(name) std::cout << "Running " << #name << "... "; name(); std::cout << "PASSED" << std::endl
+
+// Tests for the per-stream generator
+TEST(test_xoshiro_streams) {
+    Xoshiro256 a = Xoshiro256::forStream(42, 7, 0);
+    Xoshiro256 b = Xoshiro256::forStream(42, 7, 0);
+    Xoshiro256 c = Xoshiro256::forStream(42, 8, 0);
+
+    // Same (seed, iteration, thread) replays exactly
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(a(), b());
+    }
+
+    // Different iterations get different streams
+    ASSERT_NE(a(), c());
+
+    // Bounded draws stay in range
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(a.nextBounded(3) < 3u);
+        double u = a.nextDouble();
+        ASSERT_TRUE(u >= 0.0 && u < 1.0);
+    }
+}
+
+// Tests for index sampling
+TEST(test_sample_index) {
+    const double weights[] = {0.0, 0.25, 0.0, 0.75};
+
+    ASSERT_EQ(sampleIndex(weights, 4, 0.0), 1u);
+    ASSERT_EQ(sampleIndex(weights, 4, 0.2), 1u);
+    ASSERT_EQ(sampleIndex(weights, 4, 0.3), 3u);
+    ASSERT_EQ(sampleIndex(weights, 4, 0.999999), 3u);
+
+    // Unnormalized weights with their total
+    const double counts[] = {1.0, 3.0};
+    ASSERT_EQ(sampleIndex(counts, 2, 0.2, 4.0), 0u);
+    ASSERT_EQ(sampleIndex(counts, 2, 0.3, 4.0), 1u);
+
+    // All-zero weights fall back to uniform
+    const double zeros[] = {0.0, 0.0};
+    ASSERT_EQ(sampleIndex(zeros, 2, 0.75, 0.0), 1u);
+}
+
+// Tests for the alias table
+TEST(test_alias_table) {
+    const double weights[] = {0.1, 0.0, 0.6, 0.3};
+    AliasTable table(weights, 4);
+    ASSERT_EQ(table.size(), 4u);
+
+    Xoshiro256 rng(99);
+    std::vector<int> counts(4, 0);
+    const int samples = 100000;
+    for (int i = 0; i < samples; ++i) {
+        counts[table.sample(rng)]++;
+    }
+
+    ASSERT_EQ(counts[1], 0);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(std::abs(counts[i] / double(samples) - weights[i]) < 0.01);
+    }
+}
+
+// Disabled logging statements never build their message
+TEST(test_lazy_logging) {
+    const std::string file = "test_utils_lazy.log";
+    std::remove(file.c_str());
+    Logger& logger = Logger::getInstance();
+    logger.init(Logger::Level::INFO, Logger::Destination::FILE, file);
+
+    int evaluations = 0;
+    auto message = [&evaluations] {
+        ++evaluations;
+        return std::string("lazy message");
+    };
+    LOG_DEBUG(message());
+    DEBUG_LOG << message();
+    ASSERT_FALSE(LOG_DEBUG_ENABLED());
+    ASSERT_EQ(evaluations, 0);
+
+    LOG_INFO(message());
+    ASSERT_EQ(evaluations, POKER_LOG_COMPILED_LEVEL <= 1 ? 1 : 0);
+
+    logger.init(Logger::Level::INFO, Logger::Destination::CONSOLE);
+    std::remove(file.c_str());
+}
+
+// A full async queue drops INFO messages and counts every one of them
+TEST(test_async_logging_drops) {
+    const std::string file = "test_utils_async.log";
+    std::remove(file.c_str());
+    Logger& logger = Logger::getInstance();
+    logger.init(Logger::Level::INFO, Logger::Destination::FILE, file);
+    const uint64_t droppedBefore = logger.getDroppedCount();
+
+    // A four-slot queue cannot keep up with a tight loop
+    const int messages = 20000;
+    logger.startAsync(4, std::chrono::milliseconds(1000));
+    ASSERT_TRUE(logger.isAsync());
+    for (int i = 0; i < messages; ++i) {
+        LOG_INFO("queued " + std::to_string(i));
+    }
+    logger.stopAsync();
+    ASSERT_FALSE(logger.isAsync());
+    const uint64_t dropped = logger.getDroppedCount() - droppedBefore;
+    ASSERT_TRUE(dropped > 0);
+
+    // Every message is either written or counted, and the writer reports
+    // the drops in the log itself
+    std::ifstream in(file);
+    std::string line;
+    uint64_t written = 0;
+    uint64_t reported = 0;
+    while (std::getline(in, line)) {
+        if (line.find("[INFO] queued ") != std::string::npos) {
+            ++written;
+        }
+        size_t at = line.find("[WARNING] Logger dropped ");
+        if (at != std::string::npos) {
+            reported += std::stoull(line.substr(at + 25));
+        }
+    }
+    ASSERT_EQ(written + dropped, static_cast<uint64_t>(messages));
+    ASSERT_EQ(reported, dropped);
+
+    logger.init(Logger::Level::INFO, Logger::Destination::CONSOLE);
+    std::remove(file.c_str());
+}
+
+// Tests for the ring buffer
+TEST(test_ring_buffer) {
+    MpscRingBuffer<std::string> buffer(3);
+    ASSERT_EQ(buffer.capacity(), 4u);  // Rounded up to a power of two
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(buffer.tryPush(std::to_string(i)));
+    }
+    ASSERT_FALSE(buffer.tryPush("full"));
+
+    std::string value;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(buffer.tryPop(value));
+        ASSERT_EQ(value, std::to_string(i));
+    }
+    ASSERT_FALSE(buffer.tryPop(value));
+}
+
+// Tests for RCU publication and reclamation
+TEST(test_rcu_pointer) {
+    struct Version {
+        Version(int id, std::atomic<int>* destroyed) : id(id), destroyed(destroyed) {}
+        ~Version() { destroyed->fetch_add(1); }
+        int id;
+        std::atomic<int>* destroyed;
+    };
+    std::atomic<int> destroyed{0};
+    RcuPointer<const Version> pointer(std::make_shared<Version>(0, &destroyed));
+    
+    // A pinned reader keeps seeing its version after a swap, and exchange
+    // waits for it before handing the old version back
+    {
+        std::atomic<bool> pinned{false};
+        std::atomic<bool> swapped{false};
+        std::thread reader([&] {
+            auto guard = pointer.read();
+            pinned.store(true);
+            while (!swapped.load()) {
+                std::this_thread::yield();
+            }
+            ASSERT_EQ(guard->id, 0);
+        });
+        while (!pinned.load()) {
+            std::this_thread::yield();
+        }
+        std::thread writer([&] {
+            auto previous = pointer.exchange(std::make_shared<Version>(1, &destroyed));
+            ASSERT_EQ(previous->id, 0);
+        });
+        // Version 1 is published, but the writer cannot finish while the
+        // reader holds version 0
+        while (pointer.generation() == 0) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ASSERT_EQ(destroyed.load(), 0);
+        ASSERT_EQ(pointer.read()->id, 1);
+        swapped.store(true);
+        reader.join();
+        writer.join();
+    }
+    ASSERT_EQ(destroyed.load(), 1);
+    ASSERT_EQ(pointer.generation(), 1u);
+    
+    // Readers never see a destroyed version while versions churn
+    std::atomic<bool> stop{false};
+    std::atomic<bool> sawDestroyed{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                // Versions die in id order, so a live one has id >= the count
+                auto guard = pointer.read();
+                if (guard->id < destroyed.load()) {
+                    sawDestroyed.store(true);
+                }
+            }
+        });
+    }
+    for (int i = 2; i <= 101; ++i) {
+        pointer.exchange(std::make_shared<Version>(i, &destroyed));
+    }
+    stop.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    ASSERT_FALSE(sawDestroyed.load());
+    ASSERT_EQ(destroyed.load(), 101);
+    ASSERT_EQ(pointer.load()->id, 101);
+}
+
+// Tests for latency histogram binning
+TEST(test_latency_histogram) {
+    const uint64_t values[] = {0, 7, 8, 15, 16, 1000, 123456789, ~0ULL};
+    for (uint64_t value : values) {
+        int bin = LatencyHistogram::binIndex(value);
+        ASSERT_TRUE(bin >= 0 && bin < LatencyHistogram::NUM_BINS);
+        ASSERT_TRUE(LatencyHistogram::binLowerBound(bin) <= value);
+        if (bin + 1 < LatencyHistogram::NUM_BINS) {
+            ASSERT_TRUE(LatencyHistogram::binLowerBound(bin + 1) > value);
+        }
+    }
+    
+    // Bins are monotonic
+    ASSERT_TRUE(LatencyHistogram::binIndex(999) <= LatencyHistogram::binIndex(1000));
+    ASSERT_EQ(LatencyHistogram::binIndex(~0ULL), LatencyHistogram::NUM_BINS - 1);
+}
+
+// Exited threads keep their counts and hand their block to the next thread
+TEST(test_metrics_thread_blocks) {
+    Metrics& metrics = Metrics::getInstance();
+    metrics.reset();
+    Metrics::increment(Counter::EVICTIONS, 3);
+    size_t blocks = 0;
+    
+    for (int t = 0; t < 50; ++t) {
+        std::thread([] {
+            Metrics::increment(Counter::EVICTIONS);
+            Metrics::recordIterationLatency(1000);
+        }).join();
+        if (t == 0) {
+            blocks = metrics.getBlockCount();
+        }
+    }
+    ASSERT_EQ(metrics.getBlockCount(), blocks);
+    
+    MetricsSnapshot snapshot = metrics.snapshot();
+    ASSERT_EQ(snapshot.get(Counter::EVICTIONS), 53u);
+    ASSERT_EQ(snapshot.iterationsRecorded, 50u);
+    ASSERT_TRUE(std::abs(snapshot.iterationMaxUs - 1.0) < 1e-9);
+    
+    metrics.reset();
+    ASSERT_EQ(metrics.snapshot().get(Counter::EVICTIONS), 0u);
+}
+
+// Buffers of exited threads are kept until written, then reused
+TEST(test_trace_thread_buffers) {
+    const std::string file = "test_utils_trace.json";
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start(4096);
+    auto spanThread = [] {
+        std::thread([] {
+            TRACE_SCOPE("short_lived");
+        }).join();
+    };
+    
+    for (int t = 0; t < 20; ++t) {
+        spanThread();
+    }
+    size_t buffers = tracer.getBufferCount();
+    ASSERT_EQ(tracer.getEventCount(), 20u);
+    ASSERT_TRUE(tracer.writeChromeTrace(file));
+    
+    std::ifstream input(file);
+    std::stringstream json;
+    json << input.rdbuf();
+    size_t spans = 0;
+    for (size_t pos = 0; (pos = json.str().find("short_lived", pos)) != std::string::npos; ++pos) {
+        ++spans;
+    }
+    ASSERT_EQ(spans, 20u);
+    
+    // Written spans are gone and later threads reuse the buffers
+    ASSERT_EQ(tracer.getEventCount(), 0u);
+    for (int t = 0; t < 20; ++t) {
+        tracer.writeChromeTrace(file);
+        spanThread();
+    }
+    ASSERT_TRUE(tracer.getBufferCount() <= buffers);
+    tracer.stop();
+    std::remove(file.c_str());
+}
+
+// Thread and span names are escaped in the JSON output
+TEST(test_trace_json_escaping) {
+    const std::string file = "test_utils_trace_names.json";
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start(64);
+    std::thread([] {
+        Tracer::getInstance().setThreadName("worker \"7\" C:\\tmp\tx");
+        TRACE_SCOPE("span \"quoted\"");
+    }).join();
+    ASSERT_TRUE(tracer.writeChromeTrace(file));
+    tracer.stop();
+
+    std::ifstream input(file);
+    std::stringstream json;
+    json << input.rdbuf();
+    ASSERT_TRUE(json.str().find("\"worker \\\"7\\\" C:\\\\tmp\\tx\"") != std::string::npos);
+    ASSERT_TRUE(json.str().find("\"span \\\"quoted\\\"\"") != std::string::npos);
+    ASSERT_TRUE(json.str().find('\t') == std::string::npos);
+    std::remove(file.c_str());
+}
+
+// Tests for CLOCK eviction
+TEST(test_clock_eviction) {
+    struct Entry {
+        int value = 0;
+        EntryMetadata meta;
+    };
+    using Table = std::unordered_map<std::string, Entry>;
+    auto entryBytes = [](const std::string& key, const Entry&) {
+        return TableMemory::entryNodeBytes<Table>(key);
+    };
+    
+    Table table;
+    for (int i = 0; i < 1000; ++i) {
+        table["info_set_key_" + std::to_string(i)];
+    }
+    
+    // New entries start referenced, so the first sweep only clears their bits
+    size_t hand = 0;
+    size_t evicted = 0;
+    ASSERT_EQ(TableMemory::clockEvict(table, hand, ~size_t(0), table.bucket_count(), entryBytes, evicted), 0u);
+    ASSERT_EQ(evicted, 0u);
+    
+    // A touched entry survives the next sweep
+    table["info_set_key_5"].meta.touch(1);
+    size_t freed = TableMemory::clockEvict(table, hand, ~size_t(0), table.bucket_count(), entryBytes, evicted);
+    ASSERT_EQ(evicted, 999u);
+    ASSERT_EQ(table.size(), 1u);
+    ASSERT_TRUE(table.count("info_set_key_5") == 1);
+    ASSERT_TRUE(freed >= 999 * sizeof(Table::value_type));
+    
+    // The byte target stops the sweep early
+    for (int i = 0; i < 100; ++i) {
+        table["info_set_key_" + std::to_string(i)].meta.referenced = false;
+    }
+    TableMemory::clockEvict(table, hand, 1, table.bucket_count(), entryBytes, evicted);
+    ASSERT_EQ(evicted, 1u);
+}
+
+int main() {
+    std::cout << "Running utils tests...\n";
+
+    RUN_TEST(test_xoshiro_streams);
+    RUN_TEST(test_sample_index);
+    RUN_TEST(test_alias_table);
+    RUN_TEST(test_lazy_logging);
+    RUN_TEST(test_async_logging_drops);
+    RUN_TEST(test_ring_buffer);
+    RUN_TEST(test_rcu_pointer);
+    RUN_TEST(test_latency_histogram);
+    RUN_TEST(test_metrics_thread_blocks);
+    RUN_TEST(test_trace_thread_buffers);
+    RUN_TEST(test_trace_json_escaping);
+    RUN_TEST(test_clock_eviction);
+
+    std::cout << "All tests passed!\n";
+    return 0;
+}
\ No newline at end of file